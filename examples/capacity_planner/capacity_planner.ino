@@ -0,0 +1,86 @@
+/**
+ * @file capacity_planner.ino
+ * @brief ノードを追加する前に、チャンネルの使用率・LBT失敗率・衝突率を見積もるサンプル
+ * @copyright Copyright (c) 2026 CircuitDesign,Inc.
+ * This software is released under the MIT License.
+ * http://opensource.org/licenses/mit-license.php
+ *
+ * @details
+ * MLR_CapacityPlannerに通信モデル(ノード数、メッセージ長、送信間隔、拡散率、チャンネル)を登録すると、
+ * ドライバの通信時間モデル(MLR_Airtime.h)を使って、ノードごとの通信時間と送信時間率(デューティ比)、
+ * チャンネルの負荷、LBT(キャリアセンス)で送信できない割合、衝突する割合、届く割合を計算します。
+ * Simulate() で同じ通信をモンテカルロシミュレーションし、計算結果を確認できます。
+ *
+ * このサンプルプログラムは、次の2つを表示します。
+ * 1. 3種類のノード(センサ、メータ、別チャンネルのアラーム)を持つネットワークの見積もりとシミュレーション結果
+ * 2. センサのノード数を増やしたときに、届く割合が TARGET_DELIVERY を下回るノード数
+ *
+ * 帯域幅(LORA_BW_HZ)と、キャリアセンスが送信を検出するまでの時間(CS_WINDOW_US)は、
+ * モデムのデータシートに合わせて変更してください。
+ */
+#include <MLR_Modem.h>
+#include <MLR_CapacityPlanner.h>
+
+// LoRaの帯域幅
+static const uint32_t LORA_BW_HZ = 125000;
+// キャリアセンスが送信を検出するまでの時間
+static const uint32_t CS_WINDOW_US = 5000;
+// お互いの電波が届かないノードの組の割合 [%]
+static const uint8_t HIDDEN_PERCENT = 5;
+// シミュレーション時間 [秒]
+static const uint32_t SIMULATE_S = 3600;
+// 目標とする届く割合
+static const float TARGET_DELIVERY = 0.95f;
+
+// センサ: 20バイトを60秒ごと, SF7
+static MLR_TrafficClass sensors = {40, 20, 60000, MLR_ModemSpreadFactor::Chips128, 0x0E};
+// メータ: 48バイトを5分ごと, SF9 (遠いノード)
+static const MLR_TrafficClass meters = {20, 48, 300000, MLR_ModemSpreadFactor::Chips512, 0x0E};
+// アラーム: 8バイトを10秒ごと, SF7, 別チャンネル
+static const MLR_TrafficClass alarms = {10, 8, 10000, MLR_ModemSpreadFactor::Chips128, 0x10};
+
+MLR_CapacityPlanner planner;
+
+void setup()
+{
+    Serial.begin(115200);
+    while (!Serial)
+        ;
+
+    // 1. ネットワーク全体の見積もり
+    planner.begin(LORA_BW_HZ);
+    planner.SetCarrierSense(CS_WINDOW_US, HIDDEN_PERCENT);
+    planner.AddClass(sensors);
+    planner.AddClass(meters);
+    planner.AddClass(alarms);
+    Serial.println("--- 見積もり (estimate) とシミュレーション (simulation) ---");
+    planner.PrintReport(Serial, SIMULATE_S);
+
+    // 2. センサを何台まで追加できるか
+    Serial.println("--- センサのノード数と届く割合 ---");
+    Serial.println("nodes  load   estimate  simulation");
+    for (uint16_t nodes = 10; nodes <= 190; nodes += 20)
+    {
+        sensors.nodes = nodes;
+        planner.begin(LORA_BW_HZ);
+        planner.SetCarrierSense(CS_WINDOW_US, HIDDEN_PERCENT);
+        planner.AddClass(sensors);
+        planner.AddClass(meters);
+
+        MLR_ClassEstimate estimates[2];
+        MLR_ClassEstimate simulated[2];
+        planner.Estimate(estimates);
+        if (planner.Simulate(SIMULATE_S, simulated) != MLR_Modem_Error::Ok)
+        {
+            Serial.println("ノード数が MLR_PLANNER_MAX_NODES を超えています。");
+            break;
+        }
+        Serial.printf("%5u  %.3f  %6.2f %%  %8.2f %%%s\n", nodes, planner.GetChannelLoad(sensors.channel),
+                      estimates[0].deliveryRate * 100.0f, simulated[0].deliveryRate * 100.0f,
+                      (estimates[0].deliveryRate < TARGET_DELIVERY) ? "  <- 目標未満" : "");
+    }
+}
+
+void loop()
+{
+}
@@ -0,0 +1,185 @@
+/**
+ * @file command_latency_benchmark.ino
+ * @brief 設定API (SetXxx/GetXxx) のコマンド往復時間の内訳ベンチマーク
+ * @copyright Copyright (c) 2026 CircuitDesign,Inc.
+ * This software is released under the MIT License.
+ * http://opensource.org/licenses/mit-license.php
+ *
+ * @details
+ * 起動時や設定変更時の待ち時間は、ほとんどがSetXxx()/GetXxx()関数のコマンド往復時間です。
+ * このサンプルプログラムは、エミュレータ(MLR_ModemEmulator)に対して各関数を REPEAT 回呼び出し、
+ * 1回あたりの平均時間を次の内訳に分けて表示します (単位 ms)。
+ *
+ * - encode : 関数の呼び出しから、コマンドの最初のバイトを書き込むまで (コマンド文字列の生成)
+ * - tx     : コマンドがモデムに届くまで (シリアル送信時間、送信バッファが一杯の場合の待ち時間を含む)
+ * - modem  : モデムの応答時間 (/W の場合は不揮発メモリへの書き込み時間を含む)
+ * - rx     : 応答がアプリケーションのUARTに届くまで (シリアル受信時間)
+ * - parse  : 応答の到着から関数が戻るまで (ポーリング間隔、応答の解析)
+ *
+ * 最後に、一般的な起動シーケンス (begin、モード、拡散率、チャンネル、各ID) の合計時間を表示します。
+ * モデムの応答時間はエミュレータの推定値です。実機で測定した値を SetTiming() で設定してください。
+ */
+#include <MLR_Modem.h>
+#include <MLR_ModemEmulator.h>
+
+// 測定するボーレート
+static const uint32_t BAUD_RATE = MLR_DEFAULT_BAUDRATE;
+// 関数ごとの呼び出し回数
+static const uint8_t REPEAT = 10;
+
+MLR_ModemEmulator emulator;
+MLR_Modem modem;
+
+static uint8_t g_byte;
+static uint16_t g_word;
+static uint32_t g_dword;
+static int16_t g_rssi;
+static MLR_ModemMode g_mode;
+static MLR_ModemSpreadFactor g_sf;
+
+struct Call
+{
+    const char *name;
+    MLR_Modem_Error (*fn)();
+};
+
+static const Call CALLS[] = {
+    {"GetMode", [] { return modem.GetMode(&g_mode); }},
+    {"GetSpreadFactor", [] { return modem.GetSpreadFactor(&g_sf); }},
+    {"GetChannel", [] { return modem.GetChannel(&g_byte); }},
+    {"GetEquipmentID", [] { return modem.GetEquipmentID(&g_byte); }},
+    {"GetDestinationID", [] { return modem.GetDestinationID(&g_byte); }},
+    {"GetGroupID", [] { return modem.GetGroupID(&g_byte); }},
+    {"GetUserID", [] { return modem.GetUserID(&g_word); }},
+    {"GetCarrierSense..", [] { return modem.GetCarrierSenseRssiOutput(&g_byte); }},
+    {"GetBaudRate", [] { return modem.GetBaudRate(&g_byte); }},
+    {"GetSerialNumber", [] { return modem.GetSerialNumber(&g_dword); }},
+    {"GetRssiLastRx", [] { return modem.GetRssiLastRx(&g_rssi); }},
+    {"GetRssiCurrent..", [] { return modem.GetRssiCurrentChannel(&g_rssi); }},
+    {"SetMode", [] { return modem.SetMode(MLR_ModemMode::LoRaCmd, false); }},
+    {"SetMode /W", [] { return modem.SetMode(MLR_ModemMode::LoRaCmd, true); }},
+    {"SetSpreadFactor", [] { return modem.SetSpreadFactor(MLR_ModemSpreadFactor::Chips1024, false); }},
+    {"SetSpreadFactor /W", [] { return modem.SetSpreadFactor(MLR_ModemSpreadFactor::Chips1024, true); }},
+    {"SetChannel", [] { return modem.SetChannel(0x07, false); }},
+    {"SetChannel /W", [] { return modem.SetChannel(0x07, true); }},
+    {"SetEquipmentID", [] { return modem.SetEquipmentID(0x02, false); }},
+    {"SetEquipmentID /W", [] { return modem.SetEquipmentID(0x02, true); }},
+    {"SetDestinationID", [] { return modem.SetDestinationID(0x00, false); }},
+    {"SetDestinationID /W", [] { return modem.SetDestinationID(0x00, true); }},
+    {"SetGroupID", [] { return modem.SetGroupID(0x01, false); }},
+    {"SetGroupID /W", [] { return modem.SetGroupID(0x01, true); }},
+    {"SetCarrierSense..", [] { return modem.SetCarrierSenseRssiOutput(0x00, false); }},
+    {"SetCarrierSense.. /W", [] { return modem.SetCarrierSenseRssiOutput(0x00, true); }},
+    {"FactoryReset", [] { return modem.FactoryReset(); }},
+};
+
+// 内訳 (マイクロ秒の合計)
+struct Breakdown
+{
+    uint32_t encode;
+    uint32_t tx;
+    uint32_t modem;
+    uint32_t rx;
+    uint32_t parse;
+
+    uint32_t Total() const { return encode + tx + modem + rx + parse; }
+};
+
+// 関数を1回呼び出して内訳を加算
+static bool measure(MLR_Modem_Error (*fn)(), Breakdown *pSum)
+{
+    uint32_t start = micros();
+    MLR_Modem_Error err = fn();
+    uint32_t end = micros();
+    if (err != MLR_Modem_Error::Ok)
+    {
+        return false;
+    }
+
+    const MLR_EmulatorTiming &t = emulator.GetLastTiming();
+    pSum->encode += t.writeStartUs - start;
+    pSum->tx += t.arrivedUs - t.writeStartUs;
+    pSum->modem += t.responseStartUs - t.arrivedUs;
+    pSum->rx += t.responseEndUs - t.responseStartUs;
+    pSum->parse += end - t.responseEndUs;
+    return true;
+}
+
+static void printRow(const char *name, const Breakdown &b, uint8_t count)
+{
+    float n = count * 1000.0f;
+    Serial.printf("%-20s %7.2f %7.2f %7.2f %7.2f %7.2f %8.2f\n", name, b.encode / n, b.tx / n, b.modem / n,
+                  b.rx / n, b.parse / n, b.Total() / n);
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    while (!Serial)
+        ;
+
+    emulator.begin(BAUD_RATE);
+
+    // 起動シーケンス
+    uint32_t bootStart = micros();
+    MLR_Modem_Error err = modem.begin(emulator);
+    if (err == MLR_Modem_Error::Ok)
+    {
+        err = modem.SetMode(MLR_ModemMode::LoRaCmd, false);
+    }
+    if (err == MLR_Modem_Error::Ok)
+    {
+        err = modem.SetSpreadFactor(MLR_ModemSpreadFactor::Chips1024, false);
+    }
+    if (err == MLR_Modem_Error::Ok)
+    {
+        err = modem.SetChannel(0x07, false);
+    }
+    if (err == MLR_Modem_Error::Ok)
+    {
+        err = modem.SetGroupID(0x01, false);
+    }
+    if (err == MLR_Modem_Error::Ok)
+    {
+        err = modem.SetDestinationID(0x00, false);
+    }
+    if (err == MLR_Modem_Error::Ok)
+    {
+        err = modem.SetEquipmentID(0x02, false);
+    }
+    uint32_t bootUs = micros() - bootStart;
+    if (err != MLR_Modem_Error::Ok)
+    {
+        Serial.println("エミュレータに接続できませんでした。");
+        return;
+    }
+
+    Serial.printf("--- コマンド往復時間 (%u bps, %u 回の平均, 単位 ms) ---\n", (unsigned)BAUD_RATE, REPEAT);
+    Serial.println("関数                  encode      tx   modem      rx   parse    合計");
+
+    for (uint8_t i = 0; i < sizeof(CALLS) / sizeof(CALLS[0]); i++)
+    {
+        Breakdown sum = {};
+        uint8_t count = 0;
+        for (uint8_t n = 0; n < REPEAT; n++)
+        {
+            if (measure(CALLS[i].fn, &sum))
+            {
+                count++;
+            }
+        }
+
+        if (count == 0)
+        {
+            Serial.printf("%-20s 失敗\n", CALLS[i].name);
+            continue;
+        }
+        printRow(CALLS[i].name, sum, count);
+    }
+
+    Serial.printf("起動シーケンス (begin + 6コマンド): %.2f ms\n", bootUs / 1000.0f);
+}
+
+void loop()
+{
+}
@@ -0,0 +1,236 @@
+/**
+ * @file dr_flood_stress_test.ino
+ * @brief 受信データ(*DR)の連続受信中にコマンドを実行するストレステスト
+ * @copyright Copyright (c) 2026 CircuitDesign,Inc.
+ * This software is released under the MIT License.
+ * http://opensource.org/licenses/mit-license.php
+ *
+ * @details
+ * コマンドの応答を待っている間に *DR が届くと、ドライバは応答待ちの中で受信データを処理します。
+ * このサンプルプログラムは、エミュレータ(MLR_ModemEmulator)から PAYLOAD_LEN バイトのパケットを
+ * 途切れなく(シリアル回線の最大速度で)受信させながら、次の処理を CMD_INTERVAL_MS ごとに順番に実行します。
+ *
+ * - SetChannel() / GetChannel()      : 同期コマンド (設定した値が読み出せることを確認)
+ * - GetRssiCurrentChannelAsync()     : 非同期コマンド
+ * - GetSerialNumberAsync()           : 非同期コマンド (値を確認)
+ * - TransmitDataFireAndForget()      : 送信 (送信完了はコールバックで受け取る)
+ *
+ * 受信したパケットはシーケンス番号と内容を確認し、欠落・破損・順序の入れ替わりを数えます。
+ * 各ボーレートで DURATION_MS の間実行し、次の値を表示します。
+ * - 受信パケット/秒、同期コマンド/秒、非同期コマンドの完了/秒
+ * - 欠落・破損したパケット数、失敗したコマンド数、エミュレータのUART受信バッファのオーバーラン
+ *
+ * 非同期コマンドの完了を待っている間、コマンドは Busy を返します。Busy は失敗に数えず、完了後に再実行します。
+ * 欠落・破損・失敗がすべて0の場合に "OK" を表示します。
+ */
+#include <MLR_Modem.h>
+#include <MLR_ModemEmulator.h>
+
+// 受信パケットの長さ
+static const uint8_t PAYLOAD_LEN = 32;
+// 送信するペイロード長
+static const uint8_t TX_LEN = 16;
+// コマンドの実行間隔
+static const uint32_t CMD_INTERVAL_MS = 20;
+// ボーレートごとの測定時間
+static const uint32_t DURATION_MS = 3000;
+
+static const uint32_t BAUD_RATES[] = {9600, 19200, 38400, 57600, 115200};
+
+MLR_ModemEmulator emulator;
+MLR_Modem modem;
+
+static uint8_t txPayload[TX_LEN];
+
+// 受信の確認
+static uint32_t g_nextSeq;
+static uint32_t g_received;
+static uint32_t g_lost;
+static uint32_t g_corrupt;
+static uint32_t g_reordered;
+
+// コマンドの結果
+static uint32_t g_syncOk;
+static uint32_t g_syncFail;
+static uint32_t g_asyncIssued;
+static uint32_t g_asyncDone;
+static uint32_t g_asyncFail;
+
+void modemCallback(MLR_Modem_Error error, MLR_Modem_Response responseType, int32_t value, const uint8_t *pPayload, uint16_t len)
+{
+    switch (responseType)
+    {
+    case MLR_Modem_Response::DataReceived:
+    {
+        uint32_t seq;
+        if (len != PAYLOAD_LEN || !MLR_ModemEmulator::CheckFloodPacket(pPayload, len, &seq))
+        {
+            g_corrupt++;
+            break;
+        }
+        if (seq < g_nextSeq)
+        {
+            g_reordered++;
+            break;
+        }
+        g_lost += seq - g_nextSeq;
+        g_nextSeq = seq + 1;
+        g_received++;
+        break;
+    }
+
+    case MLR_Modem_Response::SerialNumber:
+        // エミュレータのシリアル番号は 00000001
+        (error == MLR_Modem_Error::Ok && value == 1) ? g_asyncDone++ : g_asyncFail++;
+        break;
+
+    case MLR_Modem_Response::RssiCurrentChannel:
+    case MLR_Modem_Response::MLR_Modem_DtIr:
+        (error == MLR_Modem_Error::Ok) ? g_asyncDone++ : g_asyncFail++;
+        break;
+
+    default:
+        break;
+    }
+}
+
+// 同期コマンドの結果を集計 (Busy は非同期コマンドの完了待ちのため、falseを返して後で再実行する)
+static bool countSync(MLR_Modem_Error err)
+{
+    if (err == MLR_Modem_Error::Busy)
+    {
+        return false;
+    }
+    (err == MLR_Modem_Error::Ok) ? g_syncOk++ : g_syncFail++;
+    return true;
+}
+
+// 非同期コマンドの結果を集計
+static bool countAsync(MLR_Modem_Error err)
+{
+    if (err == MLR_Modem_Error::Busy)
+    {
+        return false;
+    }
+    (err == MLR_Modem_Error::Ok) ? g_asyncIssued++ : g_asyncFail++;
+    return true;
+}
+
+// 最後に設定したチャンネル
+static uint8_t g_channel;
+
+// 次のコマンドを実行 (Busy の場合は false)
+static bool runCommand(uint8_t step)
+{
+    switch (step % 5)
+    {
+    case 0:
+    {
+        uint8_t channel = (g_channel < 0x0F) ? g_channel + 1 : 0x07;
+        MLR_Modem_Error err = modem.SetChannel(channel, false);
+        if (err == MLR_Modem_Error::Ok)
+        {
+            g_channel = channel;
+        }
+        return countSync(err);
+    }
+
+    case 1:
+    {
+        uint8_t value = 0;
+        MLR_Modem_Error err = modem.GetChannel(&value);
+        if (err == MLR_Modem_Error::Ok && value != g_channel)
+        {
+            err = MLR_Modem_Error::Fail; // 別の応答を受け取った
+        }
+        return countSync(err);
+    }
+
+    case 2:
+        return countAsync(modem.GetRssiCurrentChannelAsync());
+
+    case 3:
+        return countAsync(modem.GetSerialNumberAsync());
+
+    default:
+        return countAsync(modem.TransmitDataFireAndForget(txPayload, TX_LEN));
+    }
+}
+
+static void runTest(uint32_t baud)
+{
+    emulator.begin(baud);
+    if (modem.begin(emulator, modemCallback) != MLR_Modem_Error::Ok)
+    {
+        Serial.println("エミュレータに接続できませんでした。");
+        return;
+    }
+
+    // 送信完了を待つ間は同期コマンドが Busy になるため、通信時間の短い拡散率を使用する
+    if (modem.SetSpreadFactor(MLR_ModemSpreadFactor::Chips128, false) != MLR_Modem_Error::Ok ||
+        modem.GetChannel(&g_channel) != MLR_Modem_Error::Ok)
+    {
+        Serial.println("初期設定に失敗しました。");
+        return;
+    }
+
+    g_nextSeq = g_received = g_lost = g_corrupt = g_reordered = 0;
+    g_syncOk = g_syncFail = 0;
+    g_asyncIssued = g_asyncDone = g_asyncFail = 0;
+
+    emulator.StartFlood(PAYLOAD_LEN);
+    uint32_t start = millis();
+    uint32_t nextCmd = start;
+    uint8_t step = 0;
+    while (millis() - start < DURATION_MS)
+    {
+        modem.Work();
+        if (static_cast<int32_t>(millis() - nextCmd) >= 0 && runCommand(step))
+        {
+            step++;
+            nextCmd = millis() + CMD_INTERVAL_MS;
+        }
+    }
+    uint32_t elapsed = millis() - start;
+
+    // 残りのデータと応答を受け取る
+    emulator.StopFlood();
+    uint32_t drainStart = millis();
+    while (millis() - drainStart < 500)
+    {
+        modem.Work();
+    }
+    g_lost += emulator.GetFloodCount() - g_nextSeq;
+
+    float seconds = elapsed / 1000.0f;
+    bool ok = g_lost == 0 && g_corrupt == 0 && g_reordered == 0 && g_syncFail == 0 && g_asyncFail == 0 &&
+              g_asyncDone == g_asyncIssued && emulator.GetOverrunCount() == 0;
+    Serial.printf("%6u  %7.1f  %6.1f  %7.1f  %4u  %7u  %7u  %9u  %7u  %s\n", (unsigned)baud, g_received / seconds,
+                  g_syncOk / seconds, g_asyncDone / seconds, (unsigned)g_lost, (unsigned)(g_corrupt + g_reordered),
+                  (unsigned)g_syncFail, (unsigned)(g_asyncFail + g_asyncIssued - g_asyncDone),
+                  (unsigned)emulator.GetOverrunCount(), ok ? "OK" : "NG");
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    while (!Serial)
+        ;
+
+    for (uint8_t i = 0; i < TX_LEN; i++)
+    {
+        txPayload[i] = i;
+    }
+
+    Serial.printf("--- *DR連続受信中のコマンド実行 (パケット %u バイト, %lu ms/測定) ---\n", PAYLOAD_LEN, (unsigned long)DURATION_MS);
+    Serial.println("  baud    pkt/s   cmd/s  async/s  lost  corrupt  cmdfail  asyncfail  overrun");
+    for (uint8_t b = 0; b < sizeof(BAUD_RATES) / sizeof(BAUD_RATES[0]); b++)
+    {
+        runTest(BAUD_RATES[b]);
+    }
+    Serial.println("--- 完了 ---");
+}
+
+void loop()
+{
+}
@@ -0,0 +1,120 @@
+/**
+ * @file file_transfer_fec_benchmark.ino
+ * @brief ファイル転送の前方誤り訂正(FEC)のオーバーヘッドと符号化コストのベンチマーク
+ * @copyright Copyright (c) 2026 CircuitDesign,Inc.
+ * This software is released under the MIT License.
+ * http://opensource.org/licenses/mit-license.php
+ *
+ * @details
+ * MLR_FileSenderは、SetFecGroupSize()で指定した数のデータフラグメントごとに
+ * XORパリティフラグメントを1つ送信できます。受信側はグループ内で1つだけ失われた
+ * フラグメントを、再送を待たずにパリティから復元します。
+ *
+ * このサンプルプログラムは、モデムを使わずに次の値を表示します。
+ * 1. グループサイズごとのパリティ計算時間 (MLR_File_XorParity、246バイトのフラグメント)
+ * 2. グループサイズごとの送信量のオーバーヘッド
+ * 3. パケット損失率ごとの、FECで復元できず再送が必要になるフラグメントの割合
+ *    (損失が独立に発生すると仮定した計算値)
+ *
+ * 損失の多いリンクでは小さなグループ、損失の少ないリンクでは大きなグループが有利です。
+ */
+#include <MLR_Modem.h>
+#include <MLR_FileTransfer.h>
+
+static const uint8_t GROUP_SIZES[] = {2, 4, 8, 16};
+static const float LOSS_RATES[] = {0.01f, 0.05f, 0.10f, 0.20f};
+static const uint8_t BENCH_LOOPS = 50;
+
+static uint8_t fragments[16][MLR_FILE_MAX_FRAGMENT_LEN];
+static uint8_t parity[MLR_FILE_MAX_FRAGMENT_LEN];
+
+// 再送が必要になるフラグメントの割合:
+// フラグメントが失われ、かつ同じグループ(残りのデータとパリティ)でも1つ以上失われた場合
+static float residualLoss(float p, uint8_t groupSize)
+{
+    float othersOk = 1.0f;
+    for (uint8_t i = 0; i < groupSize; i++) // 残りのgroupSize - 1個のデータとパリティ
+    {
+        othersOk *= 1.0f - p;
+    }
+    return p * (1.0f - othersOk);
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    // シリアルポートが開くまで待機
+    while (!Serial)
+        ;
+
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        for (uint8_t j = 0; j < MLR_FILE_MAX_FRAGMENT_LEN; j++)
+        {
+            fragments[i][j] = random(256);
+        }
+    }
+
+    Serial.print("--- FEC ベンチマーク (フラグメント長 ");
+    Serial.print(MLR_FILE_MAX_FRAGMENT_LEN);
+    Serial.println(" バイト) ---");
+    Serial.println("グループ  オーバーヘッド  パリティ計算  再送率 (損失 1% / 5% / 10% / 20%)");
+
+    for (uint8_t g = 0; g < sizeof(GROUP_SIZES); g++)
+    {
+        uint8_t groupSize = GROUP_SIZES[g];
+
+        // パリティ計算時間 (送信側の符号化、受信側の復元も同じ計算量)
+        uint32_t t = micros();
+        for (uint8_t n = 0; n < BENCH_LOOPS; n++)
+        {
+            memset(parity, 0, sizeof(parity));
+            for (uint8_t i = 0; i < groupSize; i++)
+            {
+                MLR_File_XorParity(parity, fragments[i], MLR_FILE_MAX_FRAGMENT_LEN);
+            }
+        }
+        float encodeUs = (micros() - t) / (float)BENCH_LOOPS;
+
+        Serial.print(groupSize);
+        Serial.print("         ");
+        Serial.print(100.0f / groupSize, 1);
+        Serial.print(" %         ");
+        Serial.print(encodeUs, 1);
+        Serial.print(" us      ");
+        for (uint8_t l = 0; l < sizeof(LOSS_RATES) / sizeof(LOSS_RATES[0]); l++)
+        {
+            Serial.print(residualLoss(LOSS_RATES[l], groupSize) * 100.0f, 2);
+            Serial.print(" % ");
+        }
+        Serial.println();
+    }
+
+    Serial.print("FECなし                                  ");
+    for (uint8_t l = 0; l < sizeof(LOSS_RATES) / sizeof(LOSS_RATES[0]); l++)
+    {
+        Serial.print(LOSS_RATES[l] * 100.0f, 2);
+        Serial.print(" % ");
+    }
+    Serial.println();
+
+    // 復元の確認: グループ0の2番目のフラグメントをパリティから復元
+    memset(parity, 0, sizeof(parity));
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        MLR_File_XorParity(parity, fragments[i], MLR_FILE_MAX_FRAGMENT_LEN);
+    }
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        if (i != 1)
+        {
+            MLR_File_XorParity(parity, fragments[i], MLR_FILE_MAX_FRAGMENT_LEN);
+        }
+    }
+    Serial.println(memcmp(parity, fragments[1], MLR_FILE_MAX_FRAGMENT_LEN) == 0 ? "復元結果: 一致" : "復元結果: 不一致");
+}
+
+void loop()
+{
+}
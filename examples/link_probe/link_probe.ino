@@ -0,0 +1,102 @@
+/**
+ * @file link_probe.ino
+ * @brief リンクの往復遅延(RTT)・スループット・損失率の測定サンプル
+ * @copyright Copyright (c) 2026 CircuitDesign,Inc.
+ * This software is released under the MIT License.
+ * http://opensource.org/licenses/mit-license.php
+ *
+ * @details
+ * 2台のモデムを使って、ペイロード長ごとに次の値を測定します。
+ * - RTT (最小 / 平均 / 99パーセンタイル / 最大)
+ * - 損失率
+ * - グッドプット (エコーが返ったペイロードのバイト数 / 測定時間)
+ *
+ * 一方を PROBE_RESPONDER を 1 にして書き込み(エコー応答側)、
+ * もう一方を 0 にして書き込みます(測定側)。
+ * RTTには両方のモデムのシリアルコマンドの処理時間と、往復の通信時間が含まれます。
+ *
+ * 拡散率(SF)ごとに測定する場合は、両方のモデムを同じ設定に変更してから測定してください。
+ *
+ * このサンプルを実行するには、Arduino互換ボードのSerial1に
+ * MLRモデムが接続されている必要があります (デフォルトボーレート 19200 bps)。
+ */
+#include <MLR_Modem.h>
+#include <MLR_LinkProbe.h>
+
+// 1: エコー応答側、0: 測定側
+#define PROBE_RESPONDER 0
+
+// MLRモデムのデフォルトボーレート
+#define MLR_DEFAULT_BAUDRATE 19200
+
+// 測定するペイロード長 (フレームヘッダを除く)
+static const uint8_t PAYLOAD_LENGTHS[] = {MLR_PROBE_HEADER_LEN, 32, 64, 128, 200};
+// ペイロード長ごとのプローブ数
+static const uint16_t PROBES_PER_LENGTH = 20;
+// エコーの待ち時間 (SF10で200バイトの往復を含む)
+static const uint32_t PROBE_TIMEOUT_MS = 5000;
+
+MLR_Modem modem;
+MLR_LinkProbe probe;
+
+static void printResults()
+{
+    Serial.println("長さ  送信  受信  損失(%)  最小(ms)  平均(ms)  p99(ms)  最大(ms)  グッドプット(B/s)");
+    for (uint8_t i = 0; i < probe.GetResultCount(); i++)
+    {
+        const MLR_ProbeResult *r = probe.GetResult(i);
+        Serial.printf("%4u  %4u  %4u  %7.1f  %8.1f  %8.1f  %7.1f  %8.1f  %u\n", r->payloadLen, r->sent, r->received,
+                      r->GetLoss() / 10.0f, r->minUs / 1000.0f, r->avgUs / 1000.0f, r->p99Us / 1000.0f,
+                      r->maxUs / 1000.0f, (unsigned)r->goodputBps);
+    }
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    while (!Serial)
+        ;
+
+    Serial1.begin(MLR_DEFAULT_BAUDRATE);
+    if (modem.begin(Serial1) != MLR_Modem_Error::Ok)
+    {
+        Serial.println("MLRモデムの初期化に失敗しました。接続とボーレートを確認してください。");
+        while (true)
+            ;
+    }
+
+    probe.begin(modem);
+
+#if PROBE_RESPONDER
+    probe.SetResponder(true);
+    Serial.println("--- エコー応答中 ---");
+#else
+    Serial.println("--- リンク測定開始 ---");
+    if (probe.Start(PAYLOAD_LENGTHS, sizeof(PAYLOAD_LENGTHS), PROBES_PER_LENGTH, PROBE_TIMEOUT_MS) != MLR_Modem_Error::Ok)
+    {
+        Serial.println("測定を開始できませんでした。");
+    }
+#endif
+}
+
+void loop()
+{
+    modem.Work();
+    probe.Work();
+
+#if PROBE_RESPONDER
+    static uint32_t lastEchoCount = 0;
+    if (probe.GetEchoCount() != lastEchoCount)
+    {
+        lastEchoCount = probe.GetEchoCount();
+        Serial.printf("エコー送信: %u\n", (unsigned)lastEchoCount);
+    }
+#else
+    static bool reported = false;
+    if (!probe.IsRunning() && !reported)
+    {
+        reported = true;
+        printResults();
+    }
+#endif
+}
@@ -0,0 +1,156 @@
+/**
+ * @file metrics_exporter.ino
+ * @brief ドライバのカウンタをPrometheus形式で出力するサンプル
+ * @copyright Copyright (c) 2026 CircuitDesign,Inc.
+ * This software is released under the MIT License.
+ * http://opensource.org/licenses/mit-license.php
+ *
+ * @details
+ * MLR_Modemは送受信パケット数、LBT(キャリアセンス)による送信失敗、パーサのエラー、
+ * コマンドの応答時間(ヒストグラム)などのカウンタを持っています (MLR_ModemStats)。
+ * MLR_MetricsExporterは、これらのカウンタをPrometheusのテキスト形式で出力します。
+ * カウンタの読み出しはロックを使わないため、ゲートウェイなどで別スレッドから読み出しても
+ * 受信処理(MLR_Modem::Work())を止めることはありません。
+ *
+ * このサンプルプログラムは2台のモデムをエミュレータ(MLR_ModemEmulator)で接続し、
+ * モデムAが送信したパケットをモデムBがエコーで返します。LBTの失敗とシリアル回線のノイズも
+ * 発生させます。5秒ごとにモデムAのメトリクスをSerialに出力します。
+ *
+ * Linuxで実行した場合は、さらに次の方法でメトリクスを公開します。
+ * - http://127.0.0.1:9429/metrics でPrometheusからスクレイプ (Listen() と Work())
+ * - /tmp/mlr_modem.prom に書き出し、node_exporterのtextfile collectorで収集 (WriteFile())
+ */
+#include <MLR_Modem.h>
+#include <MLR_ModemEmulator.h>
+#include <MLR_MetricsExporter.h>
+
+// メトリクスを出力する間隔
+static const uint32_t REPORT_INTERVAL_MS = 5000;
+// 送信間隔
+static const uint32_t TX_INTERVAL_MS = 300;
+// ノイズを送る間隔
+static const uint32_t NOISE_INTERVAL_MS = 2000;
+// 実行時間
+static const uint32_t RUN_TIME_MS = 20000;
+
+MLR_ModemEmulator emulatorA;
+MLR_ModemEmulator emulatorB;
+MLR_Modem modemA;
+MLR_Modem modemB;
+MLR_MetricsExporter exporter;
+
+static uint8_t g_echo[MLR_MAX_PAYLOAD_LEN];
+static uint8_t g_echoLen;
+static uint32_t g_startMs;
+static uint32_t g_lastTxMs;
+static uint32_t g_lastNoiseMs;
+static uint32_t g_lastReportMs;
+static uint16_t g_seq;
+static bool g_running;
+
+// モデムB: 受信したパケットをエコーで返すために保存
+void modemBCallback(MLR_Modem_Error error, MLR_Modem_Response responseType, int32_t value, const uint8_t *pPayload, uint16_t len)
+{
+    if (responseType == MLR_Modem_Response::DataReceived)
+    {
+        memcpy(g_echo, pPayload, len);
+        g_echoLen = len;
+    }
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    while (!Serial)
+        ;
+
+    emulatorA.begin();
+    emulatorB.begin();
+    emulatorA.Connect(&emulatorB);
+    emulatorB.Connect(&emulatorA);
+    emulatorA.SetLbtFailRate(10); // モデムAの送信の10%をLBTで失敗させる
+    if (modemA.begin(emulatorA) != MLR_Modem_Error::Ok || modemB.begin(emulatorB, modemBCallback) != MLR_Modem_Error::Ok)
+    {
+        Serial.println("エミュレータに接続できませんでした。");
+        return;
+    }
+
+    // 全てのメトリクスにラベルを付ける (複数のモデムを区別するため)
+    exporter.begin(modemA, "modem=\"A\"");
+
+#if defined(__linux__)
+    if (exporter.Listen(9429) == MLR_Modem_Error::Ok)
+    {
+        Serial.println("http://127.0.0.1:9429/metrics でメトリクスを公開しています。");
+    }
+    else
+    {
+        Serial.println("ポート9429を開けませんでした。");
+    }
+#endif
+
+    g_startMs = millis();
+    g_lastTxMs = g_startMs;
+    g_lastNoiseMs = g_startMs;
+    g_lastReportMs = g_startMs;
+    g_running = true;
+}
+
+void loop()
+{
+    if (!g_running)
+    {
+        return;
+    }
+
+    modemA.Work();
+    modemB.Work();
+    if (g_echoLen > 0)
+    {
+        modemB.TransmitData(g_echo, g_echoLen);
+        g_echoLen = 0;
+    }
+
+    uint32_t now = millis();
+    if (now - g_lastTxMs >= TX_INTERVAL_MS)
+    {
+        g_lastTxMs = now;
+        uint8_t payload[16];
+        snprintf(reinterpret_cast<char *>(payload), sizeof(payload), "ping %u", g_seq++);
+        modemA.TransmitData(payload, strlen(reinterpret_cast<char *>(payload)));
+    }
+
+    if (now - g_lastNoiseMs >= NOISE_INTERVAL_MS)
+    {
+        // シリアル回線のノイズ: パーサのエラーとして数えられる
+        g_lastNoiseMs = now;
+        static const uint8_t noise[] = "*Q\x01\x02\r\n";
+        emulatorA.InjectRaw(noise, sizeof(noise) - 1);
+    }
+
+#if defined(__linux__)
+    exporter.Work(); // スクレイプに応答 (別スレッドで呼び出すこともできます)
+#endif
+
+    if (now - g_lastReportMs >= REPORT_INTERVAL_MS)
+    {
+        g_lastReportMs = now;
+        Serial.printf("--- %lu ms ---\n", (unsigned long)(now - g_startMs));
+        exporter.Render(Serial);
+#if defined(__linux__)
+        if (exporter.WriteFile("/tmp/mlr_modem.prom") != MLR_Modem_Error::Ok)
+        {
+            Serial.println("/tmp/mlr_modem.prom を書き込めませんでした。");
+        }
+#endif
+    }
+
+    if (now - g_startMs >= RUN_TIME_MS)
+    {
+        g_running = false;
+#if defined(__linux__)
+        exporter.Close();
+#endif
+        Serial.println("--- 終了 ---");
+    }
+}
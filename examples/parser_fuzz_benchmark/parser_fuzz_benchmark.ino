@@ -0,0 +1,316 @@
+/**
+ * @file parser_fuzz_benchmark.ino
+ * @brief 不正な受信データに対する受信パーサの処理時間と再同期のベンチマーク
+ * @copyright Copyright (c) 2026 CircuitDesign,Inc.
+ * This software is released under the MIT License.
+ * http://opensource.org/licenses/mit-license.php
+ *
+ * @details
+ * シリアル回線のノイズや故障したモデムからの不正なデータ (連続した '*'、改行のない "*XX=..."、
+ * 不正な長さの "*DR=FF" など) が、Work() の処理時間を占有したり、後続の応答を取りこぼしたりしないことを確認します。
+ *
+ * このサンプルプログラムは、正常な応答と不正なデータの種(SEEDS)を変異させた入力を、
+ * エミュレータ(MLR_ModemEmulator)の InjectRaw() で受信させて Work() で処理します。
+ * 受信パーサの状態遷移 (GetParserState()) で新しい遷移を通った入力はコーパスに追加し、
+ * 次の入力の元にします (カバレッジガイド付きファジング)。
+ *
+ * 各入力の後には正常な *DR パケット(マーカー)を1つずつ受信させ、最初のマーカーを受信するまでに
+ * 捨てられたマーカーのバイト数を再同期の遅れとして測定します。最後に次の値を表示します。
+ * - 1バイトあたりの平均処理時間、Work() 1回の最大処理時間とその時に処理したバイト数
+ * - 再同期の最大の遅れ (バイト) と、その原因の入力
+ * - 通過した状態遷移の数
+ *
+ * "*DR=FF" のような長さの壊れたパケットは、長さ分のデータを読み終えるまで後続のデータを取り込みます。
+ * 受信が途切れた場合は MLR_DR_BYTE_TIMEOUT_MS で破棄されます。ノイズの読み捨ては
+ * Work() 1回あたり MLR_FLUSH_MAX_BYTES バイトまでです。処理時間にはエミュレータ自身の処理時間も含まれます。
+ */
+#include <MLR_Modem.h>
+#include <MLR_ModemEmulator.h>
+
+// 受信のボーレート
+static const uint32_t BAUD_RATE = 115200;
+// 入力の数
+static const uint16_t ITERATIONS = 1000;
+// 入力の最大長
+static const uint8_t MAX_INPUT_LEN = 64;
+// コーパスの最大数
+static const uint8_t CORPUS_LEN = 32;
+// 入力ごとの最大マーカー数 (長さ 0xFF の *DR を読み切るのに十分な数)
+static const uint8_t MAX_MARKERS = 24;
+// マーカーの長さ ("*DR=06SYNCnn\r\n")
+static const uint8_t MARKER_LEN = 14;
+static const uint8_t NO_MARKER = 0xFF;
+
+// 正常な応答と不正なデータの種
+static const char *const SEEDS[] = {
+    "*CH=07\r\n",
+    "*DR=05hello\r\n",
+    "*IR=03\r\n",
+    "*WR=PS\r\n*SF=00\r\n",
+    "LORA CMD MODE\r\n",
+    "*RS=-80dBm\r\n",
+    "****************",
+    "*DR=FF*DR=FF",
+    "*DR=ZZ\r\n",
+    "*XX=AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA",
+    "*DR=03\r\n\r\n\r\n",
+    "\r\n\r\n*C*CH=0",
+};
+
+// 変異で挿入する文字
+static const uint8_t SPECIAL[] = {'*', '\r', '\n', '=', 'D', 'R', 'F', '0', 0x00, 0xFF};
+
+struct Input
+{
+    uint8_t len;
+    uint8_t data[MAX_INPUT_LEN];
+};
+
+MLR_ModemEmulator emulator;
+MLR_Modem modem;
+
+static Input corpus[CORPUS_LEN];
+static uint8_t corpusCount;
+
+// 状態遷移のカバレッジ (遷移前の状態ごとの遷移後の状態のビット)
+static uint16_t g_edges[16];
+static bool g_newCoverage;
+
+// 処理時間
+static uint32_t g_bytes;
+static uint32_t g_totalUs;
+static uint32_t g_maxCallUs;
+static int g_maxCallBytes;
+
+// 再同期
+static uint8_t g_firstMarker;
+static uint16_t g_worstResync;
+static uint16_t g_resyncFailures;
+static Input g_worstInput;
+
+void modemCallback(MLR_Modem_Error error, MLR_Modem_Response responseType, int32_t value, const uint8_t *pPayload, uint16_t len)
+{
+    if (responseType == MLR_Modem_Response::DataReceived && len == 6 && memcmp(pPayload, "SYNC", 4) == 0 &&
+        g_firstMarker == NO_MARKER)
+    {
+        g_firstMarker = (pPayload[4] - '0') * 10 + (pPayload[5] - '0');
+    }
+}
+
+// データを受信させ、すべて処理されるまで Work() を呼び出す
+static void feed(const uint8_t *pData, uint8_t len)
+{
+    if (emulator.InjectRaw(pData, len) != MLR_Modem_Error::Ok)
+    {
+        return;
+    }
+    while (emulator.available() < len)
+        ;
+
+    uint8_t prev = static_cast<uint8_t>(modem.GetParserState());
+    while (emulator.available() > 0)
+    {
+        int before = emulator.available();
+        uint32_t t = micros();
+        modem.Work();
+        uint32_t dt = micros() - t;
+        int used = before - emulator.available();
+
+        g_bytes += used;
+        g_totalUs += dt;
+        if (dt > g_maxCallUs)
+        {
+            g_maxCallUs = dt;
+            g_maxCallBytes = used;
+        }
+
+        uint8_t cur = static_cast<uint8_t>(modem.GetParserState());
+        if (!(g_edges[prev & 0x0F] & (1u << (cur & 0x0F))))
+        {
+            g_edges[prev & 0x0F] |= 1u << (cur & 0x0F);
+            g_newCoverage = true;
+        }
+        prev = cur;
+    }
+}
+
+// マーカーを1つずつ受信させ、捨てられたマーカーのバイト数を返す (再同期できない場合は 0xFFFF)
+static uint16_t measureResync()
+{
+    g_firstMarker = NO_MARKER;
+    for (uint8_t i = 0; i < MAX_MARKERS && g_firstMarker == NO_MARKER; i++)
+    {
+        char marker[MARKER_LEN + 1];
+        snprintf(marker, sizeof(marker), "*DR=06SYNC%02u\r\n", i);
+        feed(reinterpret_cast<const uint8_t *>(marker), MARKER_LEN);
+    }
+    return (g_firstMarker == NO_MARKER) ? 0xFFFF : g_firstMarker * MARKER_LEN;
+}
+
+static void mutate(Input &in)
+{
+    for (uint8_t n = 1 + random(4); n > 0; n--)
+    {
+        uint8_t pos = in.len ? random(in.len) : 0;
+        switch (random(6))
+        {
+        case 0: // ビット反転
+            if (in.len > 0)
+            {
+                in.data[pos] ^= 1 << random(8);
+            }
+            break;
+
+        case 1: // 特殊文字に置き換え
+            if (in.len > 0)
+            {
+                in.data[pos] = SPECIAL[random(sizeof(SPECIAL))];
+            }
+            break;
+
+        case 2: // 特殊文字を挿入
+            if (in.len < MAX_INPUT_LEN)
+            {
+                memmove(&in.data[pos + 1], &in.data[pos], in.len - pos);
+                in.data[pos] = SPECIAL[random(sizeof(SPECIAL))];
+                in.len++;
+            }
+            break;
+
+        case 3: // 1文字削除
+            if (in.len > 1)
+            {
+                memmove(&in.data[pos], &in.data[pos + 1], in.len - pos - 1);
+                in.len--;
+            }
+            break;
+
+        case 4: // 別の入力をつなぐ
+        {
+            const Input &other = corpus[random(corpusCount)];
+            uint8_t len = (other.len < MAX_INPUT_LEN - pos) ? other.len : MAX_INPUT_LEN - pos;
+            memcpy(&in.data[pos], other.data, len);
+            in.len = pos + len;
+            break;
+        }
+
+        default: // 途中で切る
+            in.len = pos + 1;
+            break;
+        }
+    }
+}
+
+static void printInput(const Input &in)
+{
+    for (uint8_t i = 0; i < in.len; i++)
+    {
+        uint8_t c = in.data[i];
+        if (c == '\r')
+        {
+            Serial.print("\\r");
+        }
+        else if (c == '\n')
+        {
+            Serial.print("\\n");
+        }
+        else if (c >= 0x20 && c < 0x7F)
+        {
+            Serial.write(c);
+        }
+        else
+        {
+            Serial.printf("\\x%02X", c);
+        }
+    }
+    Serial.println();
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    while (!Serial)
+        ;
+
+    randomSeed(1); // 再現性のため固定
+    emulator.begin(BAUD_RATE, MLR_EMULATOR_UART_BUFFER_LEN);
+    if (modem.begin(emulator, modemCallback) != MLR_Modem_Error::Ok)
+    {
+        Serial.println("エミュレータに接続できませんでした。");
+        return;
+    }
+
+    for (uint8_t i = 0; i < sizeof(SEEDS) / sizeof(SEEDS[0]); i++)
+    {
+        corpus[i].len = strlen(SEEDS[i]);
+        memcpy(corpus[i].data, SEEDS[i], corpus[i].len);
+        corpusCount++;
+    }
+
+    Serial.printf("--- 受信パーサのファジング (%u 入力, %lu bps) ---\n", ITERATIONS, (unsigned long)BAUD_RATE);
+    for (uint16_t i = 0; i < ITERATIONS; i++)
+    {
+        // 最初は種をそのまま、その後は変異させた入力
+        Input in = corpus[i % corpusCount];
+        if (i >= corpusCount)
+        {
+            mutate(in);
+        }
+
+        g_newCoverage = false;
+        feed(in.data, in.len);
+        uint16_t resync = measureResync();
+        if (resync == 0xFFFF)
+        {
+            g_resyncFailures++;
+            delay(MLR_DR_BYTE_TIMEOUT_MS + 10); // 途中の *DR を破棄させる
+            modem.Work();
+        }
+        else if (resync > g_worstResync)
+        {
+            g_worstResync = resync;
+            g_worstInput = in;
+        }
+
+        if (g_newCoverage && corpusCount < CORPUS_LEN)
+        {
+            corpus[corpusCount++] = in;
+        }
+    }
+
+    uint8_t edgeCount = 0;
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        for (uint16_t bits = g_edges[i]; bits; bits &= bits - 1)
+        {
+            edgeCount++;
+        }
+    }
+
+    Serial.printf("処理したバイト数        : %lu\n", (unsigned long)g_bytes);
+    Serial.printf("平均処理時間            : %.2f us/バイト\n", g_bytes ? (float)g_totalUs / g_bytes : 0.0f);
+    Serial.printf("Work() 1回の最大処理時間: %lu us (%d バイト)\n", (unsigned long)g_maxCallUs, g_maxCallBytes);
+    Serial.printf("状態遷移 / コーパス     : %u / %u\n", edgeCount, corpusCount);
+    Serial.printf("再同期の最大の遅れ      : %u バイト, 原因の入力: ", g_worstResync);
+    printInput(g_worstInput);
+    Serial.printf("再同期できなかった入力  : %u\n", g_resyncFailures);
+
+    // ノイズだけが続く場合: Work() 1回で読み捨てるバイト数は MLR_FLUSH_MAX_BYTES まで
+    uint8_t noise[MAX_INPUT_LEN];
+    memset(noise, 'A', sizeof(noise));
+    g_maxCallUs = 0;
+    feed(noise, sizeof(noise));
+    Serial.printf("ノイズ %u バイト         : Work() 1回の最大 %lu us (%d バイト)\n", (unsigned)sizeof(noise),
+                  (unsigned long)g_maxCallUs, g_maxCallBytes);
+
+    // 長さの壊れた *DR の後で受信が途切れた場合: タイムアウトで破棄され、次のパケットを取りこぼさない
+    feed(reinterpret_cast<const uint8_t *>("*DR=FFabc"), 9);
+    delay(MLR_DR_BYTE_TIMEOUT_MS + 10);
+    modem.Work();
+    Serial.printf("途切れた *DR の後の遅れ : %u バイト\n", measureResync());
+    Serial.println("--- 完了 ---");
+}
+
+void loop()
+{
+}
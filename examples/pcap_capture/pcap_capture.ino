@@ -0,0 +1,127 @@
+/**
+ * @file pcap_capture.ino
+ * @brief 送受信したパケットをpcap形式で記録し、Wiresharkなどで解析するサンプル
+ * @copyright Copyright (c) 2026 CircuitDesign,Inc.
+ * This software is released under the MIT License.
+ * http://opensource.org/licenses/mit-license.php
+ *
+ * @details
+ * MLR_PcapWriterは、受信したパケット(*DR)と送信したパケット(@DT)を、タイムスタンプと
+ * リンク情報(モード、チャンネル、拡散率、RSSI)付きでpcap形式で出力します。
+ * ドライバの中ではリングバッファにコピーするだけで、出力は Work() で少しずつ行うため、
+ * 記録が通信のタイミングに影響しません。
+ *
+ * このサンプルプログラムは2台のモデムをエミュレータ(MLR_ModemEmulator)で接続し、
+ * モデムAが送信したパケットをモデムBがエコーで返す通信を、モデムA側で記録します。
+ * 記録はSerialに16進数で出力します。出力を "xxd -r -p > capture.pcap" で変換すると
+ * Wiresharkで開くことができます。実際の機器では、SDカードのファイル(File)などを出力先にしてください。
+ *
+ * リンクタイプは MLR_PCAP_LINKTYPE (LINKTYPE_USER0) です。Wiresharkでは各パケットの先頭8バイトが
+ * 疑似ヘッダ(方向、モード、チャンネル、拡散率、RSSI)で、その後にパケットが続きます (MLR_PcapWriter.h 参照)。
+ */
+#include <MLR_Modem.h>
+#include <MLR_ModemEmulator.h>
+#include <MLR_PcapWriter.h>
+
+// 送信するパケット数
+static const uint8_t PACKETS = 4;
+
+// 16進数で出力するPrint
+class HexDump : public Print
+{
+public:
+    size_t write(uint8_t c) override
+    {
+        Serial.printf("%02x", c);
+        if (++m_column == 32)
+        {
+            Serial.println();
+            m_column = 0;
+        }
+        return 1;
+    }
+    using Print::write;
+
+private:
+    uint8_t m_column = 0;
+};
+
+MLR_ModemEmulator emulatorA;
+MLR_ModemEmulator emulatorB;
+MLR_Modem modemA;
+MLR_Modem modemB;
+MLR_PcapWriter pcap;
+HexDump hexOut;
+
+static uint8_t g_echo[MLR_MAX_PAYLOAD_LEN];
+static uint8_t g_echoLen;
+
+// モデムB: 受信したパケットをエコーで返すために保存
+void modemBCallback(MLR_Modem_Error error, MLR_Modem_Response responseType, int32_t value, const uint8_t *pPayload, uint16_t len)
+{
+    if (responseType == MLR_Modem_Response::DataReceived)
+    {
+        memcpy(g_echo, pPayload, len);
+        g_echoLen = len;
+    }
+}
+
+// 一定時間、両方のモデムと記録を処理
+static void run(uint32_t ms)
+{
+    uint32_t start = millis();
+    while (millis() - start < ms)
+    {
+        modemA.Work();
+        modemB.Work();
+        pcap.Work();
+        if (g_echoLen > 0)
+        {
+            modemB.TransmitData(g_echo, g_echoLen);
+            g_echoLen = 0;
+        }
+    }
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    while (!Serial)
+        ;
+
+    emulatorA.begin();
+    emulatorB.begin();
+    emulatorA.Connect(&emulatorB);
+    emulatorB.Connect(&emulatorA);
+    emulatorA.SetRssi(-72);
+    if (modemA.begin(emulatorA) != MLR_Modem_Error::Ok || modemB.begin(emulatorB, modemBCallback) != MLR_Modem_Error::Ok)
+    {
+        Serial.println("エミュレータに接続できませんでした。");
+        return;
+    }
+    modemA.SetRssiEnrichment(true); // 受信パケットのRSSIを記録する
+
+    Serial.println("--- pcap (16進数) ---");
+    if (pcap.begin(modemA, hexOut) != MLR_Modem_Error::Ok)
+    {
+        Serial.println("記録を開始できませんでした。");
+        return;
+    }
+
+    uint8_t payload[16];
+    for (uint8_t i = 0; i < PACKETS; i++)
+    {
+        snprintf(reinterpret_cast<char *>(payload), sizeof(payload), "ping %u", i);
+        modemA.TransmitData(payload, strlen(reinterpret_cast<char *>(payload)));
+        run(500); // エコーを受信
+    }
+
+    pcap.end();
+    Serial.println();
+    Serial.printf("--- 記録 %lu パケット, 破棄 %lu パケット ---\n", (unsigned long)pcap.GetRecordCount(),
+                  (unsigned long)pcap.GetDropCount());
+}
+
+void loop()
+{
+}
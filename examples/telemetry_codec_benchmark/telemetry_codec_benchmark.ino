@@ -0,0 +1,298 @@
+/**
+ * @file telemetry_codec_benchmark.ino
+ * @brief テレメトリ圧縮エンコーダ(MLR_TelemetryCodec.h)のベンチマークと送受信サンプル
+ * @copyright Copyright (c) 2026 CircuitDesign,Inc.
+ * This software is released under the MIT License.
+ * http://opensource.org/licenses/mit-license.php
+ *
+ * @details
+ * このサンプルプログラムは、センサーデータのような型付きレコードを、
+ * 可変長整数(varint)、前回値との差分(delta)、ブール値のビットパッキングを使って
+ * 小さなペイロードに変換する方法を示します。
+ *
+ * 動作:
+ * 1. setup()関数で、同じ計測データをASCIIテキスト、パック構造体、本エンコーダの3通りで
+ *    エンコードし、バイト数、LoRa SF9/125kHzでの送信時間、エンコード/デコード時間を表示します。
+ * 2. loop()関数内で、10秒ごとに計測データをエンコードして送信します。
+ *    10回に1回は差分を使わないキーレコードを送信し、受信側が途中から受信しても復元できるようにします。
+ * 3. 受信したレコードはmodem.GetPacket()で得たバッファから直接(コピーせずに)デコードし、
+ *    modem.DeletePacket()の前に処理を終えます。
+ *
+ * このサンプルを実行するには、Arduino互換ボードのSerial1に
+ * MLRモデムが接続されている必要があります。
+ */
+#include <MLR_Modem.h>
+#include <MLR_Airtime.h>
+#include <MLR_TelemetryCodec.h>
+
+MLR_Modem modem;
+
+// レコードのスキーマ (送信側と受信側で同じ定義を使います)
+enum Field
+{
+    Temperature, // 0.01℃単位
+    Humidity,    // 0.1%単位
+    Pressure,    // Pa単位
+    Battery,     // mV単位
+    Counter,     // 計測回数
+    DoorOpen,
+    Alarm,
+    Charging,
+    FieldCount
+};
+
+static const MLR_TelemetryField schema[FieldCount] = {
+    {MLR_TelemetryType::Signed, true},   // Temperature
+    {MLR_TelemetryType::Unsigned, true}, // Humidity
+    {MLR_TelemetryType::Unsigned, true}, // Pressure
+    {MLR_TelemetryType::Unsigned, true}, // Battery
+    {MLR_TelemetryType::Unsigned, true}, // Counter
+    {MLR_TelemetryType::Bool, false},    // DoorOpen
+    {MLR_TelemetryType::Bool, false},    // Alarm
+    {MLR_TelemetryType::Bool, false},    // Charging
+};
+
+// 比較用のパック構造体
+struct __attribute__((packed)) PackedRecord
+{
+    int16_t temperature;
+    uint16_t humidity;
+    uint32_t pressure;
+    uint16_t battery;
+    uint32_t counter;
+    uint8_t flags;
+};
+
+static const uint8_t BENCH_LOOPS = 200;
+static const uint8_t LORA_SF = 9;
+static const uint32_t LORA_BW_HZ = 125000;
+
+static int32_t txValues[FieldCount];
+static int32_t txPrev[FieldCount];
+static bool txHasPrev = false;
+
+static int32_t rxValues[FieldCount];
+static bool rxHasPrev = false;
+static uint8_t rxSeq = 0;
+
+// 計測データのシミュレーション (ゆっくり変化する値)
+static void sample(int32_t *pValues, uint32_t n)
+{
+    pValues[Temperature] = 2350 + (int32_t)(n % 7) - 3;
+    pValues[Humidity] = 452 + (int32_t)(n % 3);
+    pValues[Pressure] = 101325 - (int32_t)(n % 5);
+    pValues[Battery] = 3700 - (int32_t)(n / 16);
+    pValues[Counter] = (int32_t)n;
+    pValues[DoorOpen] = (n % 4) == 0;
+    pValues[Alarm] = 0;
+    pValues[Charging] = 1;
+}
+
+static void printResult(const char *name, uint8_t len, uint32_t encodeUs, uint32_t decodeUs)
+{
+    Serial.print(name);
+    Serial.print(": ");
+    Serial.print(len);
+    Serial.print(" バイト, 送信時間 ");
+    Serial.print(MLR_Airtime_LoRaUs(len, LORA_SF, LORA_BW_HZ) / 1000.0f, 1);
+    Serial.print(" ms, エンコード ");
+    Serial.print(encodeUs / (float)BENCH_LOOPS, 2);
+    Serial.print(" us, デコード ");
+    Serial.print(decodeUs / (float)BENCH_LOOPS, 2);
+    Serial.println(" us");
+}
+
+static void benchmark()
+{
+    int32_t prev[FieldCount];
+    int32_t values[FieldCount];
+    int32_t decoded[FieldCount];
+    uint8_t buf[MLR_MAX_PAYLOAD_LEN];
+    volatile uint32_t sink = 0; // 最適化による削除を防止
+    uint8_t len = 0;
+    uint32_t t;
+    uint32_t encodeUs;
+
+    sample(prev, 100);
+    sample(values, 101);
+
+    // ASCIIテキスト
+    t = micros();
+    for (uint8_t i = 0; i < BENCH_LOOPS; i++)
+    {
+        len = snprintf((char *)buf, sizeof(buf), "T=%ld,H=%ld,P=%ld,B=%ld,C=%ld,D=%ld,A=%ld,G=%ld",
+                       (long)values[Temperature], (long)values[Humidity], (long)values[Pressure], (long)values[Battery],
+                       (long)values[Counter], (long)values[DoorOpen], (long)values[Alarm], (long)values[Charging]);
+        sink += buf[len - 1];
+    }
+    encodeUs = micros() - t;
+    t = micros();
+    for (uint8_t i = 0; i < BENCH_LOOPS; i++)
+    {
+        long v[FieldCount];
+        sscanf((const char *)buf, "T=%ld,H=%ld,P=%ld,B=%ld,C=%ld,D=%ld,A=%ld,G=%ld",
+               &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7]);
+        sink += v[Counter];
+    }
+    printResult("ASCIIテキスト", len, encodeUs, micros() - t);
+
+    // パック構造体
+    PackedRecord record;
+    t = micros();
+    for (uint8_t i = 0; i < BENCH_LOOPS; i++)
+    {
+        record.temperature = values[Temperature];
+        record.humidity = values[Humidity];
+        record.pressure = values[Pressure];
+        record.battery = values[Battery];
+        record.counter = values[Counter];
+        record.flags = values[DoorOpen] | (values[Alarm] << 1) | (values[Charging] << 2);
+        memcpy(buf, &record, sizeof(record));
+        sink += buf[0];
+    }
+    encodeUs = micros() - t;
+    t = micros();
+    for (uint8_t i = 0; i < BENCH_LOOPS; i++)
+    {
+        memcpy(&record, buf, sizeof(record));
+        sink += record.counter;
+    }
+    printResult("パック構造体", sizeof(record), encodeUs, micros() - t);
+
+    // 本エンコーダ (キーレコード)
+    t = micros();
+    for (uint8_t i = 0; i < BENCH_LOOPS; i++)
+    {
+        len = MLR_Telemetry_Encode(schema, FieldCount, values, nullptr, 0, buf, sizeof(buf));
+        sink += len;
+    }
+    encodeUs = micros() - t;
+    t = micros();
+    for (uint8_t i = 0; i < BENCH_LOOPS; i++)
+    {
+        sink += MLR_Telemetry_Decode(schema, FieldCount, buf, len, decoded, nullptr, 0);
+    }
+    printResult("varint (キー)", len, encodeUs, micros() - t);
+
+    // 本エンコーダ (差分レコード)
+    t = micros();
+    for (uint8_t i = 0; i < BENCH_LOOPS; i++)
+    {
+        len = MLR_Telemetry_Encode(schema, FieldCount, values, prev, 1, buf, sizeof(buf));
+        sink += len;
+    }
+    encodeUs = micros() - t;
+    t = micros();
+    for (uint8_t i = 0; i < BENCH_LOOPS; i++)
+    {
+        sink += MLR_Telemetry_Decode(schema, FieldCount, buf, len, decoded, prev, 0);
+    }
+    printResult("varint (差分)", len, encodeUs, micros() - t);
+
+    // 復元結果の確認
+    bool ok = true;
+    for (uint8_t i = 0; i < FieldCount; i++)
+    {
+        ok = ok && (decoded[i] == values[i]);
+    }
+    Serial.println(ok ? "デコード結果: 一致" : "デコード結果: 不一致");
+    (void)sink;
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    // シリアルポートが開くまで待機
+    while (!Serial)
+        ;
+
+    Serial.println("--- テレメトリエンコーダ ベンチマーク ---");
+    benchmark();
+
+    // モデム用のシリアルポートを初期化 (MLRモデムのデフォルトは19200)
+    Serial1.begin(MLR_DEFAULT_BAUDRATE);
+
+    // モデムドライバを初期化
+    MLR_Modem_Error err = modem.begin(Serial1);
+    if (err != MLR_Modem_Error::Ok)
+    {
+        Serial.println("MLRモデムの初期化に失敗しました。接続とボーレートを確認してください。");
+        while (true)
+            ;
+    }
+
+    // 無線通信モードをLoRaモード、拡散率をSF9に設定 (設定は保存しません)
+    modem.SetMode(MLR_ModemMode::LoRaCmd, false);
+    modem.SetSpreadFactor(MLR_ModemSpreadFactor::Chips512, false);
+}
+
+void loop()
+{
+    // モデムの内部処理(受信データの解析など)を実行するために、Work()を常に呼び出します。
+    modem.Work();
+
+    // --- 受信処理: 受信バッファから直接デコード ---
+    if (modem.HasPacket())
+    {
+        const uint8_t *pPayload;
+        uint8_t len;
+
+        if (modem.GetPacket(&pPayload, &len) == MLR_Modem_Error::Ok)
+        {
+            // 差分レコードは前回の値が必要です。rxValuesを前回値として上書きデコードします。
+            // 差分の元になったレコード(シーケンス番号)がrxSeqと異なる場合は、デコードに失敗します。
+            if (MLR_Telemetry_Decode(schema, FieldCount, pPayload, len, rxValues, rxHasPrev ? rxValues : nullptr, rxSeq))
+            {
+                rxHasPrev = true;
+                rxSeq = MLR_Telemetry_GetSequence(pPayload);
+                Serial.print("受信: 温度 ");
+                Serial.print(rxValues[Temperature] / 100.0f, 2);
+                Serial.print(" ℃, 湿度 ");
+                Serial.print(rxValues[Humidity] / 10.0f, 1);
+                Serial.print(" %, 回数 ");
+                Serial.println(rxValues[Counter]);
+            }
+            else
+            {
+                // 前回のレコードを取りこぼした場合は、次のキーレコードまで待ちます
+                rxHasPrev = false;
+                Serial.println("受信: デコードできません (キーレコード待ち)");
+            }
+        }
+
+        // デコードはバッファ上で完了しているので、すぐに解放できます
+        modem.DeletePacket();
+    }
+
+    // --- 送信処理: 10秒ごとにレコードを送信 ---
+    static uint32_t lastSendTime = 0;
+    static uint32_t count = 0;
+    if (millis() - lastSendTime > 10000)
+    {
+        lastSendTime = millis();
+
+        sample(txValues, count);
+
+        // 10回に1回はキーレコードを送信
+        bool key = !txHasPrev || (count % 10) == 0;
+        uint8_t buf[MLR_MAX_PAYLOAD_LEN];
+        // シーケンス番号は送信ごとに1つずつ増やします (差分レコードは直前のレコードとの差分です)
+        uint8_t len = MLR_Telemetry_Encode(schema, FieldCount, txValues, key ? nullptr : txPrev, static_cast<uint8_t>(count), buf, sizeof(buf));
+
+        if (modem.TransmitData(buf, len) == MLR_Modem_Error::Ok)
+        {
+            memcpy(txPrev, txValues, sizeof(txPrev));
+            txHasPrev = true;
+            Serial.print(key ? "キーレコード送信: " : "差分レコード送信: ");
+            Serial.print(len);
+            Serial.println(" バイト");
+        }
+        else
+        {
+            // 送信できなかった場合は、次回キーレコードを送信します
+            txHasPrev = false;
+        }
+        count++;
+    }
+}
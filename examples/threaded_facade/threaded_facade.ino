@@ -0,0 +1,173 @@
+/**
+ * @file threaded_facade.ino
+ * @brief 複数のスレッド(タスク)から1台のモデムを使うサンプル
+ * @copyright Copyright (c) 2026 CircuitDesign,Inc.
+ * This software is released under the MIT License.
+ * http://opensource.org/licenses/mit-license.php
+ *
+ * @details
+ * MLR_Modemは排他制御をしていないため、複数のスレッドから同時に呼び出すと受信バッファや
+ * 応答待ちの状態が壊れます。MLR_ModemFacadeを使うと、モデムを使うのはドライバスレッドだけになり、
+ * 他のスレッドは送信やコマンドの要求(MLR_FacadeRequest)をロックフリーのキューに入れます。
+ * 要求を入れるときにロックを取ったりモデムを待ったりすることはありません。
+ * 結果は要求を出したスレッドに返ります。受け取り方は次の3通りです。
+ * - Transmit() / Command()          : 結果が出るまで待つ
+ * - Submit() の後に IsDone() / Wait() : 要求を出して、後で確認する
+ * - SetCompletionQueue()             : 終わった要求を自分の完了キューから取り出す
+ *
+ * このサンプルプログラムはエミュレータ(MLR_ModemEmulator)を使い、次のスレッドを RUN_MS の間動かします。
+ * - ドライバスレッド: facade.Work() を繰り返し呼び出す
+ * - 送信スレッド    : Transmit() でパケットを送信し、結果を待つ
+ * - コマンドスレッド: Command() でチャンネルの設定と読み出しを繰り返し、読み出した値を確認する
+ * - 非同期スレッド  : RSSIとシリアル番号の要求を完了キュー付きでまとめて出し、完了キューから結果を受け取る
+ * 最後に各スレッドの成功・失敗の数を表示します。失敗が0の場合に "OK" を表示します。
+ *
+ * スレッドには std::thread を使うため、ESP32とLinuxで動作します。
+ */
+#include <MLR_Modem.h>
+#include <MLR_ModemEmulator.h>
+#include <MLR_ModemFacade.h>
+
+#if defined(ESP32) || defined(__linux__)
+#include <atomic>
+#include <thread>
+
+// 実行時間
+static const uint32_t RUN_MS = 5000;
+// 非同期スレッドが一度に出す要求の数
+static const uint8_t ASYNC_BATCH = 4;
+
+MLR_ModemEmulator emulator;
+MLR_Modem modem;
+MLR_ModemFacade facade;
+
+static std::atomic<bool> g_running;       // 要求を出すスレッドの実行中フラグ
+static std::atomic<bool> g_driverRunning; // ドライバスレッドの実行中フラグ
+
+struct ThreadResult
+{
+    uint32_t ok;
+    uint32_t fail;
+};
+static ThreadResult g_tx, g_cmd, g_async;
+
+// ドライバスレッド: モデムを使うのはこのスレッドだけ
+static void driverThread()
+{
+    while (g_driverRunning)
+    {
+        if (!facade.Work())
+        {
+            delay(1); // 要求がなければ他のスレッドに譲る
+        }
+    }
+}
+
+static void transmitThread()
+{
+    uint8_t payload[16];
+    uint16_t seq = 0;
+    while (g_running)
+    {
+        snprintf(reinterpret_cast<char *>(payload), sizeof(payload), "tx %u", seq++);
+        MLR_Modem_Error err = facade.Transmit(payload, strlen(reinterpret_cast<char *>(payload)));
+        (err == MLR_Modem_Error::Ok) ? g_tx.ok++ : g_tx.fail++;
+    }
+}
+
+static void commandThread()
+{
+    uint8_t channel = 0x07;
+    while (g_running)
+    {
+        int32_t value = 0;
+        MLR_Modem_Error err = facade.Command(MLR_FacadeOp::SetChannel, channel);
+        if (err == MLR_Modem_Error::Ok)
+        {
+            err = facade.Command(MLR_FacadeOp::GetChannel, 0, &value);
+        }
+        (err == MLR_Modem_Error::Ok && value == channel) ? g_cmd.ok++ : g_cmd.fail++;
+        channel = (channel >= 0x2E) ? 0x07 : channel + 1;
+    }
+}
+
+static void asyncThread()
+{
+    MLR_FacadeRequest requests[ASYNC_BATCH];
+    MLR_FacadeQueue completions;
+    while (g_running)
+    {
+        uint8_t submitted = 0;
+        for (uint8_t i = 0; i < ASYNC_BATCH; i++)
+        {
+            requests[i].SetCommand((i & 1) ? MLR_FacadeOp::GetSerialNumber : MLR_FacadeOp::GetRssiCurrentChannel);
+            requests[i].SetCompletionQueue(&completions);
+            if (facade.Submit(&requests[i]) == MLR_Modem_Error::Ok)
+            {
+                submitted++;
+            }
+        }
+
+        // 結果はこのスレッドで受け取る
+        while (submitted > 0)
+        {
+            MLR_FacadeRequest *pDone = completions.Pop();
+            if (!pDone)
+            {
+                delay(1);
+                continue;
+            }
+            submitted--;
+            // 完了キューに入った直後は、まだ IsDone() が true になっていないことがあります。
+            // Wait() はすぐに結果を返し、その後は要求を再利用できます。
+            (pDone->Wait() == MLR_Modem_Error::Ok) ? g_async.ok++ : g_async.fail++;
+        }
+    }
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    while (!Serial)
+        ;
+
+    emulator.begin();
+    if (modem.begin(emulator) != MLR_Modem_Error::Ok ||
+        modem.SetSpreadFactor(MLR_ModemSpreadFactor::Chips128, false) != MLR_Modem_Error::Ok)
+    {
+        Serial.println("エミュレータに接続できませんでした。");
+        return;
+    }
+    facade.begin(modem);
+
+    g_running = true;
+    g_driverRunning = true;
+    std::thread driver(driverThread);
+    std::thread tx(transmitThread);
+    std::thread cmd(commandThread);
+    std::thread async(asyncThread);
+
+    delay(RUN_MS);
+    g_running = false;
+    tx.join();
+    cmd.join();
+    async.join();
+    g_driverRunning = false; // 最後に止める (他のスレッドの要求を最後まで処理する)
+    driver.join();
+
+    Serial.printf("送信:     成功 %lu, 失敗 %lu\n", (unsigned long)g_tx.ok, (unsigned long)g_tx.fail);
+    Serial.printf("コマンド: 成功 %lu, 失敗 %lu\n", (unsigned long)g_cmd.ok, (unsigned long)g_cmd.fail);
+    Serial.printf("非同期:   成功 %lu, 失敗 %lu\n", (unsigned long)g_async.ok, (unsigned long)g_async.fail);
+    Serial.println((g_tx.fail + g_cmd.fail + g_async.fail == 0 && g_tx.ok && g_cmd.ok && g_async.ok) ? "OK" : "NG");
+}
+#else
+void setup()
+{
+    Serial.begin(115200);
+    Serial.println("このサンプルはESP32またはLinuxで実行してください。");
+}
+#endif
+
+void loop()
+{
+}
@@ -0,0 +1,148 @@
+/**
+ * @file throughput_benchmark.ino
+ * @brief エミュレータを使った送信スループットのベンチマーク (拡散率 × ボーレート)
+ * @copyright Copyright (c) 2026 CircuitDesign,Inc.
+ * This software is released under the MIT License.
+ * http://opensource.org/licenses/mit-license.php
+ *
+ * @details
+ * MLR_ModemEmulatorはシリアルポートの代わりにMLR_Modemに接続するモデムのエミュレータです。
+ * ボーレートに応じた1バイトごとの転送時間、コマンドの応答時間、通信時間(MLR_Airtime.h)を再現するため、
+ * ドライバのシリアルコマンドのオーバーヘッドを含めた実際の送信性能を、モデムなしで測定できます。
+ *
+ * このサンプルプログラムは、すべてのボーレートと拡散率(MLR_ModemSpreadFactor)の組み合わせについて、
+ * TransmitData() と TransmitDataFireAndForget() で PAYLOAD_LEN バイトのフレームを連続送信し、
+ * 次の値を表示します。
+ * - フレーム/秒
+ * - ペイロードのバイト数/秒
+ * - 1フレームあたりのCPU時間 (ドライバ関数の中で費やした時間)
+ *
+ * TransmitData() は送信完了(*IR)まで戻らないため、通信時間の間もCPUを占有します。
+ * TransmitDataFireAndForget() は *DT の応答で戻り、送信完了はWork()で受け取るため、
+ * スループットはほぼ同じでも、CPU時間はシリアルコマンドの部分だけになります。
+ *
+ * 通信時間の計算には帯域幅 LORA_BW_HZ を使用します。モデムのデータシートの値に合わせてください。
+ * CPU時間にはエミュレータ自身の処理時間も含まれます。
+ */
+#include <MLR_Modem.h>
+#include <MLR_ModemEmulator.h>
+
+// 送信するペイロード長
+static const uint8_t PAYLOAD_LEN = 32;
+// 測定ごとの送信フレーム数
+static const uint8_t FRAMES = 5;
+// LoRaの帯域幅
+static const uint32_t LORA_BW_HZ = 125000;
+
+static const uint32_t BAUD_RATES[] = {1200, 2400, 4800, 9600, 19200};
+static const char *const SF_NAMES[] = {"128", "256", "512", "1024", "2048", "4096"};
+
+MLR_ModemEmulator emulator;
+MLR_Modem modem;
+
+static uint8_t payload[PAYLOAD_LEN];
+static volatile bool g_txDone = false;
+
+void modemCallback(MLR_Modem_Error error, MLR_Modem_Response responseType, int32_t value, const uint8_t *pPayload, uint16_t len)
+{
+    if (responseType == MLR_Modem_Response::MLR_Modem_DtIr)
+    {
+        g_txDone = true;
+    }
+}
+
+// 結果を1行表示
+static void printResult(uint32_t baud, uint8_t sf, const char *method, uint8_t frames, uint32_t elapsedUs, uint32_t cpuUs)
+{
+    float seconds = elapsedUs / 1000000.0f;
+    Serial.printf("%5u  %4s  %-16s  %6.2f  %8.1f  %8.2f\n", (unsigned)baud, SF_NAMES[sf], method,
+                  frames / seconds, frames * PAYLOAD_LEN / seconds, frames ? cpuUs / 1000.0f / frames : 0.0f);
+}
+
+// TransmitData(): 送信完了まで待機
+static void benchSync(uint32_t baud, uint8_t sf)
+{
+    uint8_t frames = 0;
+    uint32_t start = micros();
+    for (uint8_t i = 0; i < FRAMES; i++)
+    {
+        if (modem.TransmitData(payload, PAYLOAD_LEN) == MLR_Modem_Error::Ok)
+        {
+            frames++;
+        }
+    }
+    uint32_t elapsed = micros() - start;
+    printResult(baud, sf, "TransmitData", frames, elapsed, elapsed);
+}
+
+// TransmitDataFireAndForget(): 送信完了はWork()で受け取る
+static void benchFireAndForget(uint32_t baud, uint8_t sf)
+{
+    uint8_t frames = 0;
+    uint32_t cpu = 0;
+    uint32_t start = micros();
+    for (uint8_t i = 0; i < FRAMES; i++)
+    {
+        g_txDone = false;
+        uint32_t t = micros();
+        MLR_Modem_Error err = modem.TransmitDataFireAndForget(payload, PAYLOAD_LEN);
+        cpu += micros() - t;
+        if (err != MLR_Modem_Error::Ok)
+        {
+            continue;
+        }
+
+        // 送信完了までの間、アプリケーションは他の処理を実行できる
+        while (!g_txDone)
+        {
+            t = micros();
+            modem.Work();
+            cpu += micros() - t;
+        }
+        frames++;
+    }
+    uint32_t elapsed = micros() - start;
+    printResult(baud, sf, "FireAndForget", frames, elapsed, cpu);
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    while (!Serial)
+        ;
+
+    for (uint8_t i = 0; i < PAYLOAD_LEN; i++)
+    {
+        payload[i] = i;
+    }
+
+    Serial.printf("--- 送信スループット (ペイロード %u バイト, %u フレーム/測定) ---\n", PAYLOAD_LEN, FRAMES);
+    Serial.println(" baud  chip  method            frame/s     byte/s  CPU ms/frame");
+
+    for (uint8_t b = 0; b < sizeof(BAUD_RATES) / sizeof(BAUD_RATES[0]); b++)
+    {
+        emulator.begin(BAUD_RATES[b]);
+        emulator.SetLoRaBandwidth(LORA_BW_HZ);
+        if (modem.begin(emulator, modemCallback) != MLR_Modem_Error::Ok)
+        {
+            Serial.println("エミュレータに接続できませんでした。");
+            continue;
+        }
+
+        for (uint8_t sf = 0; sf < sizeof(SF_NAMES) / sizeof(SF_NAMES[0]); sf++)
+        {
+            if (modem.SetSpreadFactor(static_cast<MLR_ModemSpreadFactor>(sf), false) != MLR_Modem_Error::Ok)
+            {
+                Serial.println("拡散率の設定に失敗しました。");
+                continue;
+            }
+            benchSync(BAUD_RATES[b], sf);
+            benchFireAndForget(BAUD_RATES[b], sf);
+        }
+    }
+    Serial.println("--- 完了 ---");
+}
+
+void loop()
+{
+}
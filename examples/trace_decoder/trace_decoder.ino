@@ -0,0 +1,206 @@
+/**
+ * @file trace_decoder.ino
+ * @brief シリアル通信の記録を解析して、イベント一覧(CSV/JSON)と集計を出力するサンプル
+ * @copyright Copyright (c) 2026 CircuitDesign,Inc.
+ * This software is released under the MIT License.
+ * http://opensource.org/licenses/mit-license.php
+ *
+ * @details
+ * MLR_TraceDecoderは、アプリケーションとモデムの間のシリアル通信の記録を、ドライバと同じ受信パーサで解析し、
+ * コマンド、応答、受信データ(*DR)、送信(@DT)、キャリアセンスによる送信失敗、応答時間などのイベントに変換します。
+ * 各イベントはCSVの1行、またはJSONの1行として出力され、最後に集計を表示できます。
+ *
+ * このサンプルプログラムは、まずエミュレータ(MLR_ModemEmulator)とドライバの間に記録用のStream(CaptureTap)を挟み、
+ * 設定、送信(一部はキャリアセンスで失敗)、受信、回線ノイズを含む通信を記録します。
+ * 記録の形式は [タイムスタンプ(4バイト) 方向(1バイト) 長さ(1バイト) データ] の繰り返しです。
+ * 次に記録をCSVで出力し、集計と解析速度を表示します。
+ *
+ * 現場で記録したデータを解析する場合は、同じように方向とタイムスタンプごとに Feed() に渡してください。
+ * タイムスタンプのない受信データだけの記録も、タイムスタンプ 0 で解析できます (応答時間は 0 になります)。
+ */
+#include <MLR_Modem.h>
+#include <MLR_ModemEmulator.h>
+#include <MLR_TraceDecoder.h>
+
+// 記録用バッファのサイズ
+static const uint16_t CAPTURE_LEN = 4096;
+// この時間以上間隔が空いた受信データは別のレコードにする (マイクロ秒)
+static const uint32_t CAPTURE_GAP_US = 1000;
+// 解析速度の測定の繰り返し回数
+static const uint8_t SPEED_REPEAT = 20;
+
+static uint8_t capture[CAPTURE_LEN];
+static uint16_t captureLen;
+static uint16_t lastRecord = 0xFFFF;
+static uint32_t lastRxAt;
+
+// 1チャンクを記録する。受信データは間隔が空くまで1レコードにまとめ、タイムスタンプは最後のバイトの時刻にする
+static void record(MLR_TraceDirection dir, const uint8_t *pData, size_t len)
+{
+    uint32_t now = micros();
+    if (dir == MLR_TraceDirection::Rx && lastRecord != 0xFFFF && capture[lastRecord + 4] == (uint8_t)dir &&
+        capture[lastRecord + 5] < 255 && now - lastRxAt < CAPTURE_GAP_US && captureLen < CAPTURE_LEN)
+    {
+        memcpy(&capture[lastRecord], &now, 4);
+        capture[lastRecord + 5]++;
+        capture[captureLen++] = *pData;
+        lastRxAt = now;
+        return;
+    }
+
+    while (len > 0 && captureLen + 6 < CAPTURE_LEN)
+    {
+        uint8_t n = (len > 255) ? 255 : len;
+        if (captureLen + 6 + n > CAPTURE_LEN)
+        {
+            n = CAPTURE_LEN - captureLen - 6;
+        }
+        lastRecord = captureLen;
+        memcpy(&capture[captureLen], &now, 4);
+        capture[captureLen + 4] = (uint8_t)dir;
+        capture[captureLen + 5] = n;
+        memcpy(&capture[captureLen + 6], pData, n);
+        captureLen += 6 + n;
+        pData += n;
+        len -= n;
+    }
+    lastRxAt = now;
+}
+
+// ドライバとシリアルポートの間で通信を記録するStream
+class CaptureTap : public Stream
+{
+public:
+    explicit CaptureTap(Stream &uart) : m_uart(uart) {}
+
+    int available() override { return m_uart.available(); }
+    int peek() override { return m_uart.peek(); }
+    int read() override
+    {
+        int c = m_uart.read();
+        if (c >= 0)
+        {
+            uint8_t b = c;
+            record(MLR_TraceDirection::Rx, &b, 1);
+        }
+        return c;
+    }
+    size_t write(uint8_t c) override
+    {
+        record(MLR_TraceDirection::Tx, &c, 1);
+        return m_uart.write(c);
+    }
+    size_t write(const uint8_t *pData, size_t len) override
+    {
+        record(MLR_TraceDirection::Tx, pData, len);
+        return m_uart.write(pData, len);
+    }
+    using Print::write;
+
+private:
+    Stream &m_uart;
+};
+
+MLR_ModemEmulator emulator;
+CaptureTap tap(emulator);
+MLR_Modem modem;
+MLR_TraceDecoder decoder;
+
+// 記録をすべてデコーダに渡す
+static void decodeCapture()
+{
+    for (uint16_t pos = 0; pos + 6 <= captureLen;)
+    {
+        uint32_t t;
+        memcpy(&t, &capture[pos], 4);
+        MLR_TraceDirection dir = static_cast<MLR_TraceDirection>(capture[pos + 4]);
+        uint8_t len = capture[pos + 5];
+        decoder.Feed(dir, &capture[pos + 6], len, t);
+        pos += 6 + len;
+    }
+}
+
+// 解析する通信を発生させる
+static void runSession()
+{
+    uint8_t value;
+    uint8_t payload[24];
+    for (uint8_t i = 0; i < sizeof(payload); i++)
+    {
+        payload[i] = i;
+    }
+
+    modem.SetChannel(0x0E, false);
+    modem.GetChannel(&value);
+    modem.SetSpreadFactor(MLR_ModemSpreadFactor::Chips256, true);
+    modem.SetEquipmentID(0x01, false);
+
+    emulator.SetLbtFailRate(30);
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        modem.TransmitData(payload, 8 + i * 4);
+    }
+    emulator.SetLbtFailRate(0);
+
+    // 他のモデムからの受信と回線ノイズ
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        emulator.InjectPacket(payload, 4 + i * 6);
+        if (i == 1)
+        {
+            emulator.InjectRaw(reinterpret_cast<const uint8_t *>("\x00\xFF*Z"), 4);
+        }
+        uint32_t start = millis();
+        while (millis() - start < 50)
+        {
+            modem.Work();
+        }
+    }
+    modem.SendRawCommandAsync("@XX\r\n");
+    uint32_t start = millis();
+    while (millis() - start < 50)
+    {
+        modem.Work();
+    }
+}
+
+void modemCallback(MLR_Modem_Error error, MLR_Modem_Response responseType, int32_t value, const uint8_t *pPayload, uint16_t len)
+{
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    while (!Serial)
+        ;
+
+    emulator.begin();
+    if (modem.begin(tap, modemCallback) != MLR_Modem_Error::Ok)
+    {
+        Serial.println("エミュレータに接続できませんでした。");
+        return;
+    }
+    runSession();
+    Serial.printf("--- 記録 %u バイト ---\n", captureLen);
+
+    // イベント一覧 (CSV)。JSONの場合は MLR_TraceFormat::Json
+    decoder.begin(&Serial, MLR_TraceFormat::Csv);
+    decodeCapture();
+
+    Serial.println("--- 集計 ---");
+    decoder.PrintSummary(Serial);
+
+    // 解析速度 (出力なし)
+    uint32_t t = micros();
+    for (uint8_t i = 0; i < SPEED_REPEAT; i++)
+    {
+        decoder.begin(nullptr);
+        decodeCapture();
+    }
+    uint32_t elapsed = micros() - t;
+    Serial.printf("--- 解析速度: %.0f バイト/秒 ---\n", elapsed ? (float)captureLen * SPEED_REPEAT * 1000000.0f / elapsed : 0.0f);
+}
+
+void loop()
+{
+}
@@ -0,0 +1,111 @@
+/**
+ * @file work_profile.ino
+ * @brief Work() の処理時間を、パーサの状態・応答処理・コールバックごとに測定するサンプル
+ * @copyright Copyright (c) 2026 CircuitDesign,Inc.
+ * This software is released under the MIT License.
+ * http://opensource.org/licenses/mit-license.php
+ *
+ * @details
+ * ENABLE_MLR_MODEM_PROFILE を定義してライブラリをビルドすると、ドライバは次の箇所の処理時間を
+ * 箇所ごとに積算します (MLR_Profile.h 参照)。
+ * - Work() 全体
+ * - パーサの各状態 (Start, ReadCmdParam, RadioDrPayload など) で処理したバイト
+ * - ゴミの破棄、コマンド応答の処理、*DR の処理、受信フック、送信フック
+ * - 非同期コールバック、ストリーミング受信コールバック
+ *
+ * 時間はCortex-M3/M4/M7/M33ではDWTのサイクルカウンタ、LinuxではCLOCK_MONOTONIC(ナノ秒)、
+ * それ以外では micros() で測定します。各箇所の時間は、その中で呼び出した処理の時間を含みます。
+ *
+ * ENABLE_MLR_MODEM_PROFILE はライブラリ全体で同じ値である必要があるため、スケッチの中では定義できません。
+ * MLR_Modem.h の "#define ENABLE_MLR_MODEM_PROFILE" のコメントを外すか、ビルドオプション
+ * (PlatformIOの build_flags = -DENABLE_MLR_MODEM_PROFILE など) で定義してください。
+ *
+ * このサンプルプログラムは、エミュレータ(MLR_ModemEmulator)から *DR を連続で受信させながら、
+ * 非同期のRSSI取得と送信を繰り返し、MEASURE_MS 後に測定結果の表を表示します。
+ */
+#include <MLR_Modem.h>
+#include <MLR_ModemEmulator.h>
+
+// 受信パケットの長さ
+static const uint8_t PAYLOAD_LEN = 32;
+// 受信パケットの間隔
+static const uint32_t FLOOD_INTERVAL_US = 20000;
+// コマンドの実行間隔
+static const uint32_t CMD_INTERVAL_MS = 50;
+// 測定時間
+static const uint32_t MEASURE_MS = 5000;
+
+MLR_ModemEmulator emulator;
+MLR_Modem modem;
+
+static uint32_t g_received;
+static uint32_t g_streamedBytes;
+
+void modemCallback(MLR_Modem_Error error, MLR_Modem_Response responseType, int32_t value, const uint8_t *pPayload, uint16_t len)
+{
+    if (responseType == MLR_Modem_Response::DataReceived && MLR_ModemEmulator::CheckFloodPacket(pPayload, len, nullptr))
+    {
+        g_received++;
+    }
+}
+
+void streamCallback(MLR_ModemStreamEvent event, const uint8_t *pData, uint8_t len)
+{
+    if (event == MLR_ModemStreamEvent::Chunk)
+    {
+        g_streamedBytes += len;
+    }
+}
+
+void setup()
+{
+    Serial.begin(115200);
+    while (!Serial)
+        ;
+
+#ifndef ENABLE_MLR_MODEM_PROFILE
+    Serial.println("ENABLE_MLR_MODEM_PROFILE を定義してライブラリをビルドしてください。");
+#else
+    emulator.begin();
+    if (modem.begin(emulator, modemCallback) != MLR_Modem_Error::Ok ||
+        modem.SetSpreadFactor(MLR_ModemSpreadFactor::Chips128, false) != MLR_Modem_Error::Ok)
+    {
+        Serial.println("エミュレータに接続できませんでした。");
+        return;
+    }
+    modem.SetStreamCallback(streamCallback, 16);
+
+    // 初期設定のコマンドを除いて測定する
+    modem.ResetProfile();
+
+    emulator.StartFlood(PAYLOAD_LEN, FLOOD_INTERVAL_US);
+    uint8_t txPayload[8] = {'p', 'r', 'o', 'f', 'i', 'l', 'e', 0};
+    uint32_t start = millis();
+    uint32_t lastCmd = start;
+    uint8_t step = 0;
+    while (millis() - start < MEASURE_MS)
+    {
+        modem.Work();
+        if (millis() - lastCmd >= CMD_INTERVAL_MS)
+        {
+            // 応答待ちの間は Busy になるので、次の間隔で再実行する
+            lastCmd = millis();
+            MLR_Modem_Error err = (step & 1) ? modem.TransmitDataFireAndForget(txPayload, sizeof(txPayload))
+                                             : modem.GetRssiCurrentChannelAsync();
+            if (err == MLR_Modem_Error::Ok)
+            {
+                step++;
+            }
+        }
+    }
+    emulator.StopFlood();
+
+    Serial.printf("受信 %lu パケット, ストリーミング %lu バイト, コマンド %u 回\n", (unsigned long)g_received,
+                  (unsigned long)g_streamedBytes, step);
+    modem.PrintProfile(Serial);
+#endif
+}
+
+void loop()
+{
+}
@@ -0,0 +1,280 @@
+//
+// MLR_Aead.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// ChaCha20-Poly1305 authenticated encryption (RFC 8439).
+//
+
+#include "MLR_Aead.h"
+#include "MLR_Frame.h"
+#include <string.h>
+
+static inline uint32_t s_Rotl(uint32_t v, uint8_t n)
+{
+    return (v << n) | (v >> (32 - n));
+}
+
+#define MLR_CHACHA_QR(a, b, c, d) \
+    a += b;                       \
+    d = s_Rotl(d ^ a, 16);        \
+    c += d;                       \
+    b = s_Rotl(b ^ c, 12);        \
+    a += b;                       \
+    d = s_Rotl(d ^ a, 8);         \
+    c += d;                       \
+    b = s_Rotl(b ^ c, 7)
+
+//! Internal: Calculates one 64-byte ChaCha20 key stream block
+static void s_ChaChaBlock(const uint8_t *pKey, const uint8_t *pNonce, uint32_t counter, uint8_t *pOut)
+{
+    uint32_t in[16];
+    in[0] = 0x61707865; // "expand 32-byte k"
+    in[1] = 0x3320646e;
+    in[2] = 0x79622d32;
+    in[3] = 0x6b206574;
+    for (uint8_t i = 0; i < 8; ++i)
+    {
+        in[4 + i] = MLR_Frame_GetU32(&pKey[4 * i]);
+    }
+    in[12] = counter;
+    in[13] = MLR_Frame_GetU32(&pNonce[0]);
+    in[14] = MLR_Frame_GetU32(&pNonce[4]);
+    in[15] = MLR_Frame_GetU32(&pNonce[8]);
+
+    uint32_t x[16];
+    memcpy(x, in, sizeof(x));
+    for (uint8_t i = 0; i < 10; ++i)
+    {
+        MLR_CHACHA_QR(x[0], x[4], x[8], x[12]);
+        MLR_CHACHA_QR(x[1], x[5], x[9], x[13]);
+        MLR_CHACHA_QR(x[2], x[6], x[10], x[14]);
+        MLR_CHACHA_QR(x[3], x[7], x[11], x[15]);
+        MLR_CHACHA_QR(x[0], x[5], x[10], x[15]);
+        MLR_CHACHA_QR(x[1], x[6], x[11], x[12]);
+        MLR_CHACHA_QR(x[2], x[7], x[8], x[13]);
+        MLR_CHACHA_QR(x[3], x[4], x[9], x[14]);
+    }
+
+    for (uint8_t i = 0; i < 16; ++i)
+    {
+        MLR_Frame_PutU32(&pOut[4 * i], x[i] + in[i]);
+    }
+}
+
+//! Internal: XORs data with the ChaCha20 key stream, starting at block 1 (block 0 keys Poly1305)
+static void s_ChaChaXor(const uint8_t *pKey, const uint8_t *pNonce, uint8_t *pData, uint8_t len)
+{
+    uint8_t block[64];
+    uint32_t counter = 1;
+    for (uint16_t pos = 0; pos < len; pos += 64)
+    {
+        s_ChaChaBlock(pKey, pNonce, counter++, block);
+        uint16_t n = (len - pos < 64) ? len - pos : 64;
+        for (uint16_t i = 0; i < n; ++i)
+        {
+            pData[pos + i] ^= block[i];
+        }
+    }
+}
+
+//! Internal: Poly1305 state with 26-bit limbs, so that all products fit into 64 bits
+struct MLR_Poly1305
+{
+    uint32_t r[5];
+    uint32_t h[5];
+    uint32_t pad[4];
+};
+
+static void s_PolyInit(MLR_Poly1305 *pState, const uint8_t *pKey)
+{
+    // r is clamped as required by the specification
+    pState->r[0] = (MLR_Frame_GetU32(&pKey[0])) & 0x3ffffff;
+    pState->r[1] = (MLR_Frame_GetU32(&pKey[3]) >> 2) & 0x3ffff03;
+    pState->r[2] = (MLR_Frame_GetU32(&pKey[6]) >> 4) & 0x3ffc0ff;
+    pState->r[3] = (MLR_Frame_GetU32(&pKey[9]) >> 6) & 0x3f03fff;
+    pState->r[4] = (MLR_Frame_GetU32(&pKey[12]) >> 8) & 0x00fffff;
+    for (uint8_t i = 0; i < 5; ++i)
+    {
+        pState->h[i] = 0;
+    }
+    for (uint8_t i = 0; i < 4; ++i)
+    {
+        pState->pad[i] = MLR_Frame_GetU32(&pKey[16 + 4 * i]);
+    }
+}
+
+//! Internal: Adds one 16-byte block (including the 2^128 bit) and multiplies by r
+static void s_PolyBlock(MLR_Poly1305 *pState, const uint8_t *pBlock)
+{
+    const uint32_t *r = pState->r;
+    uint32_t *h = pState->h;
+    uint32_t s1 = r[1] * 5;
+    uint32_t s2 = r[2] * 5;
+    uint32_t s3 = r[3] * 5;
+    uint32_t s4 = r[4] * 5;
+
+    h[0] += (MLR_Frame_GetU32(&pBlock[0])) & 0x3ffffff;
+    h[1] += (MLR_Frame_GetU32(&pBlock[3]) >> 2) & 0x3ffffff;
+    h[2] += (MLR_Frame_GetU32(&pBlock[6]) >> 4) & 0x3ffffff;
+    h[3] += (MLR_Frame_GetU32(&pBlock[9]) >> 6) & 0x3ffffff;
+    h[4] += (MLR_Frame_GetU32(&pBlock[12]) >> 8) | (1UL << 24);
+
+    uint64_t d0 = (uint64_t)h[0] * r[0] + (uint64_t)h[1] * s4 + (uint64_t)h[2] * s3 + (uint64_t)h[3] * s2 + (uint64_t)h[4] * s1;
+    uint64_t d1 = (uint64_t)h[0] * r[1] + (uint64_t)h[1] * r[0] + (uint64_t)h[2] * s4 + (uint64_t)h[3] * s3 + (uint64_t)h[4] * s2;
+    uint64_t d2 = (uint64_t)h[0] * r[2] + (uint64_t)h[1] * r[1] + (uint64_t)h[2] * r[0] + (uint64_t)h[3] * s4 + (uint64_t)h[4] * s3;
+    uint64_t d3 = (uint64_t)h[0] * r[3] + (uint64_t)h[1] * r[2] + (uint64_t)h[2] * r[1] + (uint64_t)h[3] * r[0] + (uint64_t)h[4] * s4;
+    uint64_t d4 = (uint64_t)h[0] * r[4] + (uint64_t)h[1] * r[3] + (uint64_t)h[2] * r[2] + (uint64_t)h[3] * r[1] + (uint64_t)h[4] * r[0];
+
+    uint32_t c;
+    c = (uint32_t)(d0 >> 26);
+    h[0] = (uint32_t)d0 & 0x3ffffff;
+    d1 += c;
+    c = (uint32_t)(d1 >> 26);
+    h[1] = (uint32_t)d1 & 0x3ffffff;
+    d2 += c;
+    c = (uint32_t)(d2 >> 26);
+    h[2] = (uint32_t)d2 & 0x3ffffff;
+    d3 += c;
+    c = (uint32_t)(d3 >> 26);
+    h[3] = (uint32_t)d3 & 0x3ffffff;
+    d4 += c;
+    c = (uint32_t)(d4 >> 26);
+    h[4] = (uint32_t)d4 & 0x3ffffff;
+    h[0] += c * 5;
+    c = h[0] >> 26;
+    h[0] &= 0x3ffffff;
+    h[1] += c;
+}
+
+//! Internal: Authenticates data zero-padded to a multiple of 16 bytes (the AEAD construction pads AAD and ciphertext)
+static void s_PolyPadded(MLR_Poly1305 *pState, const uint8_t *pData, uint8_t len)
+{
+    uint8_t pos = 0;
+    for (; len - pos >= 16; pos += 16)
+    {
+        s_PolyBlock(pState, &pData[pos]);
+    }
+    if (pos < len)
+    {
+        uint8_t block[16] = {};
+        memcpy(block, &pData[pos], len - pos);
+        s_PolyBlock(pState, block);
+    }
+}
+
+//! Internal: Reduces h modulo 2^130 - 5 and adds the pad, giving the 16-byte tag
+static void s_PolyFinish(MLR_Poly1305 *pState, uint8_t *pMac)
+{
+    uint32_t *h = pState->h;
+    uint32_t c;
+
+    c = h[1] >> 26;
+    h[1] &= 0x3ffffff;
+    h[2] += c;
+    c = h[2] >> 26;
+    h[2] &= 0x3ffffff;
+    h[3] += c;
+    c = h[3] >> 26;
+    h[3] &= 0x3ffffff;
+    h[4] += c;
+    c = h[4] >> 26;
+    h[4] &= 0x3ffffff;
+    h[0] += c * 5;
+    c = h[0] >> 26;
+    h[0] &= 0x3ffffff;
+    h[1] += c;
+
+    // g = h + 5 - 2^130, selected without branches if h >= 2^130 - 5
+    uint32_t g[5];
+    g[0] = h[0] + 5;
+    c = g[0] >> 26;
+    g[0] &= 0x3ffffff;
+    g[1] = h[1] + c;
+    c = g[1] >> 26;
+    g[1] &= 0x3ffffff;
+    g[2] = h[2] + c;
+    c = g[2] >> 26;
+    g[2] &= 0x3ffffff;
+    g[3] = h[3] + c;
+    c = g[3] >> 26;
+    g[3] &= 0x3ffffff;
+    g[4] = h[4] + c - (1UL << 26);
+
+    uint32_t mask = (g[4] >> 31) - 1;
+    for (uint8_t i = 0; i < 5; ++i)
+    {
+        h[i] = (h[i] & ~mask) | (g[i] & mask);
+    }
+
+    uint32_t w0 = h[0] | (h[1] << 26);
+    uint32_t w1 = (h[1] >> 6) | (h[2] << 20);
+    uint32_t w2 = (h[2] >> 12) | (h[3] << 14);
+    uint32_t w3 = (h[3] >> 18) | (h[4] << 8);
+
+    uint64_t f;
+    f = (uint64_t)w0 + pState->pad[0];
+    MLR_Frame_PutU32(&pMac[0], (uint32_t)f);
+    f = (uint64_t)w1 + pState->pad[1] + (f >> 32);
+    MLR_Frame_PutU32(&pMac[4], (uint32_t)f);
+    f = (uint64_t)w2 + pState->pad[2] + (f >> 32);
+    MLR_Frame_PutU32(&pMac[8], (uint32_t)f);
+    f = (uint64_t)w3 + pState->pad[3] + (f >> 32);
+    MLR_Frame_PutU32(&pMac[12], (uint32_t)f);
+}
+
+//! Internal: Calculates the full AEAD tag over AAD and ciphertext
+static void s_AeadTag(const uint8_t *pKey, const uint8_t *pNonce, const uint8_t *pAad, uint8_t aadLen,
+                      const uint8_t *pCipher, uint8_t len, uint8_t *pMac)
+{
+    uint8_t block[64];
+    s_ChaChaBlock(pKey, pNonce, 0, block);
+
+    MLR_Poly1305 state;
+    s_PolyInit(&state, block);
+    s_PolyPadded(&state, pAad, aadLen);
+    s_PolyPadded(&state, pCipher, len);
+
+    uint8_t lengths[16] = {};
+    lengths[0] = aadLen;
+    lengths[8] = len;
+    s_PolyBlock(&state, lengths);
+    s_PolyFinish(&state, pMac);
+
+    memset(block, 0, sizeof(block));
+}
+
+void MLR_Aead_Seal(const uint8_t *pKey, const uint8_t *pNonce, const uint8_t *pAad, uint8_t aadLen,
+                   uint8_t *pData, uint8_t len, uint8_t *pTag, uint8_t tagLen)
+{
+    s_ChaChaXor(pKey, pNonce, pData, len);
+
+    uint8_t mac[MLR_AEAD_MAX_TAG_LEN];
+    s_AeadTag(pKey, pNonce, pAad, aadLen, pData, len, mac);
+    memcpy(pTag, mac, (tagLen < MLR_AEAD_MAX_TAG_LEN) ? tagLen : MLR_AEAD_MAX_TAG_LEN);
+}
+
+bool MLR_Aead_Open(const uint8_t *pKey, const uint8_t *pNonce, const uint8_t *pAad, uint8_t aadLen,
+                   uint8_t *pData, uint8_t len, const uint8_t *pTag, uint8_t tagLen)
+{
+    if (tagLen == 0 || tagLen > MLR_AEAD_MAX_TAG_LEN)
+    {
+        return false;
+    }
+
+    uint8_t mac[MLR_AEAD_MAX_TAG_LEN];
+    s_AeadTag(pKey, pNonce, pAad, aadLen, pData, len, mac);
+
+    // constant-time comparison, so the timing does not reveal how many tag bytes matched
+    uint8_t diff = 0;
+    for (uint8_t i = 0; i < tagLen; ++i)
+    {
+        diff |= mac[i] ^ pTag[i];
+    }
+    if (diff != 0)
+    {
+        return false;
+    }
+
+    s_ChaChaXor(pKey, pNonce, pData, len);
+    return true;
+}
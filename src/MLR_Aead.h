@@ -0,0 +1,55 @@
+//
+// MLR_Aead.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// ChaCha20-Poly1305 authenticated encryption (RFC 8439) for radio payloads.
+// The implementation has no tables and works on 32-bit words only, so it is small and
+// runs in constant time on 8-bit and 32-bit MCUs alike. Data is encrypted in place and the
+// tag may be truncated to save airtime.
+
+#pragma once
+#include <stdint.h>
+
+/**
+ * @brief Length of a key in bytes.
+ */
+static constexpr uint8_t MLR_AEAD_KEY_LEN = 32;
+
+/**
+ * @brief Length of a nonce in bytes.
+ */
+static constexpr uint8_t MLR_AEAD_NONCE_LEN = 12;
+
+/**
+ * @brief Maximum length of an authentication tag in bytes.
+ */
+static constexpr uint8_t MLR_AEAD_MAX_TAG_LEN = 16;
+
+/**
+ * \brief Encrypts data in place and calculates the authentication tag.
+ * \param pKey The key (MLR_AEAD_KEY_LEN bytes).
+ * \param pNonce The nonce (MLR_AEAD_NONCE_LEN bytes). A nonce must never be used twice with the same key.
+ * \param pAad Additional data that is authenticated but not encrypted (e.g. a frame header), may be nullptr if aadLen is 0.
+ * \param aadLen Length of the additional data.
+ * \param pData The plaintext, replaced by the ciphertext.
+ * \param len Length of the data.
+ * \param pTag Buffer for the tag.
+ * \param tagLen Length of the tag (1-MLR_AEAD_MAX_TAG_LEN), the full tag is truncated to this length.
+ */
+void MLR_Aead_Seal(const uint8_t *pKey, const uint8_t *pNonce, const uint8_t *pAad, uint8_t aadLen,
+                   uint8_t *pData, uint8_t len, uint8_t *pTag, uint8_t tagLen);
+
+/**
+ * \brief Verifies the authentication tag and decrypts data in place.
+ * \param pKey The key (MLR_AEAD_KEY_LEN bytes).
+ * \param pNonce The nonce used for encryption.
+ * \param pAad Additional data, may be nullptr if aadLen is 0.
+ * \param aadLen Length of the additional data.
+ * \param pData The ciphertext, replaced by the plaintext if the tag is valid.
+ * \param len Length of the data.
+ * \param pTag The received tag.
+ * \param tagLen Length of the tag.
+ * \return true if the tag is valid. The data is left unchanged otherwise.
+ */
+bool MLR_Aead_Open(const uint8_t *pKey, const uint8_t *pNonce, const uint8_t *pAad, uint8_t aadLen,
+                   uint8_t *pData, uint8_t len, const uint8_t *pTag, uint8_t tagLen);
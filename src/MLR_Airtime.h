@@ -0,0 +1,65 @@
+//
+// MLR_Airtime.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Time-on-air estimates for radio packets, used for duty-cycle budgets and capacity planning.
+// The LoRa formula follows Semtech AN1200.13. Bandwidth and coding rate are not configured
+// through the command interface, so they have to be taken from the modem's data sheet.
+
+#pragma once
+#include "MLR_Modem.h"
+
+/**
+ * \brief Converts the modem's spreading factor setting to the LoRa spreading factor (7-12).
+ */
+constexpr uint8_t MLR_Airtime_SpreadFactor(MLR_ModemSpreadFactor sf)
+{
+    return static_cast<uint8_t>(sf) + 7;
+}
+
+/**
+ * \brief Calculates the time on air of a LoRa packet.
+ * \param payloadLen Number of payload bytes on air.
+ * \param sf LoRa spreading factor (7-12).
+ * \param bwHz Bandwidth in Hz.
+ * \param codingRate Coding rate 1-4 (4/5 to 4/8).
+ * \param preambleLen Number of preamble symbols.
+ * \param explicitHeader true if the packet carries a LoRa header.
+ * \param crc true if the packet carries a payload CRC.
+ * \return Time on air in microseconds.
+ */
+inline uint32_t MLR_Airtime_LoRaUs(uint8_t payloadLen, uint8_t sf, uint32_t bwHz, uint8_t codingRate = 1,
+                                   uint16_t preambleLen = 8, bool explicitHeader = true, bool crc = true)
+{
+    // symbol time in 1/4 us, so that the 4.25 symbols of the preamble stay exact
+    uint64_t symQuarterUs = (4000000ULL << sf) / bwHz;
+    bool lowDataRateOpt = (symQuarterUs >= 4 * 16000); // mandated for symbols of 16 ms and longer
+
+    int32_t num = 8 * payloadLen - 4 * sf + 28 + (crc ? 16 : 0) - (explicitHeader ? 0 : 20);
+    int32_t den = 4 * (sf - (lowDataRateOpt ? 2 : 0));
+    int32_t payloadSymbols = 8;
+    if (num > 0)
+    {
+        payloadSymbols += ((num + den - 1) / den) * (codingRate + 4);
+    }
+
+    uint64_t quarterSymbols = 4ULL * (preambleLen + payloadSymbols) + 17; // + 4.25 symbols of the sync word
+    return static_cast<uint32_t>((quarterSymbols * symQuarterUs + 8) / 16);
+}
+
+/**
+ * @brief FSK bit rate assumed when none is configured, in bit/s. Take the actual value from the data sheet.
+ */
+static constexpr uint32_t MLR_AIRTIME_FSK_BITRATE = 4800;
+
+/**
+ * \brief Calculates the time on air of an FSK packet.
+ * \param payloadLen Number of payload bytes on air.
+ * \param bitrate Bit rate in bit/s.
+ * \param overheadLen Number of bytes added by the radio (preamble, sync word, length, CRC).
+ * \return Time on air in microseconds.
+ */
+inline uint32_t MLR_Airtime_FskUs(uint8_t payloadLen, uint32_t bitrate, uint8_t overheadLen = 12)
+{
+    return static_cast<uint32_t>((8000000ULL * (payloadLen + overheadLen) + bitrate - 1) / bitrate);
+}
@@ -0,0 +1,324 @@
+//
+// MLR_CapacityPlanner.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Capacity planning for a LoRa network.
+//
+
+#include "MLR_CapacityPlanner.h"
+#include "MLR_Airtime.h"
+#include <math.h>
+
+//! Iterations of the carrier sense fixed point, converges long before for loads below 1 Erlang
+static constexpr uint8_t MLR_PLANNER_ITERATIONS = 50;
+
+//! Whether two nodes cannot hear each other; fixed per pair, so the simulation is repeatable
+static bool s_IsHidden(uint16_t a, uint16_t b, uint8_t hiddenPercent)
+{
+    if (hiddenPercent == 0)
+    {
+        return false;
+    }
+    uint32_t h = (a < b) ? (static_cast<uint32_t>(a) << 16 | b) : (static_cast<uint32_t>(b) << 16 | a);
+    h *= 2654435761UL; // Knuth's multiplicative hash
+    return ((h >> 16) % 100) < hiddenPercent;
+}
+
+void MLR_CapacityPlanner::begin(uint32_t bwHz, uint8_t codingRate)
+{
+    m_bwHz = bwHz;
+    m_codingRate = codingRate;
+    m_classCount = 0;
+}
+
+void MLR_CapacityPlanner::SetCarrierSense(uint32_t windowUs, uint8_t hiddenPercent)
+{
+    m_csWindowUs = windowUs;
+    m_hiddenPercent = (hiddenPercent > 100) ? 100 : hiddenPercent;
+}
+
+MLR_Modem_Error MLR_CapacityPlanner::AddClass(const MLR_TrafficClass &trafficClass)
+{
+    if (trafficClass.nodes == 0 || trafficClass.periodMs == 0 || trafficClass.payloadLen > MLR_MAX_PAYLOAD_LEN)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+    if (m_classCount >= MLR_PLANNER_MAX_CLASSES)
+    {
+        return MLR_Modem_Error::BufferTooSmall;
+    }
+    m_classes[m_classCount++] = trafficClass;
+    return MLR_Modem_Error::Ok;
+}
+
+float MLR_CapacityPlanner::GetChannelLoad(uint8_t channel) const
+{
+    float load = 0.0f;
+    for (uint8_t i = 0; i < m_classCount; ++i)
+    {
+        const MLR_TrafficClass &c = m_classes[i];
+        if (c.channel == channel)
+        {
+            load += c.nodes * (m_AirtimeUs(c) / (c.periodMs * 1000.0f));
+        }
+    }
+    return load;
+}
+
+void MLR_CapacityPlanner::Estimate(MLR_ClassEstimate *pEstimates) const
+{
+    float hidden = m_hiddenPercent / 100.0f;
+    float duty[MLR_PLANNER_MAX_CLASSES];
+    float lbt[MLR_PLANNER_MAX_CLASSES];
+    for (uint8_t i = 0; i < m_classCount; ++i)
+    {
+        pEstimates[i].airtimeUs = m_AirtimeUs(m_classes[i]);
+        duty[i] = pEstimates[i].airtimeUs / (m_classes[i].periodMs * 1000.0f);
+        lbt[i] = 0.0f;
+    }
+
+    // rejected messages are not transmitted, so the load seen by carrier sense depends on the failure rates
+    for (uint8_t iter = 0; iter < MLR_PLANNER_ITERATIONS; ++iter)
+    {
+        for (uint8_t i = 0; i < m_classCount; ++i)
+        {
+            float others = 0.0f;
+            for (uint8_t k = 0; k < m_classCount; ++k)
+            {
+                if (m_classes[k].channel == m_classes[i].channel)
+                {
+                    uint16_t nodes = m_classes[k].nodes - ((k == i) ? 1 : 0);
+                    others += nodes * duty[k] * (1.0f - lbt[k]);
+                }
+            }
+            lbt[i] = 1.0f - expf(-(1.0f - hidden) * others);
+        }
+    }
+
+    for (uint8_t i = 0; i < m_classCount; ++i)
+    {
+        const MLR_TrafficClass &c = m_classes[i];
+        float airtimeUs = static_cast<float>(pEstimates[i].airtimeUs);
+
+        // expected number of transmissions overlapping one message
+        float overlaps = 0.0f;
+        for (uint8_t k = 0; k < m_classCount; ++k)
+        {
+            const MLR_TrafficClass &o = m_classes[k];
+            if (o.channel != c.channel || o.sf != c.sf)
+            {
+                continue;
+            }
+            uint16_t nodes = o.nodes - ((k == i) ? 1 : 0);
+            float ratePerUs = nodes * (1.0f - lbt[k]) / (o.periodMs * 1000.0f);
+            overlaps += (1.0f - hidden) * ratePerUs * 2.0f * m_csWindowUs;             // started undetected
+            overlaps += hidden * ratePerUs * (airtimeUs + pEstimates[k].airtimeUs); // hidden nodes: pure ALOHA
+        }
+
+        pEstimates[i].dutyCycle = duty[i];
+        pEstimates[i].lbtFailRate = lbt[i];
+        pEstimates[i].collisionRate = 1.0f - expf(-overlaps);
+        pEstimates[i].deliveryRate = (1.0f - lbt[i]) * (1.0f - pEstimates[i].collisionRate);
+    }
+}
+
+MLR_Modem_Error MLR_CapacityPlanner::Simulate(uint32_t durationS, MLR_ClassEstimate *pResults, uint32_t seed)
+{
+    if (durationS == 0)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    uint16_t nodeCount = 0;
+    for (uint8_t i = 0; i < m_classCount; ++i)
+    {
+        if (nodeCount + m_classes[i].nodes > MLR_PLANNER_MAX_NODES)
+        {
+            return MLR_Modem_Error::BufferTooSmall;
+        }
+        nodeCount += m_classes[i].nodes;
+    }
+    if (nodeCount == 0)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    m_random = seed ? seed : 1;
+    uint32_t airtimeUs[MLR_PLANNER_MAX_CLASSES];
+    uint32_t messages[MLR_PLANNER_MAX_CLASSES] = {};
+    uint32_t lbtFails[MLR_PLANNER_MAX_CLASSES] = {};
+    uint32_t sent[MLR_PLANNER_MAX_CLASSES] = {};
+    uint32_t collided[MLR_PLANNER_MAX_CLASSES] = {};
+
+    uint16_t n = 0;
+    for (uint8_t i = 0; i < m_classCount; ++i)
+    {
+        airtimeUs[i] = m_AirtimeUs(m_classes[i]);
+        for (uint16_t k = 0; k < m_classes[i].nodes; ++k, ++n)
+        {
+            Node &node = m_nodes[n];
+            node.nextUs = static_cast<uint64_t>(-logf(m_Random()) * m_classes[i].periodMs * 1000.0f);
+            node.startUs = 0;
+            node.endUs = 0;
+            node.classIdx = i;
+            node.collided = false;
+        }
+    }
+
+    uint64_t durationUs = durationS * 1000000ULL;
+    while (true)
+    {
+        // next message of all nodes
+        uint16_t next = 0;
+        for (uint16_t i = 1; i < nodeCount; ++i)
+        {
+            if (m_nodes[i].nextUs < m_nodes[next].nextUs)
+            {
+                next = i;
+            }
+        }
+        Node &node = m_nodes[next];
+        uint64_t now = node.nextUs;
+        if (now >= durationUs)
+        {
+            break;
+        }
+        const MLR_TrafficClass &c = m_classes[node.classIdx];
+        node.nextUs = now + static_cast<uint64_t>(-logf(m_Random()) * c.periodMs * 1000.0f);
+        ++messages[node.classIdx];
+
+        if (node.endUs > now)
+        {
+            ++lbtFails[node.classIdx]; // still transmitting the previous message
+            continue;
+        }
+        if (node.endUs != 0 && node.collided)
+        {
+            ++collided[node.classIdx]; // outcome of the previous transmission is final
+        }
+        node.endUs = 0;
+
+        // carrier sense detects audible transmissions that started at least one window ago
+        bool busy = false;
+        for (uint16_t i = 0; i < nodeCount && !busy; ++i)
+        {
+            const Node &other = m_nodes[i];
+            busy = (i != next && other.endUs > now && m_classes[other.classIdx].channel == c.channel &&
+                    other.startUs + m_csWindowUs <= now && !s_IsHidden(next, i, m_hiddenPercent));
+        }
+        if (busy)
+        {
+            ++lbtFails[node.classIdx];
+            continue;
+        }
+
+        node.startUs = now;
+        node.endUs = now + airtimeUs[node.classIdx];
+        node.collided = false;
+        ++sent[node.classIdx];
+        for (uint16_t i = 0; i < nodeCount; ++i)
+        {
+            Node &other = m_nodes[i];
+            if (i != next && other.endUs > now && m_classes[other.classIdx].channel == c.channel &&
+                m_classes[other.classIdx].sf == c.sf)
+            {
+                other.collided = true;
+                node.collided = true;
+            }
+        }
+    }
+
+    // transmissions still on air at the end are counted as well
+    for (uint16_t i = 0; i < nodeCount; ++i)
+    {
+        if (m_nodes[i].endUs != 0 && m_nodes[i].collided)
+        {
+            ++collided[m_nodes[i].classIdx];
+        }
+    }
+
+    for (uint8_t i = 0; i < m_classCount; ++i)
+    {
+        MLR_ClassEstimate &r = pResults[i];
+        r.airtimeUs = airtimeUs[i];
+        r.dutyCycle = airtimeUs[i] * static_cast<float>(sent[i]) / (m_classes[i].nodes * static_cast<float>(durationUs));
+        r.lbtFailRate = messages[i] ? static_cast<float>(lbtFails[i]) / messages[i] : 0.0f;
+        r.collisionRate = sent[i] ? static_cast<float>(collided[i]) / sent[i] : 0.0f;
+        r.deliveryRate = messages[i] ? static_cast<float>(sent[i] - collided[i]) / messages[i] : 0.0f;
+    }
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_CapacityPlanner::PrintReport(Print &out, uint32_t simulateS)
+{
+    MLR_ClassEstimate estimates[MLR_PLANNER_MAX_CLASSES];
+    MLR_ClassEstimate simulated[MLR_PLANNER_MAX_CLASSES];
+    Estimate(estimates);
+    bool haveSimulation = (simulateS > 0 && Simulate(simulateS, simulated) == MLR_Modem_Error::Ok);
+
+    for (uint8_t i = 0; i < m_classCount; ++i)
+    {
+        bool first = true;
+        for (uint8_t k = 0; k < i && first; ++k)
+        {
+            first = (m_classes[k].channel != m_classes[i].channel);
+        }
+        if (first)
+        {
+            out.print("channel ");
+            out.print(m_classes[i].channel);
+            out.print(": load ");
+            out.print(GetChannelLoad(m_classes[i].channel), 4);
+            out.println(" Erlang");
+        }
+    }
+
+    for (uint8_t i = 0; i < m_classCount; ++i)
+    {
+        const MLR_TrafficClass &c = m_classes[i];
+        out.print("class ");
+        out.print(i);
+        out.print(": ");
+        out.print(c.nodes);
+        out.print(" nodes, ");
+        out.print(c.payloadLen);
+        out.print(" bytes every ");
+        out.print(c.periodMs);
+        out.print(" ms, SF");
+        out.print(MLR_Airtime_SpreadFactor(c.sf));
+        out.print(", channel ");
+        out.println(c.channel);
+
+        out.print("  airtime ");
+        out.print(estimates[i].airtimeUs / 1000.0f, 1);
+        out.print(" ms, duty cycle ");
+        out.print(estimates[i].dutyCycle * 100.0f, 3);
+        out.println(" %");
+
+        for (uint8_t pass = 0; pass < (haveSimulation ? 2 : 1); ++pass)
+        {
+            const MLR_ClassEstimate &e = pass ? simulated[i] : estimates[i];
+            out.print(pass ? "  simulation: LBT fail " : "  estimate:   LBT fail ");
+            out.print(e.lbtFailRate * 100.0f, 2);
+            out.print(" %, collision ");
+            out.print(e.collisionRate * 100.0f, 2);
+            out.print(" %, delivered ");
+            out.print(e.deliveryRate * 100.0f, 2);
+            out.println(" %");
+        }
+    }
+}
+
+float MLR_CapacityPlanner::m_Random()
+{
+    // xorshift32
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 17;
+    m_random ^= m_random << 5;
+    return (m_random >> 8) * (1.0f / 16777216.0f) + (1.0f / 16777216.0f);
+}
+
+uint32_t MLR_CapacityPlanner::m_AirtimeUs(const MLR_TrafficClass &trafficClass) const
+{
+    return MLR_Airtime_LoRaUs(trafficClass.payloadLen, MLR_Airtime_SpreadFactor(trafficClass.sf), m_bwHz, m_codingRate);
+}
@@ -0,0 +1,160 @@
+//
+// MLR_CapacityPlanner.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Capacity planning for a LoRa network before nodes are added.
+// The traffic model is a list of node classes (number of nodes, payload length, message period, spread
+// factor, channel). Messages are assumed to start at random times (Poisson arrivals). For every class the
+// planner computes the time on air with the driver's airtime model (MLR_Airtime.h), the duty cycle, and
+// the expected rates of carrier sense (LBT) failures, collisions and delivered messages:
+//   - Carrier sense rejects a message if the channel is busy. Every transmission on the channel counts,
+//     regardless of its spread factor. The channel is busy with probability 1 - exp(-S), where S is the
+//     load actually transmitted by the other nodes (in Erlang, solved by iteration since rejected
+//     messages are not transmitted).
+//   - Two transmissions on the same channel and spread factor collide if the second one starts before
+//     carrier sense can detect the first (within the carrier sense window), or if the nodes cannot hear
+//     each other (hidden nodes, which behave like pure ALOHA with a vulnerable period of two packets).
+//     Different spread factors are treated as orthogonal.
+// Simulate() checks the estimate with a Monte Carlo simulation of the same traffic, which also captures
+// effects the formulas leave out (e.g. a node whose previous message is still on air).
+
+#pragma once
+#include "MLR_Modem.h"
+
+#ifndef MLR_PLANNER_MAX_CLASSES
+/**
+ * @brief Maximum number of node classes in a traffic model.
+ */
+#define MLR_PLANNER_MAX_CLASSES 8
+#endif
+
+#ifndef MLR_PLANNER_MAX_NODES
+/**
+ * @brief Maximum total number of nodes in a simulation.
+ */
+#define MLR_PLANNER_MAX_NODES 256
+#endif
+
+/**
+ * @brief Default time carrier sense needs to detect a transmission in microseconds.
+ */
+static constexpr uint32_t MLR_PLANNER_DEFAULT_CS_WINDOW_US = 5000;
+
+/**
+ * \brief A group of nodes with the same traffic.
+ */
+struct MLR_TrafficClass
+{
+    uint16_t nodes;               //!< Number of nodes
+    uint8_t payloadLen;           //!< Bytes per message on air
+    uint32_t periodMs;            //!< Mean time between two messages of one node
+    MLR_ModemSpreadFactor sf;     //!< Spread factor
+    uint8_t channel;              //!< Channel
+};
+
+/**
+ * \brief Expected performance of a node class.
+ */
+struct MLR_ClassEstimate
+{
+    uint32_t airtimeUs;           //!< Time on air of one message
+    float dutyCycle;              //!< Fraction of the time one node transmits
+    float lbtFailRate;            //!< Fraction of the messages rejected by carrier sense
+    float collisionRate;          //!< Fraction of the transmitted messages lost to collisions
+    float deliveryRate;           //!< Fraction of the messages delivered
+};
+
+/**
+ * \brief Channel utilization and collision estimates for a traffic model.
+ */
+class MLR_CapacityPlanner
+{
+public:
+    /**
+     * \brief Starts a new traffic model.
+     * \param bwHz LoRa bandwidth in Hz, see the modem's data sheet.
+     * \param codingRate LoRa coding rate 1-4 (4/5 to 4/8).
+     */
+    void begin(uint32_t bwHz = 125000, uint8_t codingRate = 1);
+
+    /**
+     * \brief Sets the carrier sense parameters.
+     * \param windowUs Time carrier sense needs to detect a transmission. Transmissions starting within this
+     *                 time of each other collide.
+     * \param hiddenPercent Percentage of node pairs on a channel that cannot hear each other.
+     */
+    void SetCarrierSense(uint32_t windowUs, uint8_t hiddenPercent = 0);
+
+    /**
+     * \brief Adds a node class to the traffic model.
+     * \param trafficClass The node class.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::InvalidArg if the class has no nodes,
+     *         a period of 0 or a payload longer than MLR_MAX_PAYLOAD_LEN,
+     *         MLR_Modem_Error::BufferTooSmall if MLR_PLANNER_MAX_CLASSES classes were already added.
+     */
+    MLR_Modem_Error AddClass(const MLR_TrafficClass &trafficClass);
+
+    /**
+     * \brief Gets the number of node classes.
+     */
+    uint8_t GetClassCount() const { return m_classCount; }
+
+    /**
+     * \brief Gets the offered load of a channel: the sum of the duty cycles of all its nodes.
+     * \param channel The channel.
+     * \return The load in Erlang (1.0 = channel busy all the time).
+     */
+    float GetChannelLoad(uint8_t channel) const;
+
+    /**
+     * \brief Computes the expected performance of every node class.
+     * \param pEstimates Array of GetClassCount() entries, in the order the classes were added.
+     */
+    void Estimate(MLR_ClassEstimate *pEstimates) const;
+
+    /**
+     * \brief Simulates the traffic model.
+     * \param durationS Simulated time in seconds.
+     * \param pResults Array of GetClassCount() entries, in the order the classes were added.
+     * \param seed Seed of the random number generator; the same seed gives the same result.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::BufferTooSmall if the model has more than
+     *         MLR_PLANNER_MAX_NODES nodes, MLR_Modem_Error::InvalidArg if the duration is 0
+     *         or the model has no nodes.
+     * \note A message that arrives while the previous message of the same node is still on air counts
+     *       as a carrier sense failure, like the modem rejecting it.
+     */
+    MLR_Modem_Error Simulate(uint32_t durationS, MLR_ClassEstimate *pResults, uint32_t seed = 1);
+
+    /**
+     * \brief Writes the channel loads and the estimate of every class as a table.
+     * \param out Output for the report, e.g. Serial.
+     * \param simulateS Simulated time in seconds for a comparison with the simulation, or 0 to skip it.
+     */
+    void PrintReport(Print &out, uint32_t simulateS = 0);
+
+private:
+    //! Internal: Uniform random number in (0, 1]
+    float m_Random();
+
+    //! Internal: Returns the time on air of a class
+    uint32_t m_AirtimeUs(const MLR_TrafficClass &trafficClass) const;
+
+    //! Internal: State of a node in the simulation
+    struct Node
+    {
+        uint64_t nextUs;          //!< Time of the next message
+        uint64_t startUs;         //!< Start of the current transmission
+        uint64_t endUs;           //!< End of the current transmission, 0 if not on air
+        uint8_t classIdx;         //!< Traffic class
+        bool collided;            //!< The current transmission overlaps another one
+    };
+
+    uint32_t m_bwHz = 125000;                                 //!< LoRa bandwidth
+    uint8_t m_codingRate = 1;                                 //!< LoRa coding rate
+    uint32_t m_csWindowUs = MLR_PLANNER_DEFAULT_CS_WINDOW_US; //!< Carrier sense detection time
+    uint8_t m_hiddenPercent = 0;                              //!< Node pairs that cannot hear each other
+    uint8_t m_classCount = 0;                                 //!< Number of classes
+    MLR_TrafficClass m_classes[MLR_PLANNER_MAX_CLASSES];      //!< Traffic model
+    uint32_t m_random = 1;                                    //!< State of the random number generator
+    Node m_nodes[MLR_PLANNER_MAX_NODES];                      //!< Simulation state
+};
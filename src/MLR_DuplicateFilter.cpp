@@ -0,0 +1,124 @@
+//
+// MLR_DuplicateFilter.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Drops received packets that were already received.
+//
+
+#include "MLR_DuplicateFilter.h"
+#include <string.h>
+
+// number of sequence numbers behind the highest one that are tracked per source
+static constexpr uint8_t MLR_DUPFILTER_SEQ_WINDOW = 32;
+
+MLR_Modem_Error MLR_DuplicateFilter::begin(MLR_Modem &modem, uint32_t windowMs)
+{
+    m_pModem = &modem;
+    m_windowMs = windowMs;
+    Clear();
+    modem.AddRxHook(this, true);
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_DuplicateFilter::end()
+{
+    if (m_pModem)
+    {
+        m_pModem->RemoveRxHook(this);
+        m_pModem = nullptr;
+    }
+}
+
+void MLR_DuplicateFilter::Clear()
+{
+    m_sources.Clear();
+    memset(m_hashes, 0, sizeof(m_hashes));
+}
+
+MLR_ModemRxAction MLR_DuplicateFilter::OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi)
+{
+    (void)rssi;
+
+    uint32_t now = millis();
+    MLR_FrameHeader header;
+    bool duplicate;
+    if (MLR_Frame_ParseHeader(pPayload, *pLen, &header))
+    {
+        duplicate = m_CheckSequence(header.src, header.seq, now);
+    }
+    else if (m_hashing)
+    {
+        duplicate = m_CheckHash(pPayload, *pLen, now);
+    }
+    else
+    {
+        return MLR_ModemRxAction::Pass;
+    }
+
+    if (duplicate)
+    {
+        ++m_duplicateCount;
+        return MLR_ModemRxAction::Drop;
+    }
+    return MLR_ModemRxAction::Pass;
+}
+
+bool MLR_DuplicateFilter::m_CheckSequence(uint8_t src, uint8_t seq, uint32_t now)
+{
+    bool created = false;
+    Source &source = *m_sources.Insert(src, &created);
+
+    // a source silent for the window may have restarted
+    if (created || now - source.lastSeen > m_windowMs)
+    {
+        source.lastSeq = seq;
+        source.seen = 1;
+        source.lastSeen = now;
+        return false;
+    }
+
+    source.lastSeen = now;
+    int8_t diff = static_cast<int8_t>(seq - source.lastSeq);
+    if (diff > 0)
+    {
+        source.seen = (diff >= MLR_DUPFILTER_SEQ_WINDOW) ? 1 : (source.seen << diff) | 1;
+        source.lastSeq = seq;
+        return false;
+    }
+
+    uint8_t age = static_cast<uint8_t>(-diff);
+    if (age >= MLR_DUPFILTER_SEQ_WINDOW)
+    {
+        // far behind the window: the sender restarted its sequence
+        source.lastSeq = seq;
+        source.seen = 1;
+        return false;
+    }
+
+    uint32_t bit = 1UL << age;
+    if (source.seen & bit)
+    {
+        return true;
+    }
+    source.seen |= bit; // late, reordered frame
+    return false;
+}
+
+bool MLR_DuplicateFilter::m_CheckHash(const uint8_t *pPayload, uint8_t len, uint32_t now)
+{
+    uint32_t hash = 2166136261u;
+    for (uint8_t i = 0; i < len; ++i)
+    {
+        hash = (hash ^ pPayload[i]) * 16777619u;
+    }
+    if (hash == 0)
+    {
+        hash = 1; // 0 marks an empty slot
+    }
+
+    Hash &entry = m_hashes[hash % MLR_DUPFILTER_HASHES];
+    bool duplicate = (entry.hash == hash && now - entry.time <= m_windowMs);
+    entry.hash = hash;
+    entry.time = now;
+    return duplicate;
+}
@@ -0,0 +1,104 @@
+//
+// MLR_DuplicateFilter.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Drops received packets that were already received (LBT retries, ARQ retransmissions).
+// Framed packets (see MLR_Frame.h) are identified by source ID and sequence number. Unframed
+// packets can optionally be identified by a hash of their payload. Memory is fixed: sources
+// are kept in a small table that evicts the least recently heard source, hashes in a
+// direct-mapped table.
+
+#pragma once
+#include "MLR_Modem.h"
+#include "MLR_PeerTable.h"
+
+#ifndef MLR_DUPFILTER_SOURCES
+/**
+ * @brief Number of sources tracked at the same time. The least recently heard source is evicted when full.
+ */
+#define MLR_DUPFILTER_SOURCES 16
+#endif
+
+#ifndef MLR_DUPFILTER_HASHES
+/**
+ * @brief Number of payload hashes of unframed packets kept.
+ */
+#define MLR_DUPFILTER_HASHES 32
+#endif
+
+/**
+ * @brief Default time after which a source or payload is forgotten in milliseconds.
+ */
+static constexpr uint32_t MLR_DUPFILTER_WINDOW_MS = 30000;
+
+/**
+ * \brief Duplicate detection for received packets.
+ */
+class MLR_DuplicateFilter : public MLR_ModemRxHook
+{
+public:
+    /**
+     * \brief Registers the filter with the driver.
+     * \param modem The initialized modem driver.
+     * \param windowMs Time after which a source or payload is forgotten in milliseconds.
+     * \return MLR_Modem_Error::Ok on success.
+     * \note The filter is inserted in front of the registered hooks, so that no other module sees duplicates.
+     */
+    MLR_Modem_Error begin(MLR_Modem &modem, uint32_t windowMs = MLR_DUPFILTER_WINDOW_MS);
+
+    /**
+     * \brief Unregisters the filter from the driver.
+     */
+    void end();
+
+    /**
+     * \brief Enables duplicate detection by payload hash for packets without frame header. Disabled by default.
+     * \param enable true to drop an unframed packet whose payload was already received within the window.
+     * \note Only enable this if identical payloads never repeat legitimately: a periodic reading that does not
+     *       change is dropped as well. Use framed packets to detect duplicates reliably.
+     */
+    void SetPayloadHashing(bool enable) { m_hashing = enable; }
+
+    /**
+     * \brief Forgets all sources and payloads.
+     */
+    void Clear();
+
+    /**
+     * \brief Gets the number of dropped duplicates.
+     */
+    uint32_t GetDuplicateCount() const { return m_duplicateCount; }
+
+    //! Receive hook: drops duplicates
+    MLR_ModemRxAction OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi) override;
+
+private:
+    //! Sequence window of one source
+    struct Source
+    {
+        uint8_t id;        //!< Equipment ID of the source
+        uint8_t lastSeq;   //!< Highest sequence number received
+        uint32_t seen;     //!< Bit n: lastSeq - n was received
+        uint32_t lastSeen; //!< millis() timestamp of the last frame
+    };
+
+    //! Payload hash of an unframed packet
+    struct Hash
+    {
+        uint32_t hash;     //!< FNV-1a hash of the payload, 0 = empty slot
+        uint32_t time;     //!< millis() timestamp of the reception
+    };
+
+    //! Internal: Checks and records a framed packet, returns true if it is a duplicate
+    bool m_CheckSequence(uint8_t src, uint8_t seq, uint32_t now);
+
+    //! Internal: Checks and records an unframed packet, returns true if it is a duplicate
+    bool m_CheckHash(const uint8_t *pPayload, uint8_t len, uint32_t now);
+
+    MLR_Modem *m_pModem = nullptr;                   //!< Driver the filter is registered with
+    uint32_t m_windowMs = MLR_DUPFILTER_WINDOW_MS;   //!< Time after which entries are forgotten
+    bool m_hashing = false;                          //!< Check unframed packets by hash
+    uint32_t m_duplicateCount = 0;                   //!< Dropped duplicates
+    MLR_PeerTable<Source, MLR_DUPFILTER_SOURCES> m_sources; //!< Sequence windows
+    Hash m_hashes[MLR_DUPFILTER_HASHES] = {};        //!< Direct-mapped payload hashes
+};
@@ -0,0 +1,642 @@
+//
+// MLR_FileTransfer.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Reliable multicast distribution of a blob to a group of modems.
+//
+// Frame bodies following the frame header (all values little-endian):
+//   FileData: session(1) index(2) count(2) fragLen(1) data(...)
+//   FilePoll: session(1) count(2) fragLen(1) size(4) window_ms(4)
+//   FileNack: session(1) base(2) bitmap(...)   bit i set = fragment base + i is missing
+//   FileParity: session(1) first(2) groupSize(1) lastLen(1) fragLen(1) parity(fragLen)
+//     parity = XOR of fragments first .. first + groupSize - 1, each zero-padded to fragLen;
+//     lastLen = length of the last fragment of the blob
+//
+
+#include "MLR_FileTransfer.h"
+#include <string.h>
+
+static constexpr uint8_t MLR_FILE_POLL_LEN = 12;
+static constexpr uint8_t MLR_FILE_PARITY_HEADER_LEN = 6;
+static constexpr uint8_t MLR_FILE_NACK_HEADER_LEN = 3;
+static constexpr uint8_t MLR_FILE_NACK_MAX_BITMAP_LEN = MLR_FRAME_MAX_PAYLOAD_LEN - MLR_FILE_NACK_HEADER_LEN;
+
+// polls in a row without a NACK before the sender considers the transfer done;
+// more than one, because a poll itself might not reach every receiver
+static constexpr uint8_t MLR_FILE_QUIET_POLLS = 2;
+
+static inline bool s_TestBit(const uint8_t *pBitmap, uint16_t idx)
+{
+    return (pBitmap[idx >> 3] & (1 << (idx & 7))) != 0;
+}
+
+static inline void s_SetBit(uint8_t *pBitmap, uint16_t idx)
+{
+    pBitmap[idx >> 3] |= (1 << (idx & 7));
+}
+
+static inline void s_ClearBit(uint8_t *pBitmap, uint16_t idx)
+{
+    pBitmap[idx >> 3] &= ~(1 << (idx & 7));
+}
+
+// ----------------------------------------------------------------------------
+// MLR_FileSender
+// ----------------------------------------------------------------------------
+
+MLR_Modem_Error MLR_FileSender::begin(MLR_Modem &modem)
+{
+    m_pModem = &modem;
+    m_state = MLR_FileTransferState::Idle;
+    m_session = static_cast<uint8_t>(random(256));
+    modem.AddRxHook(this);
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_FileSender::end()
+{
+    if (m_pModem)
+    {
+        m_pModem->RemoveRxHook(this);
+        m_pModem = nullptr;
+    }
+    m_state = MLR_FileTransferState::Idle;
+}
+
+MLR_Modem_Error MLR_FileSender::Start(const uint8_t *pData, uint32_t size, uint8_t fragLen)
+{
+    if (!pData)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    MLR_Modem_Error rv = m_Start(size, fragLen);
+    if (rv == MLR_Modem_Error::Ok)
+    {
+        m_pData = pData;
+        m_pRead = nullptr;
+    }
+    return rv;
+}
+
+MLR_Modem_Error MLR_FileSender::Start(MLR_FileReadCallback pRead, uint32_t size, uint8_t fragLen)
+{
+    if (!pRead)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    MLR_Modem_Error rv = m_Start(size, fragLen);
+    if (rv == MLR_Modem_Error::Ok)
+    {
+        m_pData = nullptr;
+        m_pRead = pRead;
+    }
+    return rv;
+}
+
+MLR_Modem_Error MLR_FileSender::m_Start(uint32_t size, uint8_t fragLen)
+{
+    if (!m_pModem)
+    {
+        return MLR_Modem_Error::Fail;
+    }
+
+    if (m_state == MLR_FileTransferState::Sending || m_state == MLR_FileTransferState::Polling)
+    {
+        return MLR_Modem_Error::Busy;
+    }
+
+    if (size == 0 || fragLen == 0 || fragLen > MLR_FILE_MAX_FRAGMENT_LEN)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    uint32_t count = (size + fragLen - 1) / fragLen;
+    if (count > MLR_FILE_MAX_FRAGMENTS)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    MLR_Modem_Error rv = m_pModem->SetDestinationID(0x00, false);
+    if (rv != MLR_Modem_Error::Ok)
+    {
+        return rv;
+    }
+
+    ++m_session;
+    m_size = size;
+    m_fragLen = fragLen;
+    m_count = static_cast<uint16_t>(count);
+    m_nextIdx = 0;
+    m_round = 0;
+    m_quietPolls = 0;
+    m_nackCount = 0;
+    m_framesSent = 0;
+    m_activeGroupSize = m_fecGroupSize;
+    m_parityDue = false;
+    m_paritySent = 0;
+
+    // every fragment is pending for the initial transmission
+    memset(m_pending, 0, sizeof(m_pending));
+    for (uint16_t i = 0; i < m_count; ++i)
+    {
+        s_SetBit(m_pending, i);
+    }
+
+    m_state = MLR_FileTransferState::Sending;
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_FileSender::Work()
+{
+    switch (m_state)
+    {
+    case MLR_FileTransferState::Sending:
+    {
+        if (m_parityDue)
+        {
+            // on failure the parity is retried on the next call
+            if (m_SendParity(m_parityIdx) == MLR_Modem_Error::Ok)
+            {
+                m_parityDue = false;
+                ++m_paritySent;
+            }
+            break;
+        }
+
+        while (m_nextIdx < m_count && !s_TestBit(m_pending, m_nextIdx))
+        {
+            ++m_nextIdx;
+        }
+
+        if (m_nextIdx < m_count)
+        {
+            // on failure (e.g. LBT) the bit stays set and the fragment is retried on the next call
+            if (m_SendFragment(m_nextIdx) == MLR_Modem_Error::Ok)
+            {
+                s_ClearBit(m_pending, m_nextIdx);
+                ++m_framesSent;
+
+                // parity only in the initial round, repairs are requested explicitly
+                if (m_activeGroupSize > 0 && m_round == 0 &&
+                    ((m_nextIdx + 1) % m_activeGroupSize == 0 || m_nextIdx == m_count - 1))
+                {
+                    m_parityIdx = m_nextIdx - m_nextIdx % m_activeGroupSize;
+                    m_parityDue = true;
+                }
+                ++m_nextIdx;
+            }
+        }
+        else if (m_SendPoll() == MLR_Modem_Error::Ok)
+        {
+            m_state = MLR_FileTransferState::Polling;
+        }
+        break;
+    }
+
+    case MLR_FileTransferState::Polling:
+    {
+        if (millis() - m_pollStart < m_pollWindowMs)
+        {
+            break;
+        }
+
+        bool anyPending = false;
+        for (uint16_t i = 0; i < (m_count + 7) / 8; ++i)
+        {
+            anyPending |= (m_pending[i] != 0);
+        }
+
+        if (anyPending)
+        {
+            m_quietPolls = 0;
+            if (m_round >= m_maxRounds)
+            {
+                m_state = MLR_FileTransferState::Failed;
+            }
+            else
+            {
+                ++m_round;
+                m_nextIdx = 0;
+                m_state = MLR_FileTransferState::Sending;
+            }
+        }
+        else if (++m_quietPolls >= MLR_FILE_QUIET_POLLS)
+        {
+            m_state = MLR_FileTransferState::Done;
+        }
+        else
+        {
+            // poll again, going through Sending with nothing pending
+            m_state = MLR_FileTransferState::Sending;
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+MLR_Modem_Error MLR_FileSender::m_SendFragment(uint16_t idx)
+{
+    uint8_t frame[MLR_FRAME_MAX_PAYLOAD_LEN];
+    uint32_t offset = static_cast<uint32_t>(idx) * m_fragLen;
+    uint8_t len = (m_size - offset < m_fragLen) ? static_cast<uint8_t>(m_size - offset) : m_fragLen;
+
+    frame[0] = m_session;
+    MLR_Frame_PutU16(&frame[1], idx);
+    MLR_Frame_PutU16(&frame[3], m_count);
+    frame[5] = m_fragLen;
+
+    if (m_pData)
+    {
+        memcpy(&frame[MLR_FILE_DATA_HEADER_LEN], &m_pData[offset], len);
+    }
+    else if (m_pRead(offset, &frame[MLR_FILE_DATA_HEADER_LEN], len) != len)
+    {
+        return MLR_Modem_Error::Fail;
+    }
+
+    return m_pModem->TransmitFrame(MLR_FrameType::FileData, frame, MLR_FILE_DATA_HEADER_LEN + len);
+}
+
+MLR_Modem_Error MLR_FileSender::m_SendParity(uint16_t first)
+{
+    uint8_t frame[MLR_FRAME_MAX_PAYLOAD_LEN];
+    uint8_t groupSize = (m_count - first < m_activeGroupSize) ? static_cast<uint8_t>(m_count - first) : m_activeGroupSize;
+    uint8_t lastLen = static_cast<uint8_t>(m_size - static_cast<uint32_t>(m_count - 1) * m_fragLen);
+
+    frame[0] = m_session;
+    MLR_Frame_PutU16(&frame[1], first);
+    frame[3] = groupSize;
+    frame[4] = lastLen;
+    frame[5] = m_fragLen;
+
+    uint8_t *pParity = &frame[MLR_FILE_PARITY_HEADER_LEN];
+    memset(pParity, 0, m_fragLen);
+    for (uint16_t idx = first; idx < first + groupSize; ++idx)
+    {
+        uint32_t offset = static_cast<uint32_t>(idx) * m_fragLen;
+        uint8_t len = (idx == m_count - 1) ? lastLen : m_fragLen;
+        if (m_pData)
+        {
+            MLR_File_XorParity(pParity, &m_pData[offset], len);
+        }
+        else
+        {
+            uint8_t data[MLR_FILE_MAX_FRAGMENT_LEN];
+            if (m_pRead(offset, data, len) != len)
+            {
+                return MLR_Modem_Error::Fail;
+            }
+            MLR_File_XorParity(pParity, data, len);
+        }
+    }
+
+    return m_pModem->TransmitFrame(MLR_FrameType::FileParity, frame, MLR_FILE_PARITY_HEADER_LEN + m_fragLen);
+}
+
+MLR_Modem_Error MLR_FileSender::m_SendPoll()
+{
+    uint8_t frame[MLR_FILE_POLL_LEN];
+    frame[0] = m_session;
+    MLR_Frame_PutU16(&frame[1], m_count);
+    frame[3] = m_fragLen;
+    MLR_Frame_PutU32(&frame[4], m_size);
+    MLR_Frame_PutU32(&frame[8], m_pollWindowMs);
+
+    MLR_Modem_Error rv = m_pModem->TransmitFrame(MLR_FrameType::FilePoll, frame, sizeof(frame));
+    if (rv == MLR_Modem_Error::Ok)
+    {
+        m_pollStart = millis();
+    }
+    return rv;
+}
+
+MLR_ModemRxAction MLR_FileSender::OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi)
+{
+    (void)rssi;
+
+    MLR_FrameHeader header;
+    if (!MLR_Frame_ParseHeader(pPayload, *pLen, &header) || header.type != MLR_FrameType::FileNack)
+    {
+        return MLR_ModemRxAction::Pass;
+    }
+
+    const uint8_t *pBody = &pPayload[MLR_FRAME_HEADER_LEN];
+    uint8_t bodyLen = *pLen - MLR_FRAME_HEADER_LEN;
+    if (bodyLen <= MLR_FILE_NACK_HEADER_LEN || pBody[0] != m_session ||
+        (m_state != MLR_FileTransferState::Sending && m_state != MLR_FileTransferState::Polling))
+    {
+        // NACK of another (or a finished) session
+        return MLR_ModemRxAction::Drop;
+    }
+
+    // merge the receiver's bitmap into the set of fragments to repair
+    uint16_t base = MLR_Frame_GetU16(&pBody[1]);
+    const uint8_t *pBitmap = &pBody[MLR_FILE_NACK_HEADER_LEN];
+    uint16_t bits = static_cast<uint16_t>(bodyLen - MLR_FILE_NACK_HEADER_LEN) * 8;
+    for (uint16_t i = 0; i < bits && base + i < m_count; ++i)
+    {
+        if (s_TestBit(pBitmap, i))
+        {
+            s_SetBit(m_pending, base + i);
+        }
+    }
+    ++m_nackCount;
+
+    return MLR_ModemRxAction::Drop;
+}
+
+// ----------------------------------------------------------------------------
+// MLR_FileReceiver
+// ----------------------------------------------------------------------------
+
+MLR_Modem_Error MLR_FileReceiver::begin(MLR_Modem &modem, MLR_FileWriteCallback pWrite, MLR_FileCompleteCallback pComplete,
+                                        MLR_FileReadCallback pRead)
+{
+    if (!pWrite)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    m_pModem = &modem;
+    m_pWrite = pWrite;
+    m_pComplete = pComplete;
+    m_pRead = pRead;
+    m_state = MLR_FileTransferState::Idle;
+    m_nackDue = false;
+    modem.AddRxHook(this);
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_FileReceiver::end()
+{
+    if (m_pModem)
+    {
+        m_pModem->RemoveRxHook(this);
+        m_pModem = nullptr;
+    }
+}
+
+void MLR_FileReceiver::Work()
+{
+    if (m_pModem && m_nackDue && (millis() - m_nackScheduled >= m_nackDelay))
+    {
+        // a NACK lost to LBT is not retried: the sender polls again
+        m_nackDue = false;
+        if (m_SendNack() == MLR_Modem_Error::Ok)
+        {
+            ++m_nacksSent;
+        }
+    }
+}
+
+MLR_ModemRxAction MLR_FileReceiver::OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi)
+{
+    (void)rssi;
+
+    MLR_FrameHeader header;
+    if (!MLR_Frame_ParseHeader(pPayload, *pLen, &header))
+    {
+        return MLR_ModemRxAction::Pass;
+    }
+
+    const uint8_t *pBody = &pPayload[MLR_FRAME_HEADER_LEN];
+    uint8_t bodyLen = *pLen - MLR_FRAME_HEADER_LEN;
+
+    switch (header.type)
+    {
+    case MLR_FrameType::FileData:
+    {
+        if (bodyLen <= MLR_FILE_DATA_HEADER_LEN)
+        {
+            break;
+        }
+
+        uint16_t idx = MLR_Frame_GetU16(&pBody[1]);
+        uint16_t count = MLR_Frame_GetU16(&pBody[3]);
+        uint8_t fragLen = pBody[5];
+        uint8_t dataLen = bodyLen - MLR_FILE_DATA_HEADER_LEN;
+        if (!m_Join(pBody[0], count, fragLen) || idx >= m_count || dataLen > m_fragLen ||
+            m_state == MLR_FileTransferState::Done || s_TestBit(m_received, idx))
+        {
+            break;
+        }
+
+        m_Store(idx, &pBody[MLR_FILE_DATA_HEADER_LEN], dataLen);
+        break;
+    }
+
+    case MLR_FrameType::FileParity:
+    {
+        // only for the session being received; the parity alone does not carry enough to join
+        if (!m_pRead || m_state != MLR_FileTransferState::Receiving || bodyLen <= MLR_FILE_PARITY_HEADER_LEN ||
+            pBody[0] != m_session || pBody[5] != m_fragLen || bodyLen - MLR_FILE_PARITY_HEADER_LEN != m_fragLen)
+        {
+            break;
+        }
+
+        uint16_t first = MLR_Frame_GetU16(&pBody[1]);
+        uint8_t groupSize = pBody[3];
+        uint8_t lastLen = pBody[4];
+        if (groupSize == 0 || first >= m_count || groupSize > m_count - first || lastLen == 0 || lastLen > m_fragLen)
+        {
+            break;
+        }
+
+        // the payload is not used after this hook, so the parity is decoded in place
+        m_Recover(first, groupSize, lastLen, &pPayload[MLR_FRAME_HEADER_LEN + MLR_FILE_PARITY_HEADER_LEN]);
+        break;
+    }
+
+    case MLR_FrameType::FilePoll:
+    {
+        if (bodyLen < MLR_FILE_POLL_LEN || !m_Join(pBody[0], MLR_Frame_GetU16(&pBody[1]), pBody[3]))
+        {
+            break;
+        }
+
+        m_size = MLR_Frame_GetU32(&pBody[4]);
+        if (m_state != MLR_FileTransferState::Done)
+        {
+            // answer at a random time within the first 3/4 of the window, so that
+            // receivers do not collide and can overhear (and suppress) each other
+            uint32_t window = MLR_Frame_GetU32(&pBody[8]);
+            m_nackScheduled = millis();
+            m_nackDelay = static_cast<uint32_t>(random(static_cast<long>(window / 4 * 3 + 1)));
+            m_nackDue = true;
+        }
+        break;
+    }
+
+    case MLR_FrameType::FileNack:
+    {
+        // another receiver's NACK: if it already asks for everything we miss, stay silent
+        if (m_nackDue && bodyLen > MLR_FILE_NACK_HEADER_LEN && pBody[0] == m_session &&
+            m_IsCoveredBy(MLR_Frame_GetU16(&pBody[1]), &pBody[MLR_FILE_NACK_HEADER_LEN], bodyLen - MLR_FILE_NACK_HEADER_LEN))
+        {
+            m_nackDue = false;
+            ++m_nacksSuppressed;
+        }
+        break;
+    }
+
+    default:
+        return MLR_ModemRxAction::Pass;
+    }
+
+    return MLR_ModemRxAction::Drop;
+}
+
+bool MLR_FileReceiver::m_Join(uint8_t session, uint16_t count, uint8_t fragLen)
+{
+    if (count == 0 || count > MLR_FILE_MAX_FRAGMENTS || fragLen == 0)
+    {
+        return false;
+    }
+
+    if (m_state != MLR_FileTransferState::Idle && session == m_session)
+    {
+        // same session: the parameters must match
+        return (count == m_count) && (fragLen == m_fragLen);
+    }
+
+    // a new session supersedes the previous one
+    m_session = session;
+    m_count = count;
+    m_fragLen = fragLen;
+    m_size = 0;
+    m_receivedCount = 0;
+    m_nackDue = false;
+    memset(m_received, 0, sizeof(m_received));
+    m_state = MLR_FileTransferState::Receiving;
+    return true;
+}
+
+void MLR_FileReceiver::m_Store(uint16_t idx, const uint8_t *pData, uint8_t len)
+{
+    uint32_t offset = static_cast<uint32_t>(idx) * m_fragLen;
+    m_pWrite(m_session, offset, pData, len);
+    s_SetBit(m_received, idx);
+    ++m_receivedCount;
+    if (idx == m_count - 1)
+    {
+        m_size = offset + len;
+    }
+
+    if (m_receivedCount == m_count)
+    {
+        m_state = MLR_FileTransferState::Done;
+        m_nackDue = false;
+        if (m_pComplete)
+        {
+            m_pComplete(m_session, m_size);
+        }
+    }
+}
+
+void MLR_FileReceiver::m_Recover(uint16_t first, uint8_t groupSize, uint8_t lastLen, uint8_t *pParity)
+{
+    uint16_t missing = m_count;
+    for (uint16_t idx = first; idx < first + groupSize; ++idx)
+    {
+        if (!s_TestBit(m_received, idx))
+        {
+            if (missing != m_count)
+            {
+                return; // more than one fragment lost, left to the repair rounds
+            }
+            missing = idx;
+        }
+    }
+    if (missing == m_count)
+    {
+        return; // nothing lost
+    }
+
+    // parity XOR all other fragments = the missing fragment
+    uint8_t data[MLR_FILE_MAX_FRAGMENT_LEN];
+    for (uint16_t idx = first; idx < first + groupSize; ++idx)
+    {
+        if (idx == missing)
+        {
+            continue;
+        }
+
+        uint8_t len = (idx == m_count - 1) ? lastLen : m_fragLen;
+        if (m_pRead(static_cast<uint32_t>(idx) * m_fragLen, data, len) != len)
+        {
+            return;
+        }
+        MLR_File_XorParity(pParity, data, len);
+    }
+
+    ++m_fecRecovered;
+    m_Store(missing, pParity, (missing == m_count - 1) ? lastLen : m_fragLen);
+}
+
+bool MLR_FileReceiver::m_IsCoveredBy(uint16_t base, const uint8_t *pBitmap, uint8_t bitmapLen) const
+{
+    uint16_t bits = static_cast<uint16_t>(bitmapLen) * 8;
+    for (uint16_t i = 0; i < m_count; ++i)
+    {
+        if (s_TestBit(m_received, i))
+        {
+            continue;
+        }
+
+        if (i < base || i - base >= bits || !s_TestBit(pBitmap, i - base))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+MLR_Modem_Error MLR_FileReceiver::m_SendNack()
+{
+    uint16_t first = m_count;
+    uint16_t last = 0;
+    for (uint16_t i = 0; i < m_count; ++i)
+    {
+        if (!s_TestBit(m_received, i))
+        {
+            if (first == m_count)
+            {
+                first = i;
+            }
+            last = i;
+        }
+    }
+
+    if (first == m_count)
+    {
+        return MLR_Modem_Error::Ok; // nothing missing
+    }
+
+    uint8_t frame[MLR_FRAME_MAX_PAYLOAD_LEN];
+    uint16_t base = first & ~7;
+    uint16_t bitmapLen = ((last - base) >> 3) + 1;
+    if (bitmapLen > MLR_FILE_NACK_MAX_BITMAP_LEN)
+    {
+        // the remaining fragments are requested after the next round
+        bitmapLen = MLR_FILE_NACK_MAX_BITMAP_LEN;
+    }
+
+    frame[0] = m_session;
+    MLR_Frame_PutU16(&frame[1], base);
+    uint8_t *pBitmap = &frame[MLR_FILE_NACK_HEADER_LEN];
+    memset(pBitmap, 0, bitmapLen);
+    for (uint16_t i = 0; i < bitmapLen * 8 && base + i < m_count; ++i)
+    {
+        if (!s_TestBit(m_received, base + i))
+        {
+            s_SetBit(pBitmap, i);
+        }
+    }
+
+    return m_pModem->TransmitFrame(MLR_FrameType::FileNack, frame, static_cast<uint8_t>(MLR_FILE_NACK_HEADER_LEN + bitmapLen));
+}
@@ -0,0 +1,353 @@
+//
+// MLR_FileTransfer.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Reliable multicast distribution of a blob (configuration, firmware image) to a group of modems.
+// The sender broadcasts every fragment once, then polls the group. Receivers answer with
+// bitmaps of their missing fragments (NACK); the sender merges all bitmaps and rebroadcasts
+// only the fragments that are still missing somewhere.
+//
+// Optionally the sender adds an XOR parity fragment after every group of data fragments
+// in the initial round (forward error correction). A receiver that misses a single fragment
+// of a group rebuilds it from the parity and the fragments it has stored, without waiting
+// for a repair round.
+//
+// All nodes must use the same Group ID and broadcast addressing (Destination ID 0x00),
+// so that receivers also overhear each other's NACKs and suppress redundant ones.
+
+#pragma once
+#include "MLR_Modem.h"
+
+#ifndef MLR_FILE_MAX_FRAGMENTS
+/**
+ * @brief Maximum number of fragments of one transfer (512 fragments of MLR_FILE_MAX_FRAGMENT_LEN = 245 bytes = 122 KB).
+ */
+#define MLR_FILE_MAX_FRAGMENTS 512
+#endif
+
+/**
+ * @brief Length of the file transfer header in a data fragment (session, index, count, fragment size).
+ */
+static constexpr uint8_t MLR_FILE_DATA_HEADER_LEN = 6;
+
+/**
+ * @brief Maximum number of data bytes in one fragment.
+ */
+static constexpr uint8_t MLR_FILE_MAX_FRAGMENT_LEN = MLR_FRAME_MAX_PAYLOAD_LEN - MLR_FILE_DATA_HEADER_LEN;
+
+/**
+ * @brief Default time the sender waits for NACKs after a poll in milliseconds.
+ * \note Should cover several NACK transmissions at the configured spreading factor.
+ */
+static constexpr uint32_t MLR_FILE_POLL_WINDOW_MS = 3000;
+
+/**
+ * @brief Default maximum number of repair rounds before the sender gives up.
+ */
+static constexpr uint8_t MLR_FILE_MAX_ROUNDS = 10;
+
+/**
+ * \brief XORs data into a parity buffer (the FEC encoding and decoding step).
+ * \param pParity The parity buffer.
+ * \param pData The data.
+ * \param len Number of bytes.
+ */
+inline void MLR_File_XorParity(uint8_t *pParity, const uint8_t *pData, uint8_t len)
+{
+    uint8_t i = 0;
+    if (((reinterpret_cast<uintptr_t>(pParity) | reinterpret_cast<uintptr_t>(pData)) & 3) == 0)
+    {
+        // word-wise on aligned buffers, the common case for 32-bit MCUs (memcpy compiles to single loads/stores)
+        for (; len - i >= 4; i += 4)
+        {
+            uint32_t p, d;
+            memcpy(&p, &pParity[i], 4);
+            memcpy(&d, &pData[i], 4);
+            p ^= d;
+            memcpy(&pParity[i], &p, 4);
+        }
+    }
+    for (; i < len; ++i)
+    {
+        pParity[i] ^= pData[i];
+    }
+}
+
+/**
+ * \brief State of a multicast file transfer.
+ */
+enum class MLR_FileTransferState : uint8_t
+{
+    Idle,      //!< No transfer in progress
+    Sending,   //!< Sender: sending (or repairing) data fragments
+    Polling,   //!< Sender: waiting for NACKs after a poll
+    Receiving, //!< Receiver: collecting fragments
+    Done,      //!< Transfer completed (sender: no more NACKs, receiver: all fragments received)
+    Failed,    //!< Sender gave up after the maximum number of rounds
+};
+
+/**
+ * \brief Callback to read a part of the blob to be sent.
+ * \param offset Offset of the requested data within the blob.
+ * \param pDst Buffer to store the data.
+ * \param len Number of bytes requested.
+ * \return Number of bytes actually read.
+ */
+typedef uint8_t (*MLR_FileReadCallback)(uint32_t offset, uint8_t *pDst, uint8_t len);
+
+/**
+ * \brief Callback to store a received fragment.
+ * \param session Session ID of the transfer.
+ * \param offset Offset of the data within the blob.
+ * \param pData Pointer to the fragment data (only valid during the callback).
+ * \param len Length of the fragment data.
+ */
+typedef void (*MLR_FileWriteCallback)(uint8_t session, uint32_t offset, const uint8_t *pData, uint8_t len);
+
+/**
+ * \brief Callback signaling that all fragments of a transfer have been received.
+ * \param session Session ID of the transfer.
+ * \param size Size of the blob in bytes.
+ */
+typedef void (*MLR_FileCompleteCallback)(uint8_t session, uint32_t size);
+
+/**
+ * \brief Sending side of the multicast file transfer.
+ */
+class MLR_FileSender : public MLR_ModemRxHook
+{
+public:
+    /**
+     * \brief Registers the sender with the driver.
+     * \param modem The initialized modem driver.
+     * \return MLR_Modem_Error::Ok on success.
+     */
+    MLR_Modem_Error begin(MLR_Modem &modem);
+
+    /**
+     * \brief Unregisters the sender from the driver and aborts a running transfer.
+     */
+    void end();
+
+    /**
+     * \brief Starts the transfer of a blob held in memory.
+     * \param pData Pointer to the blob. Must stay valid until the transfer is finished.
+     * \param size Size of the blob in bytes.
+     * \param fragLen Number of data bytes per fragment (1-MLR_FILE_MAX_FRAGMENT_LEN).
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::InvalidArg if the blob needs too many fragments,
+     *         MLR_Modem_Error::Busy if a transfer is in progress.
+     * \note Switches the modem to broadcast addressing (Destination ID 0x00).
+     */
+    MLR_Modem_Error Start(const uint8_t *pData, uint32_t size, uint8_t fragLen = MLR_FILE_MAX_FRAGMENT_LEN);
+
+    /**
+     * \brief Starts the transfer of a blob read through a callback (e.g. from flash or a file).
+     * \param pRead Callback reading the blob.
+     * \param size Size of the blob in bytes.
+     * \param fragLen Number of data bytes per fragment (1-MLR_FILE_MAX_FRAGMENT_LEN).
+     * \return See Start().
+     */
+    MLR_Modem_Error Start(MLR_FileReadCallback pRead, uint32_t size, uint8_t fragLen = MLR_FILE_MAX_FRAGMENT_LEN);
+
+    /**
+     * \brief Aborts a running transfer.
+     */
+    void Abort() { m_state = MLR_FileTransferState::Idle; }
+
+    /**
+     * \brief Sends the next fragment or poll, evaluates collected NACKs.
+     * This function must be called regularly, e.g. after MLR_Modem::Work(). It blocks while a frame is transmitted.
+     */
+    void Work();
+
+    /**
+     * \brief Sets the time to wait for NACKs after each poll.
+     * \param ms Poll window in milliseconds.
+     */
+    void SetPollWindow(uint32_t ms) { m_pollWindowMs = ms; }
+
+    /**
+     * \brief Sets the forward error correction overhead.
+     * \param groupSize Number of data fragments per parity fragment (overhead 1/groupSize), 0 to disable.
+     * \note Applies from the next Start(). One parity fragment repairs one lost fragment per group: small groups
+     *       help on links with high loss, large groups cost less airtime.
+     */
+    void SetFecGroupSize(uint8_t groupSize) { m_fecGroupSize = groupSize; }
+
+    /**
+     * \brief Sets the maximum number of repair rounds.
+     * \param rounds Maximum number of rounds after the initial transmission.
+     */
+    void SetMaxRounds(uint8_t rounds) { m_maxRounds = rounds; }
+
+    /**
+     * \brief Gets the state of the transfer.
+     */
+    MLR_FileTransferState GetState() const { return m_state; }
+
+    /**
+     * \brief Gets the session ID of the current (or last) transfer.
+     */
+    uint8_t GetSession() const { return m_session; }
+
+    /**
+     * \brief Gets the number of fragments of the current transfer.
+     */
+    uint16_t GetFragmentCount() const { return m_count; }
+
+    /**
+     * \brief Gets the number of repair rounds so far.
+     */
+    uint8_t GetRound() const { return m_round; }
+
+    /**
+     * \brief Gets the number of data fragments transmitted, including repairs.
+     */
+    uint32_t GetFramesSent() const { return m_framesSent; }
+
+    /**
+     * \brief Gets the number of NACKs received during the current transfer.
+     */
+    uint16_t GetNackCount() const { return m_nackCount; }
+
+    /**
+     * \brief Gets the number of parity fragments transmitted during the current transfer.
+     */
+    uint16_t GetParitySent() const { return m_paritySent; }
+
+    //! Receive hook: merges NACKs of the current session into the pending bitmap
+    MLR_ModemRxAction OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi) override;
+
+private:
+    //! Internal: Common part of both Start() variants
+    MLR_Modem_Error m_Start(uint32_t size, uint8_t fragLen);
+
+    //! Internal: Transmits one data fragment
+    MLR_Modem_Error m_SendFragment(uint16_t idx);
+
+    //! Internal: Transmits the parity fragment of the group starting at first
+    MLR_Modem_Error m_SendParity(uint16_t first);
+
+    //! Internal: Transmits a poll frame and opens the NACK window
+    MLR_Modem_Error m_SendPoll();
+
+    MLR_Modem *m_pModem = nullptr;                         //!< Driver the sender is registered with
+    const uint8_t *m_pData = nullptr;                      //!< Blob in memory, or nullptr if read through m_pRead
+    MLR_FileReadCallback m_pRead = nullptr;                //!< Callback to read the blob
+    MLR_FileTransferState m_state = MLR_FileTransferState::Idle; //!< Transfer state
+    uint8_t m_session = 0;                                 //!< Session ID of the transfer
+    uint8_t m_fragLen = 0;                                 //!< Data bytes per fragment
+    uint8_t m_round = 0;                                   //!< Repair round
+    uint8_t m_maxRounds = MLR_FILE_MAX_ROUNDS;             //!< Maximum number of repair rounds
+    uint8_t m_quietPolls = 0;                              //!< Polls in a row without any NACK
+    uint8_t m_fecGroupSize = 0;                            //!< Data fragments per parity fragment, 0 = no FEC
+    uint8_t m_activeGroupSize = 0;                         //!< FEC group size of the current transfer
+    bool m_parityDue = false;                              //!< The parity of the group at m_parityIdx is to be sent
+    uint16_t m_parityIdx = 0;                              //!< First fragment of the group whose parity is due
+    uint16_t m_paritySent = 0;                             //!< Parity fragments transmitted
+    uint16_t m_count = 0;                                  //!< Number of fragments
+    uint16_t m_nextIdx = 0;                                //!< Next fragment to check in the pending bitmap
+    uint16_t m_nackCount = 0;                              //!< Number of NACKs received
+    uint32_t m_pollWindowMs = MLR_FILE_POLL_WINDOW_MS;     //!< NACK window after a poll
+    uint32_t m_size = 0;                                   //!< Size of the blob
+    uint32_t m_pollStart = 0;                              //!< millis() timestamp of the last poll
+    uint32_t m_framesSent = 0;                             //!< Data fragments transmitted
+    uint8_t m_pending[(MLR_FILE_MAX_FRAGMENTS + 7) / 8];   //!< Fragments still to be (re)transmitted
+};
+
+/**
+ * \brief Receiving side of the multicast file transfer.
+ */
+class MLR_FileReceiver : public MLR_ModemRxHook
+{
+public:
+    /**
+     * \brief Registers the receiver with the driver.
+     * \param modem The initialized modem driver.
+     * \param pWrite Callback storing the received fragments.
+     * \param pComplete Callback called once all fragments of a transfer are received (may be nullptr).
+     * \param pRead Callback reading back stored data (may be nullptr). Required to rebuild lost fragments from parity
+     *              fragments; the offset is relative to the blob, as passed to pWrite.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::InvalidArg if pWrite is nullptr.
+     */
+    MLR_Modem_Error begin(MLR_Modem &modem, MLR_FileWriteCallback pWrite, MLR_FileCompleteCallback pComplete = nullptr,
+                          MLR_FileReadCallback pRead = nullptr);
+
+    /**
+     * \brief Unregisters the receiver from the driver.
+     */
+    void end();
+
+    /**
+     * \brief Sends a scheduled NACK.
+     * This function must be called regularly, e.g. after MLR_Modem::Work().
+     */
+    void Work();
+
+    /**
+     * \brief Gets the state of the transfer.
+     */
+    MLR_FileTransferState GetState() const { return m_state; }
+
+    /**
+     * \brief Gets the number of fragments of the current transfer (0 if unknown).
+     */
+    uint16_t GetFragmentCount() const { return m_count; }
+
+    /**
+     * \brief Gets the number of distinct fragments received.
+     */
+    uint16_t GetReceivedCount() const { return m_receivedCount; }
+
+    /**
+     * \brief Gets the number of NACKs this receiver has sent.
+     */
+    uint16_t GetNacksSent() const { return m_nacksSent; }
+
+    /**
+     * \brief Gets the number of NACKs suppressed because another receiver already reported the same fragments.
+     */
+    uint16_t GetNacksSuppressed() const { return m_nacksSuppressed; }
+
+    /**
+     * \brief Gets the number of fragments rebuilt from parity fragments.
+     */
+    uint16_t GetFecRecovered() const { return m_fecRecovered; }
+
+    //! Receive hook: stores fragments, schedules NACKs on polls, suppresses NACKs covered by other receivers
+    MLR_ModemRxAction OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi) override;
+
+private:
+    //! Internal: Starts tracking a (new) session
+    bool m_Join(uint8_t session, uint16_t count, uint8_t fragLen);
+
+    //! Internal: Stores a new fragment and signals completion
+    void m_Store(uint16_t idx, const uint8_t *pData, uint8_t len);
+
+    //! Internal: Rebuilds the only missing fragment of a group from its parity
+    void m_Recover(uint16_t first, uint8_t groupSize, uint8_t lastLen, uint8_t *pParity);
+
+    //! Internal: Checks whether another receiver's NACK covers all of our missing fragments
+    bool m_IsCoveredBy(uint16_t base, const uint8_t *pBitmap, uint8_t bitmapLen) const;
+
+    //! Internal: Transmits the NACK bitmap
+    MLR_Modem_Error m_SendNack();
+
+    MLR_Modem *m_pModem = nullptr;                         //!< Driver the receiver is registered with
+    MLR_FileWriteCallback m_pWrite = nullptr;              //!< Callback storing fragments
+    MLR_FileCompleteCallback m_pComplete = nullptr;        //!< Callback on completion
+    MLR_FileReadCallback m_pRead = nullptr;                //!< Callback reading back stored data (FEC)
+    MLR_FileTransferState m_state = MLR_FileTransferState::Idle; //!< Transfer state
+    uint8_t m_session = 0;                                 //!< Session ID being received
+    uint8_t m_fragLen = 0;                                 //!< Data bytes per (non-last) fragment
+    bool m_nackDue = false;                                //!< A NACK is scheduled
+    uint16_t m_count = 0;                                  //!< Number of fragments
+    uint16_t m_receivedCount = 0;                          //!< Number of distinct fragments received
+    uint16_t m_nacksSent = 0;                              //!< NACKs sent
+    uint16_t m_nacksSuppressed = 0;                        //!< NACKs suppressed
+    uint16_t m_fecRecovered = 0;                           //!< Fragments rebuilt from parity
+    uint32_t m_size = 0;                                   //!< Size of the blob (0 until known)
+    uint32_t m_nackDelay = 0;                              //!< Delay of the NACK after the poll
+    uint32_t m_nackScheduled = 0;                          //!< millis() timestamp of the poll that scheduled the NACK
+    uint8_t m_received[(MLR_FILE_MAX_FRAGMENTS + 7) / 8];  //!< Fragments received
+};
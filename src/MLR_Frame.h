@@ -0,0 +1,183 @@
+//
+// MLR_Frame.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Optional frame header carried at the start of a radio payload.
+// The modem itself does not report the sender of a *DR telegram, so the
+// add-on modules (neighbor table, ...) agree on a small header that carries
+// the frame type, the sender's Equipment ID, a per-sender sequence number and a
+// check byte, so that unframed binary payloads are not mistaken for frames.
+
+#pragma once
+#include <stdint.h>
+
+/**
+ * \brief Maximum payload length of a single "@DT" transmission.
+ */
+static constexpr uint8_t MLR_MAX_PAYLOAD_LEN = 255;
+
+/**
+ * \brief Length of the optional frame header (type, source ID, sequence number, check byte).
+ */
+static constexpr uint8_t MLR_FRAME_HEADER_LEN = 4;
+
+/**
+ * \brief Initial value of the frame header check byte. Changing it separates incompatible frame formats.
+ */
+static constexpr uint8_t MLR_FRAME_CHECK_INIT = 0x4D;
+
+/**
+ * \brief Maximum payload length following the frame header.
+ */
+static constexpr uint8_t MLR_FRAME_MAX_PAYLOAD_LEN = MLR_MAX_PAYLOAD_LEN - MLR_FRAME_HEADER_LEN;
+
+/**
+ * \brief Type of a framed radio payload.
+ * \note The values are chosen so that plain ASCII payloads are never mistaken for a frame.
+ */
+enum class MLR_FrameType : uint8_t
+{
+    Data = 0xD0,         //!< Application data
+    Beacon = 0xB0,       //!< Neighbor discovery beacon (header only)
+    FileData = 0xF0,     //!< Multicast file transfer: data fragment
+    FilePoll = 0xF1,     //!< Multicast file transfer: request for missing fragments
+    FileNack = 0xF2,     //!< Multicast file transfer: bitmap of missing fragments
+    FileParity = 0xF3,   //!< Multicast file transfer: XOR parity of a group of fragments
+    Publish = 0xE0,      //!< Publish/subscribe: topic ID followed by the value
+    ConfigSet = 0xA0,    //!< Remote configuration: signed configuration change (see MLR_RemoteConfig.h)
+    ConfigAck = 0xA1,    //!< Remote configuration: signed bitmap of nodes that received the change
+    ProbeRequest = 0x90, //!< Link probe: echo request (see MLR_LinkProbe.h)
+    ProbeReply = 0x91,   //!< Link probe: echo reply
+    Secure = 0xC0,       //!< Authenticated and encrypted frame (see MLR_SecureChannel.h)
+};
+
+/**
+ * \brief Decoded frame header.
+ */
+struct MLR_FrameHeader
+{
+    MLR_FrameType type; //!< Frame type
+    uint8_t src;        //!< Equipment ID of the sender
+    uint8_t seq;        //!< Sequence number of the sender (wraps at 255)
+};
+
+/**
+ * \brief Checks if a byte is a known frame type.
+ * \param type The byte to check.
+ * \return true if the byte is a valid MLR_FrameType value.
+ */
+inline bool MLR_Frame_IsKnownType(uint8_t type)
+{
+    switch (static_cast<MLR_FrameType>(type))
+    {
+    case MLR_FrameType::Data:
+    case MLR_FrameType::Beacon:
+    case MLR_FrameType::FileData:
+    case MLR_FrameType::FilePoll:
+    case MLR_FrameType::FileNack:
+    case MLR_FrameType::FileParity:
+    case MLR_FrameType::Publish:
+    case MLR_FrameType::ConfigSet:
+    case MLR_FrameType::ConfigAck:
+    case MLR_FrameType::ProbeRequest:
+    case MLR_FrameType::ProbeReply:
+    case MLR_FrameType::Secure:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * \brief Computes the check byte of a frame header (CRC-8, polynomial 0x07, over type, source ID and sequence number).
+ * \param pHeader Pointer to the first three header bytes.
+ * \return The check byte.
+ * \note A payload that merely starts with a frame type byte passes with a probability of 1/256 only.
+ */
+inline uint8_t MLR_Frame_Check(const uint8_t *pHeader)
+{
+    uint8_t crc = MLR_FRAME_CHECK_INIT;
+    for (uint8_t i = 0; i < MLR_FRAME_HEADER_LEN - 1; ++i)
+    {
+        crc ^= pHeader[i];
+        for (uint8_t bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * \brief Decodes the frame header at the start of a payload.
+ * \param pData Pointer to the received payload.
+ * \param len Length of the received payload.
+ * \param pHeader Pointer to store the decoded header.
+ * \return true if the payload starts with a valid frame header (known type and matching check byte).
+ */
+inline bool MLR_Frame_ParseHeader(const uint8_t *pData, uint8_t len, MLR_FrameHeader *pHeader)
+{
+    if (!pData || len < MLR_FRAME_HEADER_LEN || !MLR_Frame_IsKnownType(pData[0]) ||
+        pData[MLR_FRAME_HEADER_LEN - 1] != MLR_Frame_Check(pData))
+    {
+        return false;
+    }
+
+    if (pHeader)
+    {
+        pHeader->type = static_cast<MLR_FrameType>(pData[0]);
+        pHeader->src = pData[1];
+        pHeader->seq = pData[2];
+    }
+    return true;
+}
+
+/**
+ * \brief Encodes a frame header.
+ * \param pDst Destination buffer (at least MLR_FRAME_HEADER_LEN bytes).
+ * \param header The header to encode.
+ */
+inline void MLR_Frame_WriteHeader(uint8_t *pDst, const MLR_FrameHeader &header)
+{
+    pDst[0] = static_cast<uint8_t>(header.type);
+    pDst[1] = header.src;
+    pDst[2] = header.seq;
+    pDst[3] = MLR_Frame_Check(pDst);
+}
+
+/**
+ * \brief Reads a little-endian 16-bit value from a frame.
+ */
+inline uint16_t MLR_Frame_GetU16(const uint8_t *pSrc)
+{
+    return static_cast<uint16_t>(pSrc[0] | (pSrc[1] << 8));
+}
+
+/**
+ * \brief Writes a little-endian 16-bit value into a frame.
+ */
+inline void MLR_Frame_PutU16(uint8_t *pDst, uint16_t value)
+{
+    pDst[0] = static_cast<uint8_t>(value);
+    pDst[1] = static_cast<uint8_t>(value >> 8);
+}
+
+/**
+ * \brief Reads a little-endian 32-bit value from a frame.
+ */
+inline uint32_t MLR_Frame_GetU32(const uint8_t *pSrc)
+{
+    return static_cast<uint32_t>(pSrc[0]) | (static_cast<uint32_t>(pSrc[1]) << 8) |
+           (static_cast<uint32_t>(pSrc[2]) << 16) | (static_cast<uint32_t>(pSrc[3]) << 24);
+}
+
+/**
+ * \brief Writes a little-endian 32-bit value into a frame.
+ */
+inline void MLR_Frame_PutU32(uint8_t *pDst, uint32_t value)
+{
+    pDst[0] = static_cast<uint8_t>(value);
+    pDst[1] = static_cast<uint8_t>(value >> 8);
+    pDst[2] = static_cast<uint8_t>(value >> 16);
+    pDst[3] = static_cast<uint8_t>(value >> 24);
+}
@@ -0,0 +1,254 @@
+//
+// MLR_LinkProbe.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Round-trip time, goodput and loss measurement between two modems.
+//
+// Frame body following the frame header (all values little-endian):
+//   ProbeRequest: session(1) seq(2) timestamp_us(4) filler(...)
+//   ProbeReply:   the request body, echoed unchanged
+//
+
+#include "MLR_LinkProbe.h"
+#include <string.h>
+
+MLR_Modem_Error MLR_LinkProbe::begin(MLR_Modem &modem)
+{
+    m_pModem = &modem;
+    m_running = false;
+    m_echoLen = 0;
+    m_session = static_cast<uint8_t>(random(256));
+    modem.AddRxHook(this);
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_LinkProbe::end()
+{
+    if (m_pModem)
+    {
+        m_pModem->RemoveRxHook(this);
+        m_pModem = nullptr;
+    }
+    m_running = false;
+}
+
+MLR_Modem_Error MLR_LinkProbe::Start(const uint8_t *pLengths, uint8_t lengthCount, uint16_t probesPerLength,
+                                     uint32_t timeoutMs, uint32_t intervalMs)
+{
+    if (!m_pModem)
+    {
+        return MLR_Modem_Error::Fail;
+    }
+
+    if (m_running)
+    {
+        return MLR_Modem_Error::Busy;
+    }
+
+    if (!pLengths || lengthCount == 0 || lengthCount > MLR_PROBE_MAX_STEPS || probesPerLength == 0 || timeoutMs == 0)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    for (uint8_t i = 0; i < lengthCount; ++i)
+    {
+        if (pLengths[i] < MLR_PROBE_HEADER_LEN || pLengths[i] > MLR_FRAME_MAX_PAYLOAD_LEN)
+        {
+            return MLR_Modem_Error::InvalidArg;
+        }
+    }
+
+    memcpy(m_lengths, pLengths, lengthCount);
+    m_stepCount = lengthCount;
+    m_probesPerStep = probesPerLength;
+    m_timeoutMs = timeoutMs;
+    m_intervalMs = intervalMs;
+
+    ++m_session; // late echoes of a previous sweep are ignored
+    m_step = 0;
+    m_resultCount = 0;
+    memset(&m_results[0], 0, sizeof(m_results[0]));
+    m_results[0].payloadLen = m_lengths[0];
+    m_sampleCount = 0;
+    m_rttSum = 0;
+    m_waiting = false;
+    m_nextAt = millis();
+    m_stepStart = millis();
+    m_running = true;
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_LinkProbe::Work()
+{
+    if (!m_pModem)
+    {
+        return;
+    }
+
+    // echoes first, the other side is waiting
+    if (m_echoLen > 0)
+    {
+        if (m_pModem->TransmitFrame(MLR_FrameType::ProbeReply, m_echo, m_echoLen) == MLR_Modem_Error::Ok)
+        {
+            ++m_echoCount;
+        }
+        m_echoLen = 0; // a lost echo counts as loss, as on the air
+    }
+
+    if (!m_running)
+    {
+        return;
+    }
+
+    if (m_waiting)
+    {
+        if (micros() - m_sentAt < m_timeoutMs * 1000UL)
+        {
+            return;
+        }
+        m_waiting = false; // lost
+        m_nextAt = millis() + m_intervalMs;
+    }
+
+    if (m_results[m_step].sent >= m_probesPerStep)
+    {
+        m_FinishStep();
+        return;
+    }
+
+    if (static_cast<int32_t>(millis() - m_nextAt) >= 0)
+    {
+        // on failure (e.g. LBT) the probe is retried on the next call and not counted
+        m_SendProbe();
+    }
+}
+
+MLR_Modem_Error MLR_LinkProbe::m_SendProbe()
+{
+    uint8_t frame[MLR_FRAME_MAX_PAYLOAD_LEN];
+    uint8_t len = m_lengths[m_step];
+
+    frame[0] = m_session;
+    MLR_Frame_PutU16(&frame[1], ++m_seq);
+    for (uint8_t i = MLR_PROBE_HEADER_LEN; i < len; ++i)
+    {
+        frame[i] = static_cast<uint8_t>(i);
+    }
+
+    // the timestamp includes the local command overhead of "@DT"
+    uint32_t sentAt = micros();
+    MLR_Frame_PutU32(&frame[3], sentAt);
+    MLR_Modem_Error rv = m_pModem->TransmitFrame(MLR_FrameType::ProbeRequest, frame, len);
+    if (rv == MLR_Modem_Error::Ok)
+    {
+        m_sentAt = sentAt;
+        m_waiting = true;
+        ++m_results[m_step].sent;
+    }
+    return rv;
+}
+
+void MLR_LinkProbe::m_FinishStep()
+{
+    MLR_ProbeResult &result = m_results[m_step];
+    if (result.received > 0)
+    {
+        result.avgUs = static_cast<uint32_t>(m_rttSum / result.received);
+
+        // insertion sort, the sample count is small
+        for (uint16_t i = 1; i < m_sampleCount; ++i)
+        {
+            uint32_t v = m_samples[i];
+            uint16_t j = i;
+            for (; j > 0 && m_samples[j - 1] > v; --j)
+            {
+                m_samples[j] = m_samples[j - 1];
+            }
+            m_samples[j] = v;
+        }
+        uint16_t rank = static_cast<uint16_t>((99UL * m_sampleCount + 99) / 100); // nearest-rank method
+        result.p99Us = m_samples[rank - 1];
+    }
+
+    uint32_t elapsedMs = millis() - m_stepStart;
+    if (elapsedMs > 0)
+    {
+        result.goodputBps = static_cast<uint32_t>((1000ULL * result.received * result.payloadLen) / elapsedMs);
+    }
+
+    m_resultCount = m_step + 1;
+    if (++m_step >= m_stepCount)
+    {
+        m_running = false;
+        return;
+    }
+
+    memset(&m_results[m_step], 0, sizeof(m_results[m_step]));
+    m_results[m_step].payloadLen = m_lengths[m_step];
+    m_sampleCount = 0;
+    m_rttSum = 0;
+    m_stepStart = millis();
+}
+
+MLR_ModemRxAction MLR_LinkProbe::OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi)
+{
+    (void)rssi;
+
+    MLR_FrameHeader header;
+    if (!MLR_Frame_ParseHeader(pPayload, *pLen, &header))
+    {
+        return MLR_ModemRxAction::Pass;
+    }
+
+    const uint8_t *pBody = &pPayload[MLR_FRAME_HEADER_LEN];
+    uint8_t bodyLen = *pLen - MLR_FRAME_HEADER_LEN;
+
+    switch (header.type)
+    {
+    case MLR_FrameType::ProbeRequest:
+    {
+        // one pending echo; a request arriving before the previous echo is sent is dropped
+        if (m_responder && m_echoLen == 0 && bodyLen >= MLR_PROBE_HEADER_LEN)
+        {
+            memcpy(m_echo, pBody, bodyLen);
+            m_echoLen = bodyLen;
+        }
+        break;
+    }
+
+    case MLR_FrameType::ProbeReply:
+    {
+        if (!m_running || !m_waiting || bodyLen < MLR_PROBE_HEADER_LEN || pBody[0] != m_session ||
+            MLR_Frame_GetU16(&pBody[1]) != m_seq)
+        {
+            break; // late echo of a timed out probe, or of another sweep
+        }
+
+        uint32_t rtt = micros() - MLR_Frame_GetU32(&pBody[3]);
+        MLR_ProbeResult &result = m_results[m_step];
+        if (result.received == 0 || rtt < result.minUs)
+        {
+            result.minUs = rtt;
+        }
+        if (rtt > result.maxUs)
+        {
+            result.maxUs = rtt;
+        }
+        ++result.received;
+        m_rttSum += rtt;
+        if (m_sampleCount < MLR_PROBE_MAX_SAMPLES)
+        {
+            m_samples[m_sampleCount++] = rtt;
+        }
+
+        m_waiting = false;
+        m_nextAt = millis() + m_intervalMs;
+        break;
+    }
+
+    default:
+        return MLR_ModemRxAction::Pass;
+    }
+
+    return MLR_ModemRxAction::Drop;
+}
@@ -0,0 +1,161 @@
+//
+// MLR_LinkProbe.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Round-trip time, goodput and loss measurement between two modems (site surveys, regression checks).
+// One modem runs as echo responder, the other sends probes carrying a timestamp and waits for each
+// echo before sending the next one. The client sweeps a list of payload lengths and reports
+// min/avg/p99/max RTT, loss and goodput per length. The RTT includes the serial command overhead
+// of both modems and the time on air in both directions, as seen by an application.
+
+#pragma once
+#include "MLR_Modem.h"
+
+#ifndef MLR_PROBE_MAX_STEPS
+/**
+ * @brief Maximum number of payload lengths in one sweep.
+ */
+#define MLR_PROBE_MAX_STEPS 8
+#endif
+
+#ifndef MLR_PROBE_MAX_SAMPLES
+/**
+ * @brief Number of RTT samples kept per payload length for the percentile (min, avg and max use all samples).
+ */
+#define MLR_PROBE_MAX_SAMPLES 100
+#endif
+
+/**
+ * @brief Length of the probe header in the frame body (session, sequence number, timestamp).
+ */
+static constexpr uint8_t MLR_PROBE_HEADER_LEN = 7;
+
+/**
+ * @brief Default time to wait for an echo in milliseconds.
+ */
+static constexpr uint32_t MLR_PROBE_TIMEOUT_MS = 10000;
+
+/**
+ * \brief Result of the probes with one payload length.
+ */
+struct MLR_ProbeResult
+{
+    uint8_t payloadLen;  //!< Frame body length of the probes
+    uint16_t sent;       //!< Probes sent
+    uint16_t received;   //!< Echoes received in time
+    uint32_t minUs;      //!< Minimum RTT in microseconds
+    uint32_t avgUs;      //!< Average RTT in microseconds
+    uint32_t p99Us;      //!< 99th percentile RTT in microseconds
+    uint32_t maxUs;      //!< Maximum RTT in microseconds
+    uint32_t goodputBps; //!< Echoed payload bytes per second over the duration of the step
+
+    /**
+     * \brief Gets the loss in permille.
+     */
+    uint16_t GetLoss() const { return sent ? static_cast<uint16_t>((1000UL * (sent - received)) / sent) : 0; }
+};
+
+/**
+ * \brief Echo responder and ping/throughput client.
+ */
+class MLR_LinkProbe : public MLR_ModemRxHook
+{
+public:
+    /**
+     * \brief Registers the probe with the driver.
+     * \param modem The initialized modem driver.
+     * \return MLR_Modem_Error::Ok on success.
+     */
+    MLR_Modem_Error begin(MLR_Modem &modem);
+
+    /**
+     * \brief Unregisters the probe from the driver and stops a running sweep.
+     */
+    void end();
+
+    /**
+     * \brief Enables answering probes of other modems.
+     * \param enable true to echo every probe request.
+     */
+    void SetResponder(bool enable) { m_responder = enable; }
+
+    /**
+     * \brief Starts a sweep.
+     * \param pLengths Frame body lengths to measure (MLR_PROBE_HEADER_LEN-MLR_FRAME_MAX_PAYLOAD_LEN), copied.
+     * \param lengthCount Number of lengths (1-MLR_PROBE_MAX_STEPS).
+     * \param probesPerLength Number of probes sent per length.
+     * \param timeoutMs Time to wait for each echo in milliseconds; should exceed twice the time on air.
+     * \param intervalMs Pause between an echo (or timeout) and the next probe in milliseconds.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::Busy if a sweep is running,
+     *         MLR_Modem_Error::InvalidArg on invalid parameters.
+     */
+    MLR_Modem_Error Start(const uint8_t *pLengths, uint8_t lengthCount, uint16_t probesPerLength = 20,
+                          uint32_t timeoutMs = MLR_PROBE_TIMEOUT_MS, uint32_t intervalMs = 0);
+
+    /**
+     * \brief Stops a running sweep. Results of completed lengths are kept.
+     */
+    void Stop() { m_running = false; }
+
+    /**
+     * \brief Sends echoes and probes, detects timeouts.
+     * This function must be called regularly, e.g. after MLR_Modem::Work(). It blocks while a frame is transmitted.
+     */
+    void Work();
+
+    /**
+     * \brief Checks whether a sweep is running.
+     */
+    bool IsRunning() const { return m_running; }
+
+    /**
+     * \brief Gets the number of completed payload lengths of the current (or last) sweep.
+     */
+    uint8_t GetResultCount() const { return m_resultCount; }
+
+    /**
+     * \brief Gets the result of a payload length.
+     * \param idx Index (0 to GetResultCount() - 1).
+     * \return Pointer to the result, or nullptr if idx is out of range.
+     */
+    const MLR_ProbeResult *GetResult(uint8_t idx) const { return (idx < m_resultCount) ? &m_results[idx] : nullptr; }
+
+    /**
+     * \brief Gets the number of echoes sent as responder.
+     */
+    uint32_t GetEchoCount() const { return m_echoCount; }
+
+    //! Receive hook: queues echoes, evaluates replies
+    MLR_ModemRxAction OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi) override;
+
+private:
+    //! Internal: Transmits the next probe
+    MLR_Modem_Error m_SendProbe();
+
+    //! Internal: Computes the result of the current length and advances to the next one
+    void m_FinishStep();
+
+    MLR_Modem *m_pModem = nullptr;                         //!< Driver the probe is registered with
+    bool m_responder = false;                              //!< Echo probe requests
+    bool m_running = false;                                //!< A sweep is running
+    bool m_waiting = false;                                //!< A probe is waiting for its echo
+    uint8_t m_session = 0;                                 //!< Session ID of the sweep
+    uint8_t m_step = 0;                                    //!< Index of the current length
+    uint8_t m_stepCount = 0;                               //!< Number of lengths
+    uint8_t m_resultCount = 0;                             //!< Completed lengths
+    uint8_t m_echoLen = 0;                                 //!< Length of the pending echo, 0 = none
+    uint16_t m_seq = 0;                                    //!< Sequence number of the current probe
+    uint16_t m_probesPerStep = 0;                          //!< Probes per length
+    uint16_t m_sampleCount = 0;                            //!< RTT samples kept in m_samples
+    uint32_t m_timeoutMs = MLR_PROBE_TIMEOUT_MS;           //!< Time to wait for an echo
+    uint32_t m_intervalMs = 0;                             //!< Pause between probes
+    uint32_t m_sentAt = 0;                                 //!< micros() timestamp of the current probe
+    uint32_t m_nextAt = 0;                                 //!< millis() timestamp of the next probe
+    uint32_t m_stepStart = 0;                              //!< millis() timestamp of the start of the step
+    uint32_t m_echoCount = 0;                              //!< Echoes sent
+    uint64_t m_rttSum = 0;                                 //!< Sum of RTTs of the step
+    uint8_t m_lengths[MLR_PROBE_MAX_STEPS] = {};           //!< Lengths of the sweep
+    MLR_ProbeResult m_results[MLR_PROBE_MAX_STEPS] = {};   //!< Results
+    uint32_t m_samples[MLR_PROBE_MAX_SAMPLES];             //!< RTT samples of the step
+    uint8_t m_echo[MLR_FRAME_MAX_PAYLOAD_LEN];             //!< Pending echo body
+};
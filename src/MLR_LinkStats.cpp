@@ -0,0 +1,132 @@
+//
+// MLR_LinkStats.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Per-peer link accounting from the sequence numbers of framed packets.
+//
+
+#include "MLR_LinkStats.h"
+#include <string.h>
+
+// forward gaps larger than this are treated as a restart of the peer, not as loss
+static constexpr uint8_t MLR_LINKSTATS_MAX_SEQ_GAP = 64;
+
+uint16_t MLR_LinkStatsEntry::GetPer() const
+{
+    if (windowLen == 0)
+    {
+        return 0;
+    }
+
+    uint64_t mask = (windowLen >= 64) ? ~0ULL : ((1ULL << windowLen) - 1);
+    uint64_t bits = window & mask;
+    uint8_t receivedInWindow = 0;
+    while (bits)
+    {
+        bits &= bits - 1;
+        ++receivedInWindow;
+    }
+    return static_cast<uint16_t>((1000UL * (windowLen - receivedInWindow)) / windowLen);
+}
+
+MLR_Modem_Error MLR_LinkStats::begin(MLR_Modem &modem)
+{
+    m_pModem = &modem;
+    m_table.Clear();
+    modem.AddRxHook(this, true);
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_LinkStats::end()
+{
+    if (m_pModem)
+    {
+        m_pModem->RemoveRxHook(this);
+        m_pModem = nullptr;
+    }
+}
+
+MLR_ModemRxAction MLR_LinkStats::OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi)
+{
+    MLR_FrameHeader header;
+    if (!MLR_Frame_ParseHeader(pPayload, *pLen, &header))
+    {
+        return MLR_ModemRxAction::Pass;
+    }
+
+    bool created = false;
+    MLR_LinkStatsEntry *pEntry = m_table.Insert(header.src, &created);
+    uint32_t now = millis();
+
+    if (created)
+    {
+        memset(pEntry, 0, sizeof(*pEntry));
+        pEntry->id = header.src;
+        pEntry->lastSeq = header.seq;
+        pEntry->window = 1;
+        pEntry->windowLen = 1;
+        pEntry->received = 1;
+        pEntry->firstSeen = now;
+    }
+    else if (!m_TrackSequence(pEntry, header.seq))
+    {
+        ++pEntry->duplicates;
+        pEntry->lastSeen = now;
+        return MLR_ModemRxAction::Pass;
+    }
+
+    pEntry->lastSeen = now;
+
+    if (rssi != MLR_RSSI_UNKNOWN)
+    {
+        // Welford's online algorithm, numerically stable for long runs
+        ++pEntry->rssiCount;
+        float delta = rssi - pEntry->rssiMean;
+        pEntry->rssiMean += delta / pEntry->rssiCount;
+        pEntry->rssiM2 += delta * (rssi - pEntry->rssiMean);
+    }
+
+    return MLR_ModemRxAction::Pass;
+}
+
+bool MLR_LinkStats::m_TrackSequence(MLR_LinkStatsEntry *pEntry, uint8_t seq)
+{
+    int8_t diff = static_cast<int8_t>(seq - pEntry->lastSeq);
+
+    if (diff > 0 && diff <= MLR_LINKSTATS_MAX_SEQ_GAP)
+    {
+        pEntry->missed += diff - 1;
+        pEntry->window = (diff >= 64) ? 1 : (pEntry->window << diff) | 1;
+        pEntry->windowLen = (pEntry->windowLen + diff > MLR_LINKSTATS_PER_WINDOW) ? MLR_LINKSTATS_PER_WINDOW : pEntry->windowLen + diff;
+        pEntry->lastSeq = seq;
+        ++pEntry->received;
+        return true;
+    }
+
+    uint8_t age = static_cast<uint8_t>(-diff);
+    if (diff <= 0 && age < pEntry->windowLen)
+    {
+        uint64_t bit = 1ULL << age;
+        if (pEntry->window & bit)
+        {
+            return false;
+        }
+
+        // late frame, it had been counted as missed
+        pEntry->window |= bit;
+        if (pEntry->missed > 0)
+        {
+            --pEntry->missed;
+        }
+        ++pEntry->received;
+        return true;
+    }
+
+    // too far ahead or behind: the peer restarted its sequence
+    ++pEntry->restarts;
+    pEntry->lastSeq = seq;
+    pEntry->window = 1;
+    pEntry->windowLen = 1;
+    ++pEntry->received;
+    return true;
+}
@@ -0,0 +1,109 @@
+//
+// MLR_LinkStats.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Per-peer link accounting from the sequence numbers of framed packets (see MLR_Frame.h).
+// Missed frames are derived from sequence gaps, so a lossy link shows a rising packet error
+// rate while a silent peer only stops updating its lastSeen timestamp. No radio traffic is needed.
+
+#pragma once
+#include "MLR_Modem.h"
+#include "MLR_PeerTable.h"
+
+#ifndef MLR_LINKSTATS_PEERS
+/**
+ * @brief Maximum number of peers tracked. The least recently heard peer is evicted when full.
+ */
+#define MLR_LINKSTATS_PEERS 16
+#endif
+
+/**
+ * @brief Number of sequence numbers covered by the rolling packet error rate.
+ */
+static constexpr uint8_t MLR_LINKSTATS_PER_WINDOW = 64;
+
+/**
+ * \brief Link statistics of one peer.
+ */
+struct MLR_LinkStatsEntry
+{
+    uint8_t id;          //!< Equipment ID of the peer
+    uint8_t lastSeq;     //!< Highest sequence number received
+    uint8_t windowLen;   //!< Number of sequence numbers in window (up to MLR_LINKSTATS_PER_WINDOW)
+    uint64_t window;     //!< Bit n: frame lastSeq - n was received
+    uint32_t received;   //!< Frames received (without duplicates)
+    uint32_t missed;     //!< Frames missing in the sequence (corrected when a late frame arrives)
+    uint32_t duplicates; //!< Frames received more than once
+    uint32_t restarts;   //!< Sequence restarts of the peer (e.g. after a reset)
+    uint32_t rssiCount;  //!< Number of RSSI samples
+    float rssiMean;      //!< Mean RSSI in dBm
+    float rssiM2;        //!< Sum of squared RSSI deviations (Welford), see GetRssiVariance()
+    uint32_t firstSeen;  //!< millis() timestamp of the first frame
+    uint32_t lastSeen;   //!< millis() timestamp of the last frame
+
+    /**
+     * \brief Gets the packet error rate over the last MLR_LINKSTATS_PER_WINDOW sequence numbers.
+     * \return Packet error rate in permille.
+     */
+    uint16_t GetPer() const;
+
+    /**
+     * \brief Gets the variance of the RSSI in dBm^2 (0 with less than two samples).
+     */
+    float GetRssiVariance() const { return (rssiCount > 1) ? rssiM2 / (rssiCount - 1) : 0.0f; }
+};
+
+/**
+ * \brief Table of per-peer link statistics.
+ */
+class MLR_LinkStats : public MLR_ModemRxHook
+{
+public:
+    /**
+     * \brief Registers the statistics with the driver.
+     * \param modem The initialized modem driver.
+     * \return MLR_Modem_Error::Ok on success.
+     * \note Enable MLR_Modem::SetRssiEnrichment() to collect RSSI statistics. The statistics are inserted in
+     *       front of the registered hooks; call begin() after MLR_DuplicateFilter::begin() to count duplicates.
+     */
+    MLR_Modem_Error begin(MLR_Modem &modem);
+
+    /**
+     * \brief Unregisters the statistics from the driver.
+     */
+    void end();
+
+    /**
+     * \brief Looks up the statistics of a peer.
+     * \param id The Equipment ID.
+     * \return Pointer to the entry, or nullptr if the peer is unknown.
+     */
+    const MLR_LinkStatsEntry *Find(uint8_t id) const { return m_table.Find(id); }
+
+    /**
+     * \brief Gets the number of known peers.
+     */
+    uint8_t GetCount() const { return m_table.GetCount(); }
+
+    /**
+     * \brief Gets the statistics of a peer by table index.
+     * \param idx Index (0 to GetCount() - 1).
+     * \return Pointer to the entry, or nullptr if idx is out of range.
+     */
+    const MLR_LinkStatsEntry *GetEntry(uint8_t idx) const { return m_table.GetEntry(idx); }
+
+    /**
+     * \brief Removes all peers.
+     */
+    void Clear() { m_table.Clear(); }
+
+    //! Receive hook: updates the statistics from framed packets
+    MLR_ModemRxAction OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi) override;
+
+private:
+    //! Internal: Accounts a sequence number, returns false for a duplicate
+    static bool m_TrackSequence(MLR_LinkStatsEntry *pEntry, uint8_t seq);
+
+    MLR_Modem *m_pModem = nullptr;                     //!< Driver the statistics are registered with
+    MLR_PeerTable<MLR_LinkStatsEntry, MLR_LINKSTATS_PEERS> m_table; //!< Peer entries
+};
@@ -0,0 +1,311 @@
+//
+// MLR_MetricsExporter.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Prometheus metrics of the driver counters in the text exposition format.
+// See https://prometheus.io/docs/instrumenting/exposition_formats/
+//
+
+#include "MLR_MetricsExporter.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+//! A counter of MLR_ModemStats
+struct MLR_MetricsCounter
+{
+    const char *pName;   //!< Metric name
+    const char *pHelp;   //!< Help text
+    size_t offset;       //!< Offset of the uint32_t counter in MLR_ModemStats
+};
+
+static const MLR_MetricsCounter s_counters[] = {
+    {"mlr_rx_frames_total", "Received radio packets.", offsetof(MLR_ModemStats, rxFrames)},
+    {"mlr_rx_bytes_total", "Payload bytes of the received radio packets.", offsetof(MLR_ModemStats, rxBytes)},
+    {"mlr_tx_frames_total", "Packets accepted by the modem for transmission.", offsetof(MLR_ModemStats, txFrames)},
+    {"mlr_tx_bytes_total", "Payload bytes of the packets accepted for transmission.", offsetof(MLR_ModemStats, txBytes)},
+    {"mlr_lbt_failures_total", "Transmissions rejected by carrier sense.", offsetof(MLR_ModemStats, lbtFails)},
+    {"mlr_parser_errors_total", "Garbage or overflows on the modem serial line.", offsetof(MLR_ModemStats, parserErrors)},
+    {"mlr_commands_total", "Commands sent to the modem.", offsetof(MLR_ModemStats, commands)},
+    {"mlr_command_timeouts_total", "Commands the modem did not answer.", offsetof(MLR_ModemStats, commandTimeouts)},
+};
+
+static constexpr char MLR_METRICS_LATENCY_NAME[] = "mlr_command_latency_seconds";
+
+void MLR_MetricsExporter::begin(const MLR_Modem &modem, const char *pLabels)
+{
+    m_pModem = &modem;
+    m_pLabels = (pLabels && pLabels[0]) ? pLabels : nullptr;
+}
+
+size_t MLR_MetricsExporter::Render(Print &out) const
+{
+    if (!m_pModem)
+    {
+        return 0;
+    }
+
+    MLR_ModemStats stats;
+    m_pModem->GetStats(&stats);
+
+    char line[128];
+    size_t written = 0;
+    for (const MLR_MetricsCounter &counter : s_counters)
+    {
+        uint32_t value;
+        memcpy(&value, reinterpret_cast<const uint8_t *>(&stats) + counter.offset, sizeof(value));
+
+        snprintf(line, sizeof(line), "# HELP %s %s\n# TYPE %s counter\n", counter.pName, counter.pHelp, counter.pName);
+        written += out.print(line);
+        written += out.print(counter.pName);
+        written += m_WriteLabels(out, nullptr);
+        snprintf(line, sizeof(line), " %lu\n", static_cast<unsigned long>(value));
+        written += out.print(line);
+    }
+
+    snprintf(line, sizeof(line), "# HELP %s Time from a command to its first response.\n# TYPE %s histogram\n",
+             MLR_METRICS_LATENCY_NAME, MLR_METRICS_LATENCY_NAME);
+    written += out.print(line);
+
+    // buckets are cumulative in the exposition format
+    uint32_t count = 0;
+    for (uint8_t i = 0; i < MLR_STATS_LATENCY_BUCKETS; ++i)
+    {
+        count += stats.latencyBuckets[i];
+
+        char le[12];
+        if (i < MLR_STATS_LATENCY_BUCKETS - 1)
+        {
+            snprintf(le, sizeof(le), "%u.%03u", MLR_STATS_LATENCY_BOUNDS_MS[i] / 1000U, MLR_STATS_LATENCY_BOUNDS_MS[i] % 1000U);
+        }
+        else
+        {
+            strcpy(le, "+Inf");
+        }
+        written += out.print(MLR_METRICS_LATENCY_NAME);
+        written += out.print("_bucket");
+        written += m_WriteLabels(out, le);
+        snprintf(line, sizeof(line), " %lu\n", static_cast<unsigned long>(count));
+        written += out.print(line);
+    }
+
+    written += out.print(MLR_METRICS_LATENCY_NAME);
+    written += out.print("_sum");
+    written += m_WriteLabels(out, nullptr);
+    snprintf(line, sizeof(line), " %lu.%06lu\n", static_cast<unsigned long>(stats.latencySumUs / 1000000ULL),
+             static_cast<unsigned long>(stats.latencySumUs % 1000000ULL));
+    written += out.print(line);
+
+    written += out.print(MLR_METRICS_LATENCY_NAME);
+    written += out.print("_count");
+    written += m_WriteLabels(out, nullptr);
+    snprintf(line, sizeof(line), " %lu\n", static_cast<unsigned long>(count));
+    written += out.print(line);
+
+    return written;
+}
+
+size_t MLR_MetricsExporter::m_WriteLabels(Print &out, const char *pLe) const
+{
+    if (!m_pLabels && !pLe)
+    {
+        return 0;
+    }
+
+    size_t written = out.print('{');
+    if (m_pLabels)
+    {
+        written += out.print(m_pLabels);
+    }
+    if (pLe)
+    {
+        written += out.print(m_pLabels ? ",le=\"" : "le=\"");
+        written += out.print(pLe);
+        written += out.print('"');
+    }
+    written += out.print('}');
+    return written;
+}
+
+#if defined(__linux__)
+
+//! Print to a file descriptor, buffered so that a scrape is sent in few segments
+class MLR_MetricsFdPrint : public Print
+{
+public:
+    MLR_MetricsFdPrint(int fd, bool socket) : m_fd(fd), m_socket(socket) {}
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+
+    size_t write(const uint8_t *pData, size_t len) override
+    {
+        if (m_len + len > sizeof(m_buffer) && !m_Flush())
+        {
+            return 0;
+        }
+        if (len > sizeof(m_buffer))
+        {
+            return m_Send(pData, len) ? len : 0;
+        }
+        memcpy(&m_buffer[m_len], pData, len);
+        m_len += len;
+        return len;
+    }
+
+    //! Writes the buffered bytes, returns false if an error occurred so far
+    bool Finish() { return m_Flush() && !m_failed; }
+
+private:
+    bool m_Flush()
+    {
+        bool ok = m_Send(m_buffer, m_len);
+        m_len = 0;
+        return ok;
+    }
+
+    bool m_Send(const uint8_t *pData, size_t len)
+    {
+        while (len > 0 && !m_failed)
+        {
+            // a scraper that hangs up must not raise SIGPIPE
+            ssize_t n = m_socket ? send(m_fd, pData, len, MSG_NOSIGNAL) : ::write(m_fd, pData, len);
+            if (n <= 0)
+            {
+                m_failed = true;
+                break;
+            }
+            pData += n;
+            len -= static_cast<size_t>(n);
+        }
+        return !m_failed;
+    }
+
+    int m_fd;              //!< Output file descriptor
+    bool m_socket;         //!< m_fd is a socket
+    bool m_failed = false; //!< A write failed
+    size_t m_len = 0;      //!< Bytes in m_buffer
+    uint8_t m_buffer[1024];
+};
+
+MLR_Modem_Error MLR_MetricsExporter::WriteFile(const char *pPath) const
+{
+    char tmpPath[256];
+    if (!m_pModem || snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", pPath) >= static_cast<int>(sizeof(tmpPath)))
+    {
+        return MLR_Modem_Error::Fail;
+    }
+
+    int fd = open(tmpPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return MLR_Modem_Error::Fail;
+    }
+    MLR_MetricsFdPrint out(fd, false);
+    Render(out);
+    bool ok = out.Finish();
+    ok = (close(fd) == 0) && ok;
+
+    if (!ok || rename(tmpPath, pPath) != 0)
+    {
+        unlink(tmpPath);
+        return MLR_Modem_Error::Fail;
+    }
+    return MLR_Modem_Error::Ok;
+}
+
+MLR_Modem_Error MLR_MetricsExporter::Listen(uint16_t port, const char *pAddress)
+{
+    Close();
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, pAddress, &addr.sin_addr) != 1)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return MLR_Modem_Error::Fail;
+    }
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (bind(fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) != 0 || listen(fd, 4) != 0)
+    {
+        close(fd);
+        return MLR_Modem_Error::Fail;
+    }
+    m_listenFd = fd;
+    return MLR_Modem_Error::Ok;
+}
+
+uint32_t MLR_MetricsExporter::Work(uint32_t timeoutMs)
+{
+    if (m_listenFd < 0)
+    {
+        return 0;
+    }
+
+    pollfd pfd = {m_listenFd, POLLIN, 0};
+    if (poll(&pfd, 1, static_cast<int>(timeoutMs)) <= 0)
+    {
+        return 0;
+    }
+
+    uint32_t served = 0;
+    int fd;
+    while ((fd = accept4(m_listenFd, nullptr, nullptr, SOCK_CLOEXEC)) >= 0)
+    {
+        // read the request header; its content does not matter
+        char request[512];
+        size_t len = 0;
+        pollfd cfd = {fd, POLLIN, 0};
+        while (len < sizeof(request) - 1 && poll(&cfd, 1, 100) > 0)
+        {
+            ssize_t n = recv(fd, &request[len], sizeof(request) - 1 - len, 0);
+            if (n <= 0)
+            {
+                break;
+            }
+            len += static_cast<size_t>(n);
+            request[len] = '\0';
+            if (strstr(request, "\r\n\r\n"))
+            {
+                break;
+            }
+        }
+
+        MLR_MetricsFdPrint out(fd, true);
+        out.print("HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nConnection: close\r\n\r\n");
+        Render(out);
+        if (out.Finish())
+        {
+            ++served;
+        }
+        shutdown(fd, SHUT_WR);
+        close(fd);
+    }
+    return served;
+}
+
+void MLR_MetricsExporter::Close()
+{
+    if (m_listenFd >= 0)
+    {
+        close(m_listenFd);
+        m_listenFd = -1;
+    }
+}
+
+#endif
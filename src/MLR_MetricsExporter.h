@@ -0,0 +1,87 @@
+//
+// MLR_MetricsExporter.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Prometheus metrics of the driver counters (MLR_ModemStats) in the text exposition format.
+// The counters are read with MLR_Modem::GetStats(), which never blocks the driver, so a scrape can run
+// in its own thread while another thread calls MLR_Modem::Work().
+// Render() writes the metrics to any Print and works on every platform. On a Linux host gateway the
+// metrics can also be written to a file for the node_exporter textfile collector (WriteFile()), or
+// served over HTTP on a local TCP port for Prometheus to scrape (Listen() and Work()).
+//
+// Exported metrics (all with the labels given to begin()):
+//   mlr_rx_frames_total, mlr_rx_bytes_total, mlr_tx_frames_total, mlr_tx_bytes_total,
+//   mlr_lbt_failures_total, mlr_parser_errors_total, mlr_commands_total, mlr_command_timeouts_total,
+//   mlr_command_latency_seconds (histogram, buckets MLR_STATS_LATENCY_BOUNDS_MS)
+
+#pragma once
+#include "MLR_Modem.h"
+
+/**
+ * \brief Exporter of the driver counters in the Prometheus text format.
+ */
+class MLR_MetricsExporter
+{
+public:
+#if defined(__linux__)
+    ~MLR_MetricsExporter() { Close(); }
+#endif
+
+    /**
+     * \brief Selects the driver whose counters are exported.
+     * \param modem The modem driver.
+     * \param pLabels Labels added to every metric without braces, e.g. "port=\"ttyUSB0\"", or nullptr.
+     *                The string must stay valid while the exporter is used.
+     */
+    void begin(const MLR_Modem &modem, const char *pLabels = nullptr);
+
+    /**
+     * \brief Writes a snapshot of the counters.
+     * \param out Output for the metrics.
+     * \return Number of bytes written.
+     */
+    size_t Render(Print &out) const;
+
+#if defined(__linux__)
+    /**
+     * \brief Writes a snapshot of the counters to a file.
+     * The metrics are written to "<path>.tmp" first and then renamed, so a reader never sees a partial file.
+     * \param pPath Path of the file, e.g. "/var/lib/node_exporter/textfile/mlr.prom".
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::Fail on I/O errors.
+     */
+    MLR_Modem_Error WriteFile(const char *pPath) const;
+
+    /**
+     * \brief Opens a TCP port for scraping over HTTP.
+     * \param port The TCP port, e.g. 9429.
+     * \param pAddress Local address to listen on. The default accepts connections from the same host only.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::InvalidArg if the address is not an IPv4 address,
+     *         MLR_Modem_Error::Fail if the port cannot be opened.
+     */
+    MLR_Modem_Error Listen(uint16_t port, const char *pAddress = "127.0.0.1");
+
+    /**
+     * \brief Answers pending scrapes. Every request on the port gets the metrics, regardless of the path.
+     * This function must be called regularly, e.g. in a loop of its own thread.
+     * \param timeoutMs Time to wait for a connection. With 0 the call returns immediately if none is pending.
+     * \return Number of answered scrapes.
+     * \note A client that connected is given up to 100 ms to send its request.
+     */
+    uint32_t Work(uint32_t timeoutMs = 0);
+
+    /**
+     * \brief Closes the TCP port.
+     */
+    void Close();
+#endif
+
+private:
+    //! Internal: Writes the label set, optionally with an additional "le" label
+    size_t m_WriteLabels(Print &out, const char *pLe) const;
+
+    const MLR_Modem *m_pModem = nullptr;                   //!< Driver whose counters are exported
+    const char *m_pLabels = nullptr;                       //!< Labels of every metric, or nullptr
+#if defined(__linux__)
+    int m_listenFd = -1;                                   //!< Listening socket, or -1
+#endif
+};
@@ -185,14 +185,7 @@ static bool s_ParseDec(const uint8_t *pData, uint8_t len, uint32_t *pResult)
 
 MLR_Modem_Error MLR_Modem::begin(Stream &pUart, MLR_Modem_AsyncCallback pCallback)
 {
-    m_asyncExpectedResponse = MLR_Modem_Response::Idle;
-    m_pCallback = pCallback;
-    m_pUart = &pUart;
-    m_rxIdx = 0;
-    m_parserState = MLR_ModemParserState::Start;
-    m_drMessagePresent = false;
-    m_drMessageLen = 0;
-    m_ResetParser();
+    m_Attach(pUart, pCallback);
 
     MLR_DEBUG_PRINTLN("[MLR Modem] begin: Getting current mode...");
     MLR_Modem_Error err = GetMode(&m_mode); // Get and cache the current mode
@@ -262,12 +255,22 @@ MLR_Modem_Error MLR_Modem::GetSpreadFactor(MLR_ModemSpreadFactor *pSf)
 
 MLR_Modem_Error MLR_Modem::SetEquipmentID(uint8_t ei, bool saveValue)
 {
-    return m_SetByteValue(MLR_CMD_EQUIPMENT_ID, ei, saveValue, MLR_SET_EQUIPMENT_RESPONSE_PREFIX, MLR_SET_EQUIPMENT_RESPONSE_LEN);
+    MLR_Modem_Error rv = m_SetByteValue(MLR_CMD_EQUIPMENT_ID, ei, saveValue, MLR_SET_EQUIPMENT_RESPONSE_PREFIX, MLR_SET_EQUIPMENT_RESPONSE_LEN);
+    if (rv == MLR_Modem_Error::Ok)
+    {
+        m_equipmentId = ei;
+    }
+    return rv;
 }
 
 MLR_Modem_Error MLR_Modem::GetEquipmentID(uint8_t *pEI)
 {
-    return m_GetByteValue(MLR_CMD_EQUIPMENT_ID, pEI, MLR_SET_EQUIPMENT_RESPONSE_PREFIX, MLR_SET_EQUIPMENT_RESPONSE_LEN);
+    MLR_Modem_Error rv = m_GetByteValue(MLR_CMD_EQUIPMENT_ID, pEI, MLR_SET_EQUIPMENT_RESPONSE_PREFIX, MLR_SET_EQUIPMENT_RESPONSE_LEN);
+    if (rv == MLR_Modem_Error::Ok)
+    {
+        m_equipmentId = *pEI;
+    }
+    return rv;
 }
 
 MLR_Modem_Error MLR_Modem::SetDestinationID(uint8_t di, bool saveValue)
@@ -503,6 +506,11 @@ MLR_Modem_Error MLR_Modem::TransmitData(const uint8_t *pMsg, uint8_t len)
         rv = MLR_Modem_Error::Fail;
     }
 
+    if (rv == MLR_Modem_Error::Ok)
+    {
+        m_NotifyTransmitted(pMsg, len);
+    }
+
     // check information response
     if (rv == MLR_Modem_Error::Ok)
     {
@@ -573,6 +581,13 @@ MLR_Modem_Error MLR_Modem::TransmitData(const uint8_t *pMsg, uint8_t len)
         }
     }
 
+    if (rv == MLR_Modem_Error::FailLbt)
+    {
+        m_StatsBegin();
+        ++m_stats.lbtFails;
+        m_StatsEnd();
+    }
+
     return rv;
 }
 
@@ -609,12 +624,43 @@ MLR_Modem_Error MLR_Modem::TransmitDataFireAndForget(const uint8_t *pMsg, uint8_
 
     if (rv == MLR_Modem_Error::Ok)
     {
+        m_NotifyTransmitted(pMsg, len);
         m_asyncExpectedResponse = MLR_Modem_Response::MLR_Modem_DtIr;
     }
 
     return rv;
 }
 
+MLR_Modem_Error MLR_Modem::TransmitFrame(MLR_FrameType type, const uint8_t *pMsg, uint8_t len)
+{
+    if ((len > MLR_FRAME_MAX_PAYLOAD_LEN) || (len > 0 && !pMsg))
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    if (m_equipmentId < 0)
+    {
+        uint8_t ei{};
+        MLR_Modem_Error rv = GetEquipmentID(&ei);
+        if (rv != MLR_Modem_Error::Ok)
+        {
+            return rv;
+        }
+    }
+
+    std::array<uint8_t, MLR_MAX_PAYLOAD_LEN> frame;
+    MLR_FrameHeader header{type, static_cast<uint8_t>(m_equipmentId), m_frameSeq};
+    MLR_Frame_WriteHeader(frame.data(), header);
+    if (len > 0)
+    {
+        memcpy(&frame[MLR_FRAME_HEADER_LEN], pMsg, len);
+    }
+
+    // the sequence number advances even if LBT fails, so receivers see the attempt as a loss
+    ++m_frameSeq;
+    return TransmitData(frame.data(), MLR_FRAME_HEADER_LEN + len);
+}
+
 MLR_Modem_Error MLR_Modem::GetRssiCurrentChannelAsync()
 {
     if (m_asyncExpectedResponse != MLR_Modem_Response::Idle)
@@ -646,11 +692,28 @@ MLR_Modem_Error MLR_Modem::GetSerialNumberAsync()
     return MLR_Modem_Error::Ok;
 }
 
+void MLR_Modem::DeletePacket()
+{
+    m_drMessagePresent = false;
+    if (m_parserState != MLR_ModemParserState::RadioDrPayload)
+    {
+        MLR_PacketPool::Release(m_pDrPacket);
+        m_pDrPacket = nullptr;
+        m_pDrBuffer = m_drMessage;
+    }
+}
+
+void MLR_Modem::SetPacketPool(MLR_PacketPool *pPool)
+{
+    DeletePacket();
+    m_pPacketPool = pPool;
+}
+
 MLR_Modem_Error MLR_Modem::GetPacket(const uint8_t **ppData, uint8_t *len)
 {
     if (m_drMessagePresent)
     {
-        *ppData = &m_drMessage[0];
+        *ppData = m_pDrBuffer;
         *len = m_drMessageLen;
         return MLR_Modem_Error::Ok;
     }
@@ -658,8 +721,176 @@ MLR_Modem_Error MLR_Modem::GetPacket(const uint8_t **ppData, uint8_t *len)
         return MLR_Modem_Error::Fail;
 }
 
+MLR_Modem_Error MLR_Modem::GetPacket(const uint8_t **ppData, uint8_t *len, int16_t *pRssi)
+{
+    MLR_Modem_Error rv = GetPacket(ppData, len);
+    if (rv == MLR_Modem_Error::Ok && pRssi)
+    {
+        *pRssi = m_drRssi;
+    }
+    return rv;
+}
+
+void MLR_Modem::AddRxHook(MLR_ModemRxHook *pHook, bool first)
+{
+    if (!pHook)
+    {
+        return;
+    }
+
+    RemoveRxHook(pHook); // never link a hook twice
+
+    MLR_ModemRxHook **ppLink = &m_pRxHooks;
+    while (!first && *ppLink)
+    {
+        ppLink = &(*ppLink)->m_pNextHook;
+    }
+    pHook->m_pNextHook = *ppLink;
+    *ppLink = pHook;
+}
+
+void MLR_Modem::RemoveRxHook(MLR_ModemRxHook *pHook)
+{
+    MLR_ModemRxHook **ppLink = &m_pRxHooks;
+    while (*ppLink)
+    {
+        if (*ppLink == pHook)
+        {
+            *ppLink = pHook->m_pNextHook;
+            pHook->m_pNextHook = nullptr;
+            return;
+        }
+        ppLink = &(*ppLink)->m_pNextHook;
+    }
+}
+
+void MLR_Modem::m_NotifyTransmitted(const uint8_t *pMsg, uint8_t len)
+{
+    m_StatsBegin();
+    ++m_stats.txFrames;
+    m_stats.txBytes += len;
+    m_StatsEnd();
+
+    MLR_PROFILE_SCOPE(MLR_ProfileSite::TxHooks);
+    for (MLR_ModemRxHook *pHook = m_pRxHooks; pHook; pHook = pHook->m_pNextHook)
+    {
+        pHook->OnFrameTransmitted(pMsg, len);
+    }
+}
+
+void MLR_Modem::m_InvokeCallback(MLR_Modem_Error error, MLR_Modem_Response responseType, int32_t value, const uint8_t *pPayload, uint16_t len)
+{
+    MLR_PROFILE_SCOPE(MLR_ProfileSite::UserCallback);
+    m_pCallback(error, responseType, value, pPayload, len);
+}
+
+void MLR_Modem::m_InvokeStreamCallback(MLR_ModemStreamEvent event, const uint8_t *pData, uint8_t len)
+{
+    MLR_PROFILE_SCOPE(MLR_ProfileSite::StreamCallback);
+    m_pStreamCallback(event, pData, len);
+}
+
+void MLR_Modem::GetStats(MLR_ModemStats *pStats) const
+{
+#if defined(__AVR__)
+    // single core without lock-free atomics; the driver is never preempted by a reader
+    *pStats = m_stats;
+#else
+    uint32_t seq;
+    do
+    {
+        seq = __atomic_load_n(&m_statsSeq, __ATOMIC_ACQUIRE);
+        memcpy(pStats, &m_stats, sizeof(*pStats));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((seq & 1) || seq != __atomic_load_n(&m_statsSeq, __ATOMIC_RELAXED));
+#endif
+}
+
+void MLR_Modem::m_StatsBegin()
+{
+#if !defined(__AVR__)
+    __atomic_store_n(&m_statsSeq, m_statsSeq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+#endif
+}
+
+void MLR_Modem::m_StatsEnd()
+{
+#if !defined(__AVR__)
+    __atomic_store_n(&m_statsSeq, m_statsSeq + 1, __ATOMIC_RELEASE);
+#endif
+}
+
+void MLR_Modem::m_CountParserError()
+{
+    m_StatsBegin();
+    ++m_stats.parserErrors;
+    m_StatsEnd();
+}
+
+void MLR_Modem::m_CountResponse()
+{
+    if (!m_cmdPending)
+    {
+        return; // further responses ("*IR", "*WR" follow-ups) or unsolicited lines
+    }
+    m_cmdPending = false;
+
+    uint32_t latencyUs = micros() - m_cmdSentAt;
+    uint8_t bucket = 0;
+    while (bucket < MLR_STATS_LATENCY_BUCKETS - 1 && latencyUs > MLR_STATS_LATENCY_BOUNDS_MS[bucket] * 1000UL)
+    {
+        ++bucket;
+    }
+
+    m_StatsBegin();
+    ++m_stats.latencyBuckets[bucket];
+    m_stats.latencySumUs += latencyUs;
+    m_StatsEnd();
+}
+
+#ifdef ENABLE_MLR_MODEM_PROFILE
+static_assert(static_cast<uint8_t>(MLR_ProfileSite::ParseCmdUntilLF) - static_cast<uint8_t>(MLR_ProfileSite::ParseStart) ==
+                  static_cast<uint8_t>(MLR_ModemParserState::ReadCmdUntilLF),
+              "one profile site per parser state");
+
+void MLR_Modem::ResetProfile()
+{
+    memset(m_profile, 0, sizeof(m_profile));
+}
+
+void MLR_Modem::PrintProfile(Print &out) const
+{
+    static const char *const s_siteNames[MLR_PROFILE_SITES] = {
+        "Work", "ParseStart", "ParseCmdFirstLetter", "ParseCmdSecondLetter", "ParseCmdParam", "ParseRawString",
+        "ParseDrSize", "ParseDrPayload", "ParseCmdUntilCR", "ParseCmdUntilLF", "FlushGarbage", "DispatchResponse",
+        "HandleDr", "RxHooks", "TxHooks", "UserCallback", "StreamCallback",
+    };
+
+    char line[96];
+    uint32_t ticksPerUs = MLR_ProfileTicksPerUs();
+    snprintf(line, sizeof(line), "%-21s %10s %12s %10s %10s  (%lu ticks/us)\n", "site", "calls", "total_us", "avg_ticks",
+             "max_ticks", static_cast<unsigned long>(ticksPerUs));
+    out.print(line);
+    for (uint8_t i = 0; i < MLR_PROFILE_SITES; ++i)
+    {
+        const MLR_ProfileEntry &entry = m_profile[i];
+        if (entry.calls == 0)
+        {
+            continue;
+        }
+        snprintf(line, sizeof(line), "%-21s %10lu %12lu %10lu %10lu\n", s_siteNames[i], static_cast<unsigned long>(entry.calls),
+                 static_cast<unsigned long>(entry.ticks / ticksPerUs), static_cast<unsigned long>(entry.ticks / entry.calls),
+                 static_cast<unsigned long>(entry.maxTicks));
+        out.print(line);
+    }
+}
+#endif
+
 void MLR_Modem::Work()
 {
+    MLR_PROFILE_SCOPE(MLR_ProfileSite::Work);
+
     switch (m_Parse())
     {
     case MLR_ModemCmdState::Parsing:
@@ -668,6 +899,7 @@ void MLR_Modem::Work()
 
     case MLR_ModemCmdState::Garbage:
         MLR_DEBUG_PRINTLN("[MLR Work] Work: Parser encountered garbage.");
+        m_CountParserError();
         if (m_pCallback)
         {
             // Garbage
@@ -675,6 +907,7 @@ void MLR_Modem::Work()
         break;
     case MLR_ModemCmdState::Overflow:
         MLR_DEBUG_PRINTLN("[MLR Work] Work: Parser encountered overflow.");
+        m_CountParserError();
         if (m_pCallback)
         {
             // Overflow
@@ -682,15 +915,15 @@ void MLR_Modem::Work()
         break;
     case MLR_ModemCmdState::FinishedCmdResponse:
         MLR_DEBUG_PRINTF("[MLR Work] Work: Finished CMD response, dispatching async.\n");
-        m_DispatchCmdResponseAsync();
+        m_CountResponse();
+        if (!m_SkipStaleRssiReply())
+        {
+            m_DispatchCmdResponseAsync();
+        }
         break;
     case MLR_ModemCmdState::FinishedDrResponse:
         MLR_DEBUG_PRINTF("[MLR Work] Work: Finished DR response (Len=%u). Calling callback.\n", m_drMessageLen);
-        if (m_pCallback)
-        {
-            // FinishedDrResponse
-            m_pCallback(MLR_Modem_Error::Ok, MLR_Modem_Response::DataReceived, 0, &m_drMessage[0], m_drMessageLen);
-        }
+        m_HandleDrResponse(true);
         break;
     default:
         MLR_DEBUG_PRINTLN(""); // Final newline for RX log
@@ -708,6 +941,15 @@ void MLR_Modem::m_WriteString(const char *pString, bool printPrefix)
     MLR_DEBUG_WRITE(reinterpret_cast<const uint8_t *>(pString), len);
     m_pUart->write(reinterpret_cast<const uint8_t *>(pString), len);
     m_debugRxNewLine = true;
+
+    if (pString[0] == '@')
+    {
+        m_StatsBegin();
+        ++m_stats.commands;
+        m_StatsEnd();
+        m_cmdSentAt = micros();
+        m_cmdPending = true;
+    }
 }
 
 void MLR_Modem::m_WriteData(const uint8_t *pData, uint8_t len)
@@ -810,6 +1052,29 @@ uint32_t MLR_Modem::m_Read(uint8_t *pDst, uint32_t count)
     return m_pUart->readBytes(pDst, count);
 }
 
+void MLR_Modem::m_Attach(Stream &uart, MLR_Modem_AsyncCallback pCallback)
+{
+    m_asyncExpectedResponse = MLR_Modem_Response::Idle;
+    m_pCallback = pCallback;
+    m_pUart = &uart;
+    m_rxIdx = 0;
+    m_parserState = MLR_ModemParserState::Start;
+    m_drMessagePresent = false;
+    m_drMessageLen = 0;
+    m_drRssi = MLR_RSSI_UNKNOWN;
+    m_drHold = false;
+    m_staleRssiReply = false;
+    m_cmdPending = false;
+    m_StatsBegin();
+    memset(&m_stats, 0, sizeof(m_stats));
+    m_StatsEnd();
+#ifdef ENABLE_MLR_MODEM_PROFILE
+    MLR_ProfileInit();
+    ResetProfile();
+#endif
+    m_ResetParser();
+}
+
 void MLR_Modem::m_ResetParser()
 {
     m_parserState = MLR_ModemParserState::Start;
@@ -824,12 +1089,14 @@ void MLR_Modem::m_ClearOneLine()
 
 void MLR_Modem::m_FlushGarbage()
 {
+    MLR_PROFILE_SCOPE(MLR_ProfileSite::FlushGarbage);
     MLR_DEBUG_PRINT("[MLR Flush]: Flushing garbage... ");
     // remove all remaining garbage from the pipeline, except '*' implies a valid message will follow
     // don't care about special cases
+    // bounded, so that a noisy line cannot keep the caller in here; the Start state discards the rest
     if (m_oneByteBuf == -1)
     {
-        while (m_pUart->available())
+        for (uint16_t n = 0; n < MLR_FLUSH_MAX_BYTES && m_pUart->available(); ++n)
         {
             if ('*' == m_ReadByte())
             {
@@ -839,14 +1106,37 @@ void MLR_Modem::m_FlushGarbage()
             }
         }
     }
+    if (m_drStreaming)
+    {
+        m_drStreaming = false;
+        m_InvokeStreamCallback(MLR_ModemStreamEvent::Abort, nullptr, 0);
+    }
     m_parserState = MLR_ModemParserState::Start;
     MLR_DEBUG_PRINTLN(" Flushed & Reset.");
 }
 
+void MLR_Modem::m_StreamChunk()
+{
+    uint8_t len = static_cast<uint8_t>(m_rxIdx - m_drStreamed);
+    m_InvokeStreamCallback(MLR_ModemStreamEvent::Chunk, &m_pDrBuffer[m_drStreamed], len);
+    m_drStreamed = m_rxIdx;
+}
+
 MLR_ModemCmdState MLR_Modem::m_Parse()
 {
+    // a truncated telegram or a corrupted length would otherwise swallow the following responses
+    if ((m_parserState == MLR_ModemParserState::RadioDrSize || m_parserState == MLR_ModemParserState::RadioDrPayload) &&
+        !m_pUart->available() && millis() - m_drByteAt > MLR_DR_BYTE_TIMEOUT_MS)
+    {
+        MLR_DEBUG_PRINTLN("\n[MLR Parse]: *DR telegram timed out.");
+        m_FlushGarbage();
+        return MLR_ModemCmdState::Garbage;
+    }
+
     while (m_pUart->available())
     {
+        MLR_PROFILE_SCOPE(static_cast<uint8_t>(MLR_ProfileSite::ParseStart) + static_cast<uint8_t>(m_parserState));
+
         switch (m_parserState)
         {
         case MLR_ModemParserState::Start:
@@ -922,6 +1212,7 @@ MLR_ModemCmdState MLR_Modem::m_Parse()
             {
                 // @DR telegram
                 ++m_rxIdx;
+                m_drByteAt = millis();
                 m_parserState = MLR_ModemParserState::RadioDrSize;
             }
             else if (isupper(m_rxMessage[1]) && isupper(m_rxMessage[2]) && (m_rxMessage[3] == '='))
@@ -942,22 +1233,44 @@ MLR_ModemCmdState MLR_Modem::m_Parse()
             break;
 
         case MLR_ModemParserState::RadioDrSize:
-            m_rxMessage[m_rxIdx] = m_ReadByte();
-            ++m_rxIdx;
-            if (m_rxIdx < 6)
+            if (m_rxIdx < 6) // the size is already complete when resuming a deferred telegram
             {
-                // parser cannot continue until there are at least two characters
-                return MLR_ModemCmdState::Parsing;
+                m_rxMessage[m_rxIdx] = m_ReadByte();
+                ++m_rxIdx;
+                m_drByteAt = millis();
+                if (m_rxIdx < 6)
+                {
+                    // parser cannot continue until there are at least two characters
+                    break;
+                }
             }
 
             if (isxdigit(m_rxMessage[4]) && isxdigit(m_rxMessage[5]))
             {
+                if (m_drHold)
+                {
+                    // the payload would overwrite the held packet; resume here once it is delivered
+                    return MLR_ModemCmdState::DrDeferred;
+                }
                 m_drMessagePresent = false;
+
+                // the driver's reference on the previous packet ends here, consumers may still hold theirs
+                MLR_PacketPool::Release(m_pDrPacket);
+                m_pDrPacket = m_pPacketPool ? m_pPacketPool->Alloc() : nullptr;
+                m_pDrBuffer = m_pDrPacket ? m_pDrPacket->data : m_drMessage;
+
                 uint32_t msgLen = 0;
                 s_ParseHex(&m_rxMessage[4], 2, &msgLen);
                 m_drMessageLen = msgLen;
-                m_rxIdx = 0; // now m_rxIdx to m_drMessage Buffer
+                m_rxIdx = 0; // now m_rxIdx to m_pDrBuffer
                 m_parserState = MLR_ModemParserState::RadioDrPayload;
+
+                m_drStreamed = 0;
+                m_drStreaming = (m_pStreamCallback != nullptr);
+                if (m_drStreaming)
+                {
+                    m_InvokeStreamCallback(MLR_ModemStreamEvent::Begin, nullptr, m_drMessageLen);
+                }
             }
             else
             {
@@ -971,14 +1284,32 @@ MLR_ModemCmdState MLR_Modem::m_Parse()
             // example DR:
             // *DR=05hallo\r\n
 
-            m_drMessage[m_rxIdx] = m_ReadByte();
+            m_pDrBuffer[m_rxIdx] = m_ReadByte();
             ++m_rxIdx;
+            m_drByteAt = millis();
+
+            // cut-through: hand out full chunks and the tail of the payload before CR/LF has arrived
+            if (m_drStreaming && m_rxIdx <= m_drMessageLen &&
+                (m_rxIdx - m_drStreamed >= m_streamChunkLen || m_rxIdx == m_drMessageLen))
+            {
+                m_StreamChunk();
+            }
 
             if ((m_drMessageLen + 2 - m_rxIdx) == 0)
             {
-                if ((m_drMessage[m_rxIdx - 2] == '\r') && m_drMessage[m_rxIdx - 1] == '\n')
+                if ((m_pDrBuffer[m_rxIdx - 2] == '\r') && m_pDrBuffer[m_rxIdx - 1] == '\n')
                 {
-                    m_drMessage[m_rxIdx - 2] = 0; // set null at end of the message
+                    if (m_drStreaming)
+                    {
+                        m_drStreaming = false;
+                        m_InvokeStreamCallback(MLR_ModemStreamEvent::End, m_pDrBuffer, m_drMessageLen);
+                    }
+                    m_pDrBuffer[m_rxIdx - 2] = 0; // set null at end of the message
+                    if (m_pDrPacket)
+                    {
+                        m_pDrPacket->len = m_drMessageLen;
+                        m_pDrPacket->timestamp = millis();
+                    }
                     m_rxIdx = 0;
                     m_rxMessage[0] = 0; // "destroy" the old CMD message, so nobody will expect the new message to be a regular command response instead of a radio packet
                     m_drMessagePresent = true;
@@ -1081,20 +1412,29 @@ MLR_Modem_Error MLR_Modem::m_WaitCmdResponse(uint32_t ms)
 
         case MLR_ModemCmdState::FinishedCmdResponse:
             MLR_DEBUG_PRINTF("[MLR Wait]: Finished CMD response received: '%.*s'\n", m_rxIdx, m_rxMessage);
+            m_CountResponse();
+            if (m_SkipStaleRssiReply())
+            {
+                break;
+            }
             return MLR_Modem_Error::Ok;
             break;
 
         case MLR_ModemCmdState::FinishedDrResponse:
             MLR_DEBUG_PRINTF("[MLR Wait]: Intervening DR received (Len=%u). Calling callback...\n", m_drMessageLen);
-            if (m_pCallback)
-            {
-                m_pCallback(MLR_Modem_Error::Ok, MLR_Modem_Response::DataReceived, 0, m_drMessage, m_drMessageLen);
-            }
+            m_HandleDrResponse(false);
             MLR_DEBUG_PRINTLN("[MLR Wait]: Continuing to wait for original CMD response...");
             break;
 
+        case MLR_ModemCmdState::DrDeferred:
+            // only while acquiring the RSSI of a held packet: give up, the reply is skipped when it arrives
+            MLR_DEBUG_PRINTLN("[MLR Wait]: Next DR arrived before the response, abandoning the command.");
+            m_staleRssiReply = true;
+            return MLR_Modem_Error::Fail;
+
         default:
             MLR_DEBUG_PRINTLN("[MLR Wait]: Parser encountered error (Garbage/Overflow/Fail).");
+            m_CountParserError();
             return MLR_Modem_Error::Fail;
         }
 
@@ -1102,9 +1442,113 @@ MLR_Modem_Error MLR_Modem::m_WaitCmdResponse(uint32_t ms)
     }
     m_parserState = MLR_ModemParserState::Start;
     MLR_DEBUG_PRINTLN("[MLR Wait]: Timeout.");
+    if (m_cmdPending)
+    {
+        // the command got no response at all; a missing "*IR" after "*DT" is not counted
+        m_cmdPending = false;
+        m_StatsBegin();
+        ++m_stats.commandTimeouts;
+        m_StatsEnd();
+    }
     return MLR_Modem_Error::Fail;
 }
 
+void MLR_Modem::m_HandleDrResponse(bool queryRssi)
+{
+    MLR_PROFILE_SCOPE(MLR_ProfileSite::HandleDr);
+
+    uint16_t drCount = ++m_drCount;
+    uint8_t *pPayload = m_pDrBuffer;
+    uint8_t len = m_drMessageLen;
+
+    m_StatsBegin();
+    ++m_stats.rxFrames;
+    m_stats.rxBytes += len;
+    m_StatsEnd();
+    int16_t rssi = MLR_RSSI_UNKNOWN;
+    m_drRssi = MLR_RSSI_UNKNOWN;
+
+    // a pool packet keeps its buffer if a hook or the callback runs a command and a nested *DR arrives
+    MLR_Packet *pPacket = m_pDrPacket;
+    if (pPacket)
+    {
+        MLR_PacketPool::Retain(pPacket);
+    }
+
+    // with further data pending, "@RS" would report a later packet and its reply would queue behind that packet
+    if (m_rssiEnrichment && queryRssi && !m_pUart->available())
+    {
+        // a *DR arriving before "*RS" is held back by the parser until this packet is delivered,
+        // so it neither overwrites this packet nor overtakes it
+        m_drHold = true;
+        if (GetRssiLastRx(&rssi) != MLR_Modem_Error::Ok)
+        {
+            rssi = MLR_RSSI_UNKNOWN;
+        }
+        m_drHold = false;
+    }
+
+    m_drRssi = rssi;
+    if (pPacket)
+    {
+        pPacket->rssi = rssi;
+    }
+
+    bool drop = false;
+    {
+        MLR_PROFILE_SCOPE(MLR_ProfileSite::RxHooks);
+        for (MLR_ModemRxHook *pHook = m_pRxHooks; pHook && !drop; pHook = pHook->m_pNextHook)
+        {
+            drop = (pHook->OnFrameReceived(pPayload, &len, rssi) == MLR_ModemRxAction::Drop);
+        }
+    }
+
+    // a hook that ran a command may have received the next packet already
+    bool current = (drCount == m_drCount);
+    if (pPacket)
+    {
+        pPacket->len = len;
+    }
+    if (current)
+    {
+        m_drMessageLen = len;
+    }
+
+    if (drop)
+    {
+        MLR_DEBUG_PRINTLN("[MLR DR]: Packet consumed by receive hook.");
+        if (current)
+        {
+            m_drMessagePresent = false;
+        }
+    }
+    else if (m_pCallback)
+    {
+        int32_t value = (rssi == MLR_RSSI_UNKNOWN) ? 0 : static_cast<int32_t>(rssi);
+        m_InvokeCallback(MLR_Modem_Error::Ok, MLR_Modem_Response::DataReceived, value, pPayload, len);
+    }
+
+    MLR_PacketPool::Release(pPacket);
+}
+
+bool MLR_Modem::m_SkipStaleRssiReply()
+{
+    if (!m_staleRssiReply)
+    {
+        return false;
+    }
+
+    // the modem answers in order, so the first response after an abandoned "@RS" is its reply
+    m_staleRssiReply = false;
+    uint16_t prefixLen = static_strlen(MLR_GET_RSSI_LAST_RX_RESPONSE_PREFIX);
+    if (m_rxIdx >= prefixLen && !strncmp(reinterpret_cast<const char *>(m_rxMessage), MLR_GET_RSSI_LAST_RX_RESPONSE_PREFIX, prefixLen))
+    {
+        MLR_DEBUG_PRINTLN("[MLR DR]: Skipped the reply of an abandoned RSSI query.");
+        return true;
+    }
+    return false;
+}
+
 void MLR_Modem::m_SetExpectedResponses(MLR_Modem_Response ep0, MLR_Modem_Response ep1, MLR_Modem_Response ep2)
 {
     m_asyncExpectedResponses[0] = ep0;
@@ -1114,6 +1558,7 @@ void MLR_Modem::m_SetExpectedResponses(MLR_Modem_Response ep0, MLR_Modem_Respons
 
 MLR_Modem_Error MLR_Modem::m_DispatchCmdResponseAsync()
 {
+    MLR_PROFILE_SCOPE(MLR_ProfileSite::DispatchResponse);
     MLR_Modem_Error err = MLR_Modem_Error::Fail;
 
     switch (m_asyncExpectedResponse)
@@ -1139,7 +1584,7 @@ MLR_Modem_Error MLR_Modem::m_DispatchCmdResponseAsync()
             uint32_t sn{};
             err = m_HandleMessage_SN(&sn);
             int32_t value = static_cast<int32_t>(sn);
-            m_pCallback(err, MLR_Modem_Response::SerialNumber, value, nullptr, 0);
+            m_InvokeCallback(err, MLR_Modem_Response::SerialNumber, value, nullptr, 0);
         }
         break;
     case MLR_Modem_Response::MLR_Modem_DtIr:
@@ -1147,7 +1592,14 @@ MLR_Modem_Error MLR_Modem::m_DispatchCmdResponseAsync()
         {
             uint8_t irValue{};
             err = m_HandleMessageHexByte(&irValue, MLR_INFORMATION_RESPONSE_LEN, MLR_INFORMATION_RESPONSE_PREFIX);
-            m_pCallback(err, MLR_Modem_Response::MLR_Modem_DtIr, static_cast<int32_t>(irValue), nullptr, 0);
+            if (err == MLR_Modem_Error::Ok &&
+                (irValue == MLR_INFORMATION_RESPONSE_ERR_NO_TX || irValue == MLR_INFORMATION_RESPONSE_ERR_OTHER_WAVES))
+            {
+                m_StatsBegin();
+                ++m_stats.lbtFails;
+                m_StatsEnd();
+            }
+            m_InvokeCallback(err, MLR_Modem_Response::MLR_Modem_DtIr, static_cast<int32_t>(irValue), nullptr, 0);
         }
         break;
     case MLR_Modem_Response::DataReceived:
@@ -1159,7 +1611,7 @@ MLR_Modem_Error MLR_Modem::m_DispatchCmdResponseAsync()
         {
             int16_t rssi{};
             err = m_HandleMessage_RA(&rssi);
-            m_pCallback(err, MLR_Modem_Response::RssiCurrentChannel, static_cast<int32_t>(rssi), nullptr, 0);
+            m_InvokeCallback(err, MLR_Modem_Response::RssiCurrentChannel, static_cast<int32_t>(rssi), nullptr, 0);
         }
         break;
     case MLR_Modem_Response::UserID:
@@ -1176,7 +1628,7 @@ MLR_Modem_Error MLR_Modem::m_DispatchCmdResponseAsync()
             const uint8_t *payloadPtr = m_rxMessage;
             uint16_t payloadLen = m_rxIdx; // Length of the response (excluding CR/LF)
             err = MLR_Modem_Error::Ok;     // Assume OK since we got a response
-            m_pCallback(err, MLR_Modem_Response::GenericResponse, 0, payloadPtr, payloadLen);
+            m_InvokeCallback(err, MLR_Modem_Response::GenericResponse, 0, payloadPtr, payloadLen);
         }
         break;
     default:
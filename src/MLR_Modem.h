@@ -13,12 +13,33 @@
 
 #pragma once
 #include <Arduino.h>
+#include "MLR_Frame.h"
+#include "MLR_PacketPool.h"
 
 /**
  * @brief Default baud rate for the MLR modem.
  */
 static constexpr uint32_t MLR_DEFAULT_BAUDRATE = 19200;
 
+/**
+ * @brief RSSI value reported when the RSSI of a received packet is not known.
+ */
+static constexpr int16_t MLR_RSSI_UNKNOWN = INT16_MIN;
+
+#ifndef MLR_FLUSH_MAX_BYTES
+/**
+ * @brief Maximum number of garbage bytes discarded per parser call, bounds the time spent in Work() on a noisy line.
+ */
+#define MLR_FLUSH_MAX_BYTES 32
+#endif
+
+#ifndef MLR_DR_BYTE_TIMEOUT_MS
+/**
+ * @brief Time in milliseconds without a byte after which an incomplete "*DR" telegram is discarded.
+ */
+#define MLR_DR_BYTE_TIMEOUT_MS 100
+#endif
+
 // --- Debug Configuration ---
 // To enable debug prints for this library, define ENABLE_MLR_MODEM_DEBUG
 // Uncomment the following line to enable debug output
@@ -44,6 +65,14 @@ static constexpr uint32_t MLR_DEFAULT_BAUDRATE = 19200;
 #define MLR_DEBUG_WRITE(...)
 #endif
 
+// --- Profiling Configuration ---
+// To measure the time spent in the parser states, handlers and callbacks, define ENABLE_MLR_MODEM_PROFILE
+// (see MLR_Profile.h and MLR_Modem::PrintProfile()).
+// Uncomment the following line to enable profiling
+// #define ENABLE_MLR_MODEM_PROFILE
+
+#include "MLR_Profile.h"
+
 /**
  * \brief Represents the type of response received from the modem.
  * Used internally to identify incoming messages.
@@ -118,6 +147,7 @@ enum class MLR_ModemCmdState
     Overflow,            //!< Too many characters received
     FinishedCmdResponse, //!< Received a command that might be syntactically correct
     FinishedDrResponse,  //!< Received a data reception response (*DR)
+    DrDeferred,          //!< A *DR telegram started while the previous packet is still held, nothing consumed yet
 };
 
 //! "low-level" internal parser states
@@ -150,6 +180,7 @@ enum class MLR_ModemParserState
  * \param error - Status of the received response. If value != MLR_Modem_Error::Ok, all following fields are invalid.
  * \param responseType - Type of the received response (e.g., DataReceived, RssiCurrentChannel).
  * \param value - The returned value (e.g., RSSI value), or 0 if not applicable.
+ *                For `MLR_Modem_Response::DataReceived`, this is the RSSI in dBm if RSSI enrichment is enabled and the RSSI could be acquired, otherwise 0.
  * \param pPayload - Pointer to the received payload. For `MLR_Modem_Response::DataReceived`, this is the radio payload. For `MLR_Modem_Response::GenericResponse`, this is the raw response string.
  *                   \note The data pointed to by `pPayload` is only valid within the scope of this callback function, as it points to an internal library buffer. If you need to access the data after the callback has returned, you must copy it to your own buffer.
  * \param len - The length of the received payload.
@@ -157,6 +188,99 @@ enum class MLR_ModemParserState
  */
 typedef void (*MLR_Modem_AsyncCallback)(MLR_Modem_Error error, MLR_Modem_Response responseType, int32_t value, const uint8_t *pPayload, uint16_t len);
 
+/**
+ * \brief Events of the streaming receive callback.
+ */
+enum class MLR_ModemStreamEvent : uint8_t
+{
+    Begin, //!< A "*DR" telegram starts, len is the announced payload length
+    Chunk, //!< Next part of the payload in pData/len
+    End,   //!< The payload is complete, pData/len is the whole payload
+    Abort, //!< The telegram was corrupted; all chunks delivered so far must be discarded
+};
+
+/**
+ * \brief Callback delivering "*DR" payloads while they are still arriving over the UART.
+ * \param event - The stream event.
+ * \param pData - Pointer to the payload bytes (nullptr for Begin and Abort). Only valid during the callback.
+ * \param len - Number of bytes in pData, or the announced payload length for Begin.
+ * \note The callback is invoked from the parser. It must not call driver functions that communicate with the modem.
+ */
+typedef void (*MLR_Modem_StreamCallback)(MLR_ModemStreamEvent event, const uint8_t *pData, uint8_t len);
+
+/**
+ * \brief Result of a receive hook.
+ */
+enum class MLR_ModemRxAction
+{
+    Pass, //!< Hand the packet to the next hook and finally to the application
+    Drop, //!< Consume the packet; neither further hooks nor the application will see it
+};
+
+/**
+ * \brief Interface for modules that process received radio packets inside the driver.
+ *
+ * Hooks are registered with MLR_Modem::AddRxHook() and are called in order for every
+ * received "*DR" telegram, before the packet is handed to the application. Hooks that also need
+ * the transmitted packets (e.g. a capture) override OnFrameTransmitted().
+ */
+class MLR_ModemRxHook
+{
+public:
+    /**
+     * \brief Called for every received radio packet.
+     * \param pPayload Pointer to the received payload. The hook may modify the payload in place.
+     * \param pLen Pointer to the payload length. The hook may shorten the payload.
+     * \param rssi RSSI of the packet in dBm, or MLR_RSSI_UNKNOWN.
+     * \return MLR_ModemRxAction::Drop to consume the packet, MLR_ModemRxAction::Pass otherwise.
+     */
+    virtual MLR_ModemRxAction OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi) = 0;
+
+    /**
+     * \brief Called for every packet the modem accepted for transmission ("*DT" response).
+     * \param pPayload The payload as handed to the modem.
+     * \param len Length of the payload.
+     * \note Carrier sense may still reject the transmission afterwards. The default implementation does nothing.
+     *       The hook must not call driver functions that communicate with the modem.
+     */
+    virtual void OnFrameTransmitted(const uint8_t *pPayload, uint8_t len)
+    {
+        (void)pPayload;
+        (void)len;
+    }
+
+private:
+    friend class MLR_Modem;
+    MLR_ModemRxHook *m_pNextHook = nullptr; //!< Next hook in the driver's hook chain
+};
+
+/**
+ * @brief Upper bounds of the command latency histogram buckets in milliseconds. A last bucket counts the slower responses.
+ */
+static const uint16_t MLR_STATS_LATENCY_BOUNDS_MS[] = {2, 5, 10, 20, 50, 100, 200, 500};
+
+/**
+ * @brief Number of command latency histogram buckets.
+ */
+static constexpr uint8_t MLR_STATS_LATENCY_BUCKETS = sizeof(MLR_STATS_LATENCY_BOUNDS_MS) / sizeof(MLR_STATS_LATENCY_BOUNDS_MS[0]) + 1;
+
+/**
+ * \brief Counters of the driver since begin(), see MLR_Modem::GetStats().
+ */
+struct MLR_ModemStats
+{
+    uint32_t rxFrames;                                  //!< Received "*DR" telegrams
+    uint32_t rxBytes;                                   //!< Payload bytes of the received telegrams
+    uint32_t txFrames;                                  //!< Packets accepted for transmission ("*DT" response)
+    uint32_t txBytes;                                   //!< Payload bytes of the accepted packets
+    uint32_t lbtFails;                                  //!< Transmissions rejected by carrier sense
+    uint32_t parserErrors;                              //!< Garbage or overflow reported by the receive parser
+    uint32_t commands;                                  //!< Commands sent to the modem, including "@DT"
+    uint32_t commandTimeouts;                           //!< Commands without any response
+    uint32_t latencyBuckets[MLR_STATS_LATENCY_BUCKETS]; //!< Responses by time from the command to its first response
+    uint64_t latencySumUs;                              //!< Sum of the response latencies
+};
+
 /**
  * \brief Main class for interfacing with the MLR Modem.
  */
@@ -206,6 +330,11 @@ public: // methods
      */
     MLR_Modem_Error GetMode(MLR_ModemMode *pMode);
 
+    /**
+     * \brief Gets the mode read by begin() or last set with SetMode(), without a command.
+     */
+    MLR_ModemMode GetCachedMode() const { return m_mode; }
+
     /**
      * \brief Sets the LoRa spreading factor.
      * \param sf The spreading factor to set.
@@ -383,6 +512,16 @@ public: // methods
      */
     MLR_Modem_Error TransmitDataFireAndForget(const uint8_t *pMsg, uint8_t len);
 
+    /**
+     * \brief Transmits a payload prefixed with the frame header (type, own Equipment ID, sequence number).
+     * \param type The frame type.
+     * \param pMsg Pointer to the data following the header (may be nullptr if len is 0).
+     * \param len Length of the data (0-MLR_FRAME_MAX_PAYLOAD_LEN bytes).
+     * \return Same as TransmitData().
+     * \note The Equipment ID is taken from the last SetEquipmentID()/GetEquipmentID() call, or acquired from the modem once.
+     */
+    MLR_Modem_Error TransmitFrame(MLR_FrameType type, const uint8_t *pMsg, uint8_t len);
+
     /**
      * \brief Asynchronously requests the current RSSI of the configured channel.
      * The result will be delivered via the AsyncCallback.
@@ -419,12 +558,59 @@ public: // methods
      */
     MLR_Modem_Error GetPacket(const uint8_t **ppData, uint8_t *len);
 
+    /**
+     * \brief Retrieves the last received packet together with its RSSI.
+     * \param ppData Pointer to a const uint8_t* that will be set to the packet data (see GetPacket()).
+     * \param len Pointer to a uint8_t that will be set to the packet length.
+     * \param pRssi Pointer to store the RSSI in dBm, or MLR_RSSI_UNKNOWN if RSSI enrichment is disabled or failed.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::Fail if no packet is available.
+     */
+    MLR_Modem_Error GetPacket(const uint8_t **ppData, uint8_t *len, int16_t *pRssi);
+
+    /**
+     * \brief Enables acquiring the RSSI ("@RS") for every received packet before it is dispatched.
+     * \param enable true to query the RSSI after each "*DR" telegram.
+     * \note The RSSI is only acquired for packets handled in Work() while no further data is pending.
+     *       Other packets (e.g. received while waiting for another command response) are reported with MLR_RSSI_UNKNOWN.
+     *       If the next "*DR" arrives before the "*RS" reply, the query is abandoned and the packet is delivered
+     *       with MLR_RSSI_UNKNOWN before the next packet, so packets are never lost or reordered.
+     */
+    void SetRssiEnrichment(bool enable) { m_rssiEnrichment = enable; }
+
+    /**
+     * \brief Registers a hook that processes received packets before the application.
+     * \param pHook The hook to add. Hooks are called in registration order.
+     * \param first If true, the hook is inserted in front of all registered hooks.
+     */
+    void AddRxHook(MLR_ModemRxHook *pHook, bool first = false);
+
+    /**
+     * \brief Removes a previously registered receive hook.
+     * \param pHook The hook to remove.
+     */
+    void RemoveRxHook(MLR_ModemRxHook *pHook);
+
     /**
      * \brief Sets the asynchronous callback function.
      * \param pCallback The callback function. If set to nullptr, no callback will take place.
      */
     void SetAsyncCallback(MLR_Modem_AsyncCallback pCallback) { m_pCallback = pCallback; }
 
+    /**
+     * \brief Sets a callback that receives "*DR" payloads in chunks while they arrive (cut-through).
+     * \param pCallback The stream callback, or nullptr to disable streaming.
+     * \param chunkLen Number of payload bytes collected before a Chunk event is delivered (at least 1).
+     *                 The last chunk of a payload may be shorter.
+     * \note Streaming is independent of the regular packet handling: after the End event the packet is
+     *       still passed to the receive hooks and the async callback, which may drop it.
+     */
+    void SetStreamCallback(MLR_Modem_StreamCallback pCallback, uint8_t chunkLen = 16)
+    {
+        m_pStreamCallback = pCallback;
+        m_drStreaming = false; // a telegram in progress is no longer streamed
+        m_streamChunkLen = (chunkLen == 0) ? 1 : chunkLen;
+    }
+
     /**
      * \brief Sets the stream for debug output.
      * \param debugStream Pointer to the Stream object (e.g., &Serial).
@@ -437,10 +623,54 @@ public: // methods
      */
     bool HasPacket() { return m_drMessagePresent; }
 
+    /**
+     * \brief Gets the state of the receive parser, e.g. for tests and diagnostics.
+     */
+    MLR_ModemParserState GetParserState() const { return m_parserState; }
+
+    /**
+     * \brief Gets a consistent copy of the driver counters.
+     * \param pStats Receives the counters.
+     * \note The copy is lock-free: the driver never waits for the caller, and the caller retries while
+     *       the driver updates the counters. It may therefore be called from another thread than Work(),
+     *       e.g. by a metrics exporter on a host gateway.
+     */
+    void GetStats(MLR_ModemStats *pStats) const;
+
+#ifdef ENABLE_MLR_MODEM_PROFILE
+    /**
+     * \brief Gets the measurements of a profiled site.
+     * \param site The site.
+     * \return The accumulated measurements in ticks, see MLR_ProfileTicksPerUs().
+     */
+    const MLR_ProfileEntry &GetProfile(MLR_ProfileSite site) const { return m_profile[static_cast<uint8_t>(site)]; }
+
+    /**
+     * \brief Clears the measurements of all sites.
+     */
+    void ResetProfile();
+
+    /**
+     * \brief Writes the measurements of all sites that were called as a table.
+     * \param out Output for the table, e.g. Serial.
+     */
+    void PrintProfile(Print &out) const;
+#endif
+
     /**
      * \brief Deletes the currently stored received packet.
+     * \note With a packet pool, the driver's reference on the packet buffer is released.
+     */
+    void DeletePacket();
+
+    /**
+     * \brief Attaches a packet pool. Received packets are then parsed directly into pool buffers,
+     * and hooks or the async callback can keep a packet with MLR_PacketPool::Acquire() instead of copying it.
+     * \param pPool The packet pool, or nullptr to use the internal receive buffer.
+     * \note The driver holds a reference on the latest received packet until the next packet starts
+     *       or DeletePacket() is called. If the pool is exhausted, the packet is received into the internal buffer.
      */
-    void DeletePacket() { m_drMessagePresent = false; }
+    void SetPacketPool(MLR_PacketPool *pPool);
 
     /**
      * \brief Main processing loop for the driver.
@@ -450,6 +680,8 @@ public: // methods
     void Work();
 
 private: // methods
+    friend class MLR_TraceDecoder; // reuses the receive parser
+
     //! Internal: mock-up for timeout check
     bool m_IsTimeout()
     {
@@ -483,6 +715,9 @@ private: // methods
     void m_ClearUnreadByte();
     uint32_t m_Read(uint8_t *pDst, uint32_t count);
 
+    //! Internal: Attaches the UART and resets the parser, without communicating with the modem
+    void m_Attach(Stream &uart, MLR_Modem_AsyncCallback pCallback);
+
     //! Internal: Set the parser to the initial state
     void m_ResetParser();
 
@@ -498,6 +733,36 @@ private: // methods
     //! Internal: Sets the expected async responses
     void m_SetExpectedResponses(MLR_Modem_Response ep0, MLR_Modem_Response ep1, MLR_Modem_Response ep2);
 
+    //! Internal: Delivers the payload bytes received since the last chunk to the stream callback
+    void m_StreamChunk();
+
+    //! Internal: Runs the receive hooks on a received *DR packet and calls the callback
+    void m_HandleDrResponse(bool queryRssi);
+
+    //! Internal: Checks if a command response is the late reply of an abandoned "@RS" and must be skipped
+    bool m_SkipStaleRssiReply();
+
+    //! Internal: Reports a packet accepted for transmission to the hooks
+    void m_NotifyTransmitted(const uint8_t *pMsg, uint8_t len);
+
+    //! Internal: Starts an update of m_stats (odd sequence number)
+    void m_StatsBegin();
+
+    //! Internal: Finishes an update of m_stats (even sequence number)
+    void m_StatsEnd();
+
+    //! Internal: Counts a parser error
+    void m_CountParserError();
+
+    //! Internal: Counts the first response to the pending command with its latency
+    void m_CountResponse();
+
+    //! Internal: Calls the async callback
+    void m_InvokeCallback(MLR_Modem_Error error, MLR_Modem_Response responseType, int32_t value, const uint8_t *pPayload, uint16_t len);
+
+    //! Internal: Calls the streaming receive callback
+    void m_InvokeStreamCallback(MLR_ModemStreamEvent event, const uint8_t *pData, uint8_t len);
+
     //! Internal: Dispatches a received command response to the async callback
     MLR_Modem_Error m_DispatchCmdResponseAsync();
 
@@ -554,9 +819,32 @@ private:                                            // data
     uint8_t m_rxMessage[32]; //!< Buffer for standard command responses (e.g., *CH=0E)
 
     // special receive buffer and data for '@DR' command
-    bool m_drMessagePresent;             //!< Flag indicating a *DR packet is ready
-    uint8_t m_drMessageLen;              //!< Length of the received *DR packet
-    uint8_t m_drMessage[300];            //!< Buffer for the received *DR packet payload
-    MLR_ModemMode m_mode;                //!< Cached modem mode
-    MLR_Modem_AsyncCallback m_pCallback; //!< Pointer to the user's callback function
+    bool m_drMessagePresent;                //!< Flag indicating a *DR packet is ready
+    uint8_t m_drMessageLen;                 //!< Length of the received *DR packet
+    uint32_t m_drByteAt = 0;                //!< millis() timestamp of the last byte of the current *DR telegram
+    uint8_t m_drMessage[300];               //!< Internal buffer for the received *DR packet payload (no pool, or pool exhausted)
+    uint8_t *m_pDrBuffer = m_drMessage;     //!< Buffer the current *DR packet is parsed into
+    MLR_PacketPool *m_pPacketPool = nullptr; //!< Pool for received packets, or nullptr
+    MLR_Packet *m_pDrPacket = nullptr;      //!< Pool packet holding the current *DR packet, or nullptr
+    int16_t m_drRssi;                       //!< RSSI of the received *DR packet (MLR_RSSI_UNKNOWN if not acquired)
+    uint16_t m_drCount = 0;                 //!< Number of received *DR packets, used to detect nested receptions
+    bool m_drHold = false;                  //!< The current packet waits for its RSSI, a following *DR must not overwrite it
+    bool m_staleRssiReply = false;          //!< The reply of an abandoned "@RS" is still to come
+    bool m_rssiEnrichment = false;          //!< Query "@RS" for every received packet
+    MLR_ModemRxHook *m_pRxHooks = nullptr;  //!< Head of the receive hook chain
+    MLR_Modem_StreamCallback m_pStreamCallback = nullptr; //!< Cut-through receive callback
+    uint8_t m_streamChunkLen = 16;          //!< Payload bytes per Chunk event
+    uint16_t m_drStreamed = 0;              //!< Payload bytes of the current *DR already streamed
+    bool m_drStreaming = false;             //!< A Begin event was delivered for the current *DR
+    MLR_ModemMode m_mode;                   //!< Cached modem mode
+    int16_t m_equipmentId = -1;             //!< Cached Equipment ID for frame headers (-1 if unknown)
+    uint8_t m_frameSeq = 0;                 //!< Sequence number of the next transmitted frame
+    MLR_Modem_AsyncCallback m_pCallback;    //!< Pointer to the user's callback function
+    MLR_ModemStats m_stats = {};            //!< Driver counters
+    uint32_t m_statsSeq = 0;                //!< Sequence number of m_stats, odd while an update is in progress
+    uint32_t m_cmdSentAt = 0;               //!< micros() timestamp of the pending command
+    bool m_cmdPending = false;              //!< A command waits for its first response
+#ifdef ENABLE_MLR_MODEM_PROFILE
+    MLR_ProfileEntry m_profile[MLR_PROFILE_SITES] = {}; //!< Measurements per profiled site
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,565 @@
+//
+// MLR_ModemEmulator.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Emulated MLR modem for benchmarks and tests without radio hardware.
+//
+// Supported commands (vv = two hex digits, [/W] = save to non-volatile memory):
+//   @CH, @MO, @SF, @EI, @DI, @GI, @CI, @BR   get: "*XX=vv", set with vv[/W]: ["*WR=PS"] "*XX=vv"
+//   @MO set additionally outputs the mode line ("LORA CMD MODE")
+//   @RS, @RA                                 "*RS=-80dBm"
+//   @SN, @UI                                 "*SN=00000001", "*UI=0000"
+//   @IZ                                      "*WR=PS" "*IZ=OK" mode line, restores the initial settings
+//   @DTvv<payload>                           "*DT=vv", then "*IR=03" at the end of the transmission (LoRa),
+//                                            or "*IR=01"/"*IR=02" if carrier sense fails
+// Anything else is answered with "*ER=01".
+//
+
+#include "MLR_ModemEmulator.h"
+#include "MLR_Airtime.h"
+#include <stdio.h>
+#include <string.h>
+
+// registers of the commands taking a one-byte value, in the order of m_registers
+struct MLR_EmulatorRegister
+{
+    char code[3];    // command letters
+    uint8_t initial; // value after power-up and factory reset
+    uint8_t min;     // lowest accepted value
+    uint8_t max;     // highest accepted value
+};
+
+static const MLR_EmulatorRegister s_registers[] = {
+    {"CH", 0x07, 0x07, 0x2E},
+    {"MO", 0x03, 0x00, 0x03},
+    {"SF", 0x00, 0x00, 0x05},
+    {"EI", 0x01, 0x00, 0xFF},
+    {"DI", 0x00, 0x00, 0xFF},
+    {"GI", 0x00, 0x00, 0xFF},
+    {"CI", 0x00, 0x00, 0x01},
+    {"BR", 0x19, 0x00, 0xFF},
+};
+
+static constexpr uint8_t MLR_EMULATOR_REG_MO = 1;
+static constexpr uint8_t MLR_EMULATOR_REG_SF = 2;
+
+// noise floor reported by "@RA"
+static constexpr int16_t MLR_EMULATOR_NOISE_RSSI = -110;
+
+static inline bool s_Reached(uint32_t now, uint32_t t)
+{
+    return static_cast<int32_t>(now - t) >= 0;
+}
+
+static bool s_ParseHexByte(const uint8_t *pData, uint8_t *pValue)
+{
+    uint8_t value = 0;
+    for (uint8_t i = 0; i < 2; ++i)
+    {
+        uint8_t c = pData[i];
+        value <<= 4;
+        if (c >= '0' && c <= '9')
+        {
+            value |= c - '0';
+        }
+        else if (c >= 'A' && c <= 'F')
+        {
+            value |= c - 'A' + 10;
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            value |= c - 'a' + 10;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    *pValue = value;
+    return true;
+}
+
+void MLR_ModemEmulator::begin(uint32_t baudRate, uint16_t rxBufferLen, uint16_t txBufferLen)
+{
+    m_byteUs = (10000000UL + baudRate / 2) / baudRate; // start bit, 8 data bits, stop bit
+    m_rxBufferLen = (rxBufferLen == 0) ? 1 : (rxBufferLen > MLR_EMULATOR_UART_BUFFER_LEN) ? MLR_EMULATOR_UART_BUFFER_LEN : rxBufferLen;
+    m_txBufferLen = txBufferLen;
+
+    for (uint8_t i = 0; i < sizeof(m_registers); ++i)
+    {
+        m_registers[i] = s_registers[i].initial;
+    }
+
+    uint32_t now = micros();
+    m_inFreeAt = now;
+    m_outFreeAt = now;
+    m_cmdLen = 0;
+    m_dtLen = -1;
+    m_txBusy = false;
+    m_eventCount = 0;
+    m_queueHead = 0;
+    m_queueCount = 0;
+    m_fifoHead = 0;
+    m_fifoCount = 0;
+    m_floodLen = 0;
+    m_floodCount = 0;
+    m_txCount = 0;
+    m_lbtFailCount = 0;
+    m_commandCount = 0;
+    m_overrunCount = 0;
+}
+
+void MLR_ModemEmulator::SetTiming(uint32_t turnaroundUs, uint32_t saveUs, uint32_t txSetupUs)
+{
+    m_turnaroundUs = turnaroundUs;
+    m_saveUs = saveUs;
+    m_txSetupUs = txSetupUs;
+}
+
+MLR_Modem_Error MLR_ModemEmulator::InjectPacket(const uint8_t *pPayload, uint8_t len)
+{
+    if (!pPayload || len == 0)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    uint32_t now = micros();
+    m_Update(now);
+    return m_OutputDr(pPayload, len, now);
+}
+
+MLR_Modem_Error MLR_ModemEmulator::InjectRaw(const uint8_t *pData, uint16_t len)
+{
+    uint32_t now = micros();
+    m_Update(now);
+    return m_Output(pData, len, now) ? MLR_Modem_Error::Ok : MLR_Modem_Error::Busy;
+}
+
+MLR_Modem_Error MLR_ModemEmulator::StartFlood(uint8_t len, uint32_t intervalUs)
+{
+    if (len < 4)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    uint32_t now = micros();
+    m_Update(now);
+    m_floodLen = len;
+    m_floodIntervalUs = intervalUs;
+    m_floodNext = now;
+    return MLR_Modem_Error::Ok;
+}
+
+bool MLR_ModemEmulator::CheckFloodPacket(const uint8_t *pPayload, uint8_t len, uint32_t *pSeq)
+{
+    if (!pPayload || len < 4)
+    {
+        return false;
+    }
+
+    uint32_t seq = MLR_Frame_GetU32(pPayload);
+    for (uint8_t i = 4; i < len; ++i)
+    {
+        if (pPayload[i] != static_cast<uint8_t>(seq + i))
+        {
+            return false;
+        }
+    }
+    if (pSeq)
+    {
+        *pSeq = seq;
+    }
+    return true;
+}
+
+int MLR_ModemEmulator::available()
+{
+    m_Update(micros());
+    return m_fifoCount;
+}
+
+int MLR_ModemEmulator::read()
+{
+    m_Update(micros());
+    if (m_fifoCount == 0)
+    {
+        return -1;
+    }
+
+    uint8_t c = m_fifo[m_fifoHead];
+    m_fifoHead = (m_fifoHead + 1) % MLR_EMULATOR_UART_BUFFER_LEN;
+    --m_fifoCount;
+    return c;
+}
+
+int MLR_ModemEmulator::peek()
+{
+    m_Update(micros());
+    return (m_fifoCount > 0) ? m_fifo[m_fifoHead] : -1;
+}
+
+size_t MLR_ModemEmulator::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t MLR_ModemEmulator::write(const uint8_t *pData, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+    {
+        // a full transmit buffer blocks like a hardware UART
+        uint32_t now = micros();
+        int32_t backlog = static_cast<int32_t>(m_inFreeAt - now) - static_cast<int32_t>(m_txBufferLen * m_byteUs);
+        while (backlog > 0)
+        {
+            uint32_t wait = (backlog > 10000) ? 10000 : backlog;
+            delayMicroseconds(wait);
+            backlog -= wait;
+        }
+
+        now = micros();
+        if (m_cmdLen == 0 && m_dtLen < 0)
+        {
+            m_timing.writeStartUs = now; // first byte of a command
+        }
+        m_inFreeAt = (s_Reached(now, m_inFreeAt) ? now : m_inFreeAt) + m_byteUs;
+        m_Receive(pData[i], m_inFreeAt);
+    }
+    return len;
+}
+
+void MLR_ModemEmulator::flush()
+{
+    while (!s_Reached(micros(), m_inFreeAt))
+    {
+        delayMicroseconds(100);
+    }
+}
+
+void MLR_ModemEmulator::m_Update(uint32_t now)
+{
+    // generated packets take turns with the response lines in time order
+    while (m_floodLen > 0 && s_Reached(now, m_floodNext))
+    {
+        m_Emit(m_floodNext);
+
+        uint8_t packet[MLR_MAX_PAYLOAD_LEN];
+        MLR_Frame_PutU32(packet, m_floodCount);
+        for (uint8_t i = 4; i < m_floodLen; ++i)
+        {
+            packet[i] = static_cast<uint8_t>(m_floodCount + i);
+        }
+        if (m_OutputDr(packet, m_floodLen, m_floodNext) != MLR_Modem_Error::Ok)
+        {
+            break; // retried when the queue has drained
+        }
+        ++m_floodCount;
+        m_floodNext = (m_floodIntervalUs > 0) ? m_floodNext + m_floodIntervalUs : m_outFreeAt;
+    }
+    m_Emit(now);
+
+    // bytes that have arrived go to the UART receive buffer, or get lost if it is full
+    while (m_queueCount > 0 && s_Reached(now, m_queueReady[m_queueHead]))
+    {
+        if (m_fifoCount < m_rxBufferLen)
+        {
+            m_fifo[(m_fifoHead + m_fifoCount) % MLR_EMULATOR_UART_BUFFER_LEN] = m_queueData[m_queueHead];
+            ++m_fifoCount;
+        }
+        else
+        {
+            ++m_overrunCount;
+        }
+        m_queueHead = (m_queueHead + 1) % MLR_EMULATOR_QUEUE_LEN;
+        --m_queueCount;
+    }
+
+    // keep idle timestamps recent, so that the signed time comparison never wraps
+    if (m_queueCount == 0 && s_Reached(now, m_outFreeAt))
+    {
+        m_outFreeAt = now;
+    }
+    if (s_Reached(now, m_inFreeAt))
+    {
+        m_inFreeAt = now;
+    }
+}
+
+void MLR_ModemEmulator::m_Emit(uint32_t untilUs)
+{
+    // lines go out in time order; each starts when it is due or when the line gets free
+    while (m_eventCount > 0 && s_Reached(untilUs, m_events[0].dueUs))
+    {
+        Event event = m_events[0];
+        --m_eventCount;
+        memmove(&m_events[0], &m_events[1], m_eventCount * sizeof(Event));
+
+        if (event.len > 0)
+        {
+            uint32_t start = s_Reached(event.dueUs, m_outFreeAt) ? event.dueUs : m_outFreeAt;
+            memcpy(&event.text[event.len], "\r\n", 2);
+            if (m_Output(reinterpret_cast<const uint8_t *>(event.text), event.len + 2, event.dueUs) && event.response)
+            {
+                if (!m_responseStarted)
+                {
+                    m_responseStarted = true;
+                    m_timing.responseStartUs = start;
+                }
+                m_timing.responseEndUs = m_outFreeAt;
+            }
+        }
+        if (event.deliver)
+        {
+            m_txBusy = false;
+            if (m_pPeer)
+            {
+                m_pPeer->m_Emit(event.dueUs);
+                m_pPeer->m_OutputDr(m_txBuf, m_txLen, event.dueUs);
+            }
+        }
+    }
+}
+
+bool MLR_ModemEmulator::m_Output(const uint8_t *pData, uint16_t len, uint32_t atUs)
+{
+    if (len > MLR_EMULATOR_QUEUE_LEN - m_queueCount)
+    {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < len; ++i)
+    {
+        m_outFreeAt = (s_Reached(atUs, m_outFreeAt) ? atUs : m_outFreeAt) + m_byteUs;
+        uint16_t idx = (m_queueHead + m_queueCount) % MLR_EMULATOR_QUEUE_LEN;
+        m_queueData[idx] = pData[i];
+        m_queueReady[idx] = m_outFreeAt;
+        ++m_queueCount;
+    }
+    return true;
+}
+
+MLR_Modem_Error MLR_ModemEmulator::m_OutputDr(const uint8_t *pPayload, uint8_t len, uint32_t atUs)
+{
+    if (len + 8 > MLR_EMULATOR_QUEUE_LEN - m_queueCount)
+    {
+        return MLR_Modem_Error::Busy;
+    }
+
+    char header[8];
+    snprintf(header, sizeof(header), "*DR=%02X", len);
+    m_Output(reinterpret_cast<const uint8_t *>(header), 6, atUs);
+    m_Output(pPayload, len, atUs);
+    m_Output(reinterpret_cast<const uint8_t *>("\r\n"), 2, atUs);
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_ModemEmulator::m_Schedule(uint32_t dueUs, const char *pText, bool response, bool deliver)
+{
+    if (m_eventCount >= MLR_EMULATOR_MAX_EVENTS)
+    {
+        return; // the application does not read the responses, drop them
+    }
+
+    // insert behind all lines due at the same time or earlier
+    uint8_t idx = m_eventCount;
+    while (idx > 0 && !s_Reached(dueUs, m_events[idx - 1].dueUs))
+    {
+        m_events[idx] = m_events[idx - 1];
+        --idx;
+    }
+
+    Event &event = m_events[idx];
+    event.dueUs = dueUs;
+    event.deliver = deliver;
+    event.response = response;
+    event.len = pText ? static_cast<uint8_t>(strlen(pText)) : 0;
+    if (event.len > sizeof(event.text) - 2)
+    {
+        event.len = sizeof(event.text) - 2;
+    }
+    if (event.len > 0)
+    {
+        memcpy(event.text, pText, event.len);
+    }
+    ++m_eventCount;
+}
+
+void MLR_ModemEmulator::m_ScheduleModeLine(uint32_t dueUs)
+{
+    static const char *const s_modeLines[] = {"FSK BIN MODE", "FSK CMD MODE", "LORA BIN MODE", "LORA CMD MODE"};
+    m_Schedule(dueUs, s_modeLines[m_registers[MLR_EMULATOR_REG_MO] & 0x03]);
+}
+
+void MLR_ModemEmulator::m_Receive(uint8_t c, uint32_t atUs)
+{
+    if (m_dtLen >= 0)
+    {
+        m_dtBuf[m_dtIdx++] = c;
+        if (m_dtIdx == m_dtLen + 2)
+        {
+            m_Transmit(atUs);
+        }
+        return;
+    }
+
+    if (m_cmdLen < sizeof(m_cmd))
+    {
+        m_cmd[m_cmdLen] = c;
+    }
+    if (m_cmdLen < 0xFF)
+    {
+        ++m_cmdLen;
+    }
+
+    // "@DTvv" is followed by binary data instead of CR/LF
+    uint8_t len{};
+    if (m_cmdLen == 5 && memcmp(m_cmd, "@DT", 3) == 0 && s_ParseHexByte(&m_cmd[3], &len))
+    {
+        m_dtLen = len;
+        m_dtIdx = 0;
+        m_cmdLen = 0;
+        return;
+    }
+
+    if (c == '\n')
+    {
+        m_Command(atUs);
+        m_cmdLen = 0;
+    }
+}
+
+void MLR_ModemEmulator::m_Command(uint32_t atUs)
+{
+    uint32_t due = atUs + m_turnaroundUs;
+    m_timing.arrivedUs = atUs;
+    m_responseStarted = false;
+
+    char line[20];
+
+    if (m_cmdLen > sizeof(m_cmd) || m_cmdLen < 5 || m_cmd[0] != '@' || m_cmd[m_cmdLen - 2] != '\r')
+    {
+        m_Schedule(due, "*ER=01");
+        return;
+    }
+
+    ++m_commandCount;
+    const uint8_t *pArg = &m_cmd[3];
+    uint8_t argLen = m_cmdLen - 5;
+    bool save = (argLen >= 2 && pArg[argLen - 2] == '/' && pArg[argLen - 1] == 'W');
+    if (save)
+    {
+        argLen -= 2;
+    }
+
+    if (argLen == 0 && !save)
+    {
+        if (memcmp(&m_cmd[1], "RS", 2) == 0)
+        {
+            snprintf(line, sizeof(line), "*RS=%ddBm", m_rssi);
+            m_Schedule(due, line);
+            return;
+        }
+        if (memcmp(&m_cmd[1], "RA", 2) == 0)
+        {
+            snprintf(line, sizeof(line), "*RA=%ddBm", MLR_EMULATOR_NOISE_RSSI);
+            m_Schedule(due, line);
+            return;
+        }
+        if (memcmp(&m_cmd[1], "SN", 2) == 0)
+        {
+            m_Schedule(due, "*SN=00000001");
+            return;
+        }
+        if (memcmp(&m_cmd[1], "UI", 2) == 0)
+        {
+            m_Schedule(due, "*UI=0000");
+            return;
+        }
+        if (memcmp(&m_cmd[1], "IZ", 2) == 0)
+        {
+            for (uint8_t i = 0; i < sizeof(m_registers); ++i)
+            {
+                m_registers[i] = s_registers[i].initial;
+            }
+            due += m_saveUs;
+            m_Schedule(due, "*WR=PS");
+            m_Schedule(due, "*IZ=OK");
+            m_ScheduleModeLine(due);
+            return;
+        }
+    }
+
+    for (uint8_t i = 0; i < sizeof(m_registers); ++i)
+    {
+        if (memcmp(&m_cmd[1], s_registers[i].code, 2) != 0)
+        {
+            continue;
+        }
+
+        uint8_t value{};
+        if (argLen == 2 && s_ParseHexByte(pArg, &value) && value >= s_registers[i].min && value <= s_registers[i].max)
+        {
+            m_registers[i] = value;
+            if (save)
+            {
+                due += m_saveUs;
+                m_Schedule(due, "*WR=PS");
+            }
+        }
+        else if (argLen != 0 || save)
+        {
+            break;
+        }
+
+        snprintf(line, sizeof(line), "*%.2s=%02X", s_registers[i].code, m_registers[i]);
+        m_Schedule(due, line);
+        if (i == MLR_EMULATOR_REG_MO && argLen != 0)
+        {
+            m_ScheduleModeLine(due);
+        }
+        return;
+    }
+
+    m_Schedule(due, "*ER=01");
+}
+
+void MLR_ModemEmulator::m_Transmit(uint32_t atUs)
+{
+    uint8_t len = static_cast<uint8_t>(m_dtLen);
+    m_dtLen = -1;
+
+    uint32_t due = atUs + m_turnaroundUs;
+    m_timing.arrivedUs = atUs;
+    m_responseStarted = false;
+    if (m_dtBuf[len] != '\r' || m_dtBuf[len + 1] != '\n')
+    {
+        m_Schedule(due, "*ER=01");
+        return;
+    }
+
+    char line[8];
+    snprintf(line, sizeof(line), "*DT=%02X", len);
+    m_Schedule(due, line);
+
+    bool lora = (m_registers[MLR_EMULATOR_REG_MO] & 0x02) != 0;
+    uint32_t start = due + m_txSetupUs;
+    m_Emit(start); // completes a previous transmission that has ended by then
+
+    // a packet is still on air, or carrier sense finds the channel busy
+    if (m_txBusy || (m_lbtFailPct > 0 && random(100) < m_lbtFailPct))
+    {
+        ++m_lbtFailCount;
+        m_Schedule(start, lora ? "*IR=02" : "*IR=01", false, false);
+        return;
+    }
+
+    uint32_t airtimeUs = lora ? MLR_Airtime_LoRaUs(len, MLR_Airtime_SpreadFactor(static_cast<MLR_ModemSpreadFactor>(m_registers[MLR_EMULATOR_REG_SF])), m_bwHz)
+                              : MLR_Airtime_FskUs(len, m_fskBitrate);
+    memcpy(m_txBuf, m_dtBuf, len);
+    m_txLen = len;
+    m_txBusy = true;
+    ++m_txCount;
+
+    // FSK reports only failures
+    m_Schedule(start + airtimeUs, lora ? "*IR=03" : nullptr, false, true);
+}
@@ -0,0 +1,304 @@
+//
+// MLR_ModemEmulator.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Emulated MLR modem for benchmarks and tests without radio hardware.
+// The emulator is a Stream that is passed to MLR_Modem::begin() in place of the serial port. It answers
+// the serial commands used by the driver and paces the interface like the real one: every byte takes its
+// character time at the configured baud rate in both directions, responses follow after the modem's
+// turnaround time, and a transmission reports "*IR" after the time on air (see MLR_Airtime.h). Bytes that
+// the application does not read in time are lost like in a UART receive buffer overrun, and writing blocks
+// while the UART transmit buffer is full. Two emulators can be connected, so that each packet transmitted
+// by one is received by the other as "*DR" telegram. For stress tests, StartFlood() makes the emulator
+// receive numbered packets back to back while it keeps answering commands.
+//
+// The timing defaults are estimates, not measurements of a real modem; set them with SetTiming(),
+// SetLoRaBandwidth() and SetFskBitrate() from the data sheet or a measurement.
+
+#pragma once
+#include "MLR_Modem.h"
+
+#ifndef MLR_EMULATOR_QUEUE_LEN
+/**
+ * @brief Number of output bytes the emulator can hold before they reach the UART receive buffer
+ * (at least two "*DR" telegrams of maximum length).
+ */
+#define MLR_EMULATOR_QUEUE_LEN 1024
+#endif
+
+#ifndef MLR_EMULATOR_UART_BUFFER_LEN
+/**
+ * @brief Maximum size of the emulated UART receive buffer.
+ */
+#define MLR_EMULATOR_UART_BUFFER_LEN 256
+#endif
+
+#ifndef MLR_EMULATOR_MAX_EVENTS
+/**
+ * @brief Maximum number of scheduled response lines.
+ */
+#define MLR_EMULATOR_MAX_EVENTS 8
+#endif
+
+/**
+ * @brief Default time from the end of a command to the start of its response in microseconds.
+ */
+static constexpr uint32_t MLR_EMULATOR_TURNAROUND_US = 1000;
+
+/**
+ * @brief Default additional time for saving a value to non-volatile memory (/W option) in microseconds.
+ */
+static constexpr uint32_t MLR_EMULATOR_SAVE_US = 10000;
+
+/**
+ * @brief Default time from "*DT" to the start of the transmission (carrier sense, radio start-up) in microseconds.
+ */
+static constexpr uint32_t MLR_EMULATOR_TX_SETUP_US = 5000;
+
+/**
+ * @brief Default LoRa bandwidth in Hz.
+ */
+static constexpr uint32_t MLR_EMULATOR_LORA_BW_HZ = 125000;
+
+/**
+ * @brief Default FSK bit rate in bit/s.
+ */
+static constexpr uint32_t MLR_EMULATOR_FSK_BITRATE = 4800;
+
+/**
+ * \brief Timestamps of the last command, as micros() values.
+ */
+struct MLR_EmulatorTiming
+{
+    uint32_t writeStartUs;    //!< The application wrote the first byte of the command
+    uint32_t arrivedUs;       //!< The last byte of the command arrived at the modem
+    uint32_t responseStartUs; //!< The first byte of the response started on the line
+    uint32_t responseEndUs;   //!< The last byte of the response arrived in the UART receive buffer
+};
+
+/**
+ * \brief Emulated modem connected through a Stream.
+ */
+class MLR_ModemEmulator : public Stream
+{
+public:
+    /**
+     * \brief Powers up the emulated modem with its initial settings.
+     * \param baudRate UART baud rate, determines the character time (10 bits per byte).
+     * \param rxBufferLen Size of the application's UART receive buffer (1-MLR_EMULATOR_UART_BUFFER_LEN).
+     * \param txBufferLen Size of the application's UART transmit buffer, 0 for an unbuffered UART.
+     */
+    void begin(uint32_t baudRate = MLR_DEFAULT_BAUDRATE, uint16_t rxBufferLen = 64, uint16_t txBufferLen = 64);
+
+    /**
+     * \brief Sets the response timing of the modem.
+     * \param turnaroundUs Time from the end of a command to the start of its response in microseconds.
+     * \param saveUs Additional time for the /W option in microseconds.
+     * \param txSetupUs Time from "*DT" to the start of a transmission in microseconds.
+     */
+    void SetTiming(uint32_t turnaroundUs, uint32_t saveUs, uint32_t txSetupUs);
+
+    /**
+     * \brief Sets the LoRa bandwidth used for the time on air.
+     * \param bwHz Bandwidth in Hz.
+     */
+    void SetLoRaBandwidth(uint32_t bwHz) { m_bwHz = bwHz; }
+
+    /**
+     * \brief Sets the FSK bit rate used for the time on air.
+     * \param bitrate Bit rate in bit/s.
+     */
+    void SetFskBitrate(uint32_t bitrate) { m_fskBitrate = bitrate; }
+
+    /**
+     * \brief Sets the probability that a transmission fails carrier sense.
+     * \param percent Probability in percent (0-100).
+     */
+    void SetLbtFailRate(uint8_t percent) { m_lbtFailPct = percent; }
+
+    /**
+     * \brief Sets the RSSI reported by "@RS".
+     * \param rssi RSSI in dBm.
+     */
+    void SetRssi(int16_t rssi) { m_rssi = rssi; }
+
+    /**
+     * \brief Connects a second emulator that receives the transmitted packets.
+     * \param pPeer The other emulator, or nullptr to disconnect. The connection is one-way; connect both
+     *              emulators to each other for a bidirectional link.
+     */
+    void Connect(MLR_ModemEmulator *pPeer) { m_pPeer = pPeer; }
+
+    /**
+     * \brief Outputs a received radio packet as "*DR" telegram, starting now.
+     * \param pPayload The packet.
+     * \param len Length of the packet (1-MLR_MAX_PAYLOAD_LEN).
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::Busy if the output queue is full,
+     *         MLR_Modem_Error::InvalidArg on invalid parameters.
+     */
+    MLR_Modem_Error InjectPacket(const uint8_t *pPayload, uint8_t len);
+
+    /**
+     * \brief Outputs arbitrary bytes to the application, starting now (e.g. line noise).
+     * \param pData The bytes.
+     * \param len Number of bytes.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::Busy if the output queue is full.
+     */
+    MLR_Modem_Error InjectRaw(const uint8_t *pData, uint16_t len);
+
+    /**
+     * \brief Starts receiving generated packets, e.g. to stress the driver while it executes commands.
+     * \param len Packet length (4-MLR_MAX_PAYLOAD_LEN).
+     * \param intervalUs Time between the starts of two packets in microseconds, 0 = back to back at line rate.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::InvalidArg if len is too short.
+     * \note Each packet carries a sequence number starting at 0 (4 bytes, little-endian), followed by the
+     *       bytes (sequence number + index) & 0xFF. Response lines are interleaved between the packets.
+     */
+    MLR_Modem_Error StartFlood(uint8_t len, uint32_t intervalUs = 0);
+
+    /**
+     * \brief Stops generating packets.
+     */
+    void StopFlood() { m_floodLen = 0; }
+
+    /**
+     * \brief Gets the number of generated packets.
+     */
+    uint32_t GetFloodCount() const { return m_floodCount; }
+
+    /**
+     * \brief Checks the content of a generated packet.
+     * \param pPayload The received packet.
+     * \param len Length of the packet.
+     * \param pSeq Pointer to store the sequence number (may be nullptr).
+     * \return true if the packet is intact.
+     */
+    static bool CheckFloodPacket(const uint8_t *pPayload, uint8_t len, uint32_t *pSeq);
+
+    /**
+     * \brief Gets the number of packets transmitted.
+     */
+    uint32_t GetTxCount() const { return m_txCount; }
+
+    /**
+     * \brief Gets the number of transmissions that failed carrier sense.
+     */
+    uint32_t GetLbtFailCount() const { return m_lbtFailCount; }
+
+    /**
+     * \brief Gets the number of commands received (excluding "@DT").
+     */
+    uint32_t GetCommandCount() const { return m_commandCount; }
+
+    /**
+     * \brief Gets the number of bytes lost because the UART receive buffer was full.
+     */
+    uint32_t GetOverrunCount() const { return m_overrunCount; }
+
+    /**
+     * \brief Gets the timestamps of the last command and its response lines (for "@DT" up to "*DT").
+     * \note The response timestamps are only valid after the response has been read.
+     */
+    const MLR_EmulatorTiming &GetLastTiming() const { return m_timing; }
+
+    // Stream interface
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *pData, size_t len) override;
+    void flush() override;
+
+private:
+    //! Internal: Scheduled response line
+    struct Event
+    {
+        uint32_t dueUs;  //!< micros() timestamp the line starts
+        bool deliver;    //!< The transmission ends, deliver the packet to the peer
+        bool response;   //!< The line answers the last command (see m_timing)
+        uint8_t len;     //!< Length of the line without CR/LF, 0 = none
+        char text[20];   //!< The line
+    };
+
+    //! Internal: Outputs due lines and moves arrived bytes to the UART receive buffer
+    void m_Update(uint32_t now);
+
+    //! Internal: Outputs the lines due by untilUs and completes transmissions ended by then
+    void m_Emit(uint32_t untilUs);
+
+    //! Internal: Queues bytes on the line to the application, starting at atUs (all or nothing)
+    bool m_Output(const uint8_t *pData, uint16_t len, uint32_t atUs);
+
+    //! Internal: Queues a "*DR" telegram
+    MLR_Modem_Error m_OutputDr(const uint8_t *pPayload, uint8_t len, uint32_t atUs);
+
+    //! Internal: Schedules a line answering the last command
+    void m_Schedule(uint32_t dueUs, const char *pText) { m_Schedule(dueUs, pText, true, false); }
+
+    //! Internal: Schedules a line
+    void m_Schedule(uint32_t dueUs, const char *pText, bool response, bool deliver);
+
+    //! Internal: Processes a byte that arrived at the modem at atUs
+    void m_Receive(uint8_t c, uint32_t atUs);
+
+    //! Internal: Executes the command line in m_cmd
+    void m_Command(uint32_t atUs);
+
+    //! Internal: Executes "@DT" with the payload in m_dtBuf
+    void m_Transmit(uint32_t atUs);
+
+    //! Internal: Schedules the line announcing the mode ("LORA CMD MODE")
+    void m_ScheduleModeLine(uint32_t dueUs);
+
+    MLR_ModemEmulator *m_pPeer = nullptr;                  //!< Emulator receiving the transmitted packets
+    uint32_t m_byteUs = 521;                               //!< Character time in microseconds
+    uint16_t m_rxBufferLen = 64;                           //!< Size of the UART receive buffer
+    uint16_t m_txBufferLen = 64;                           //!< Size of the UART transmit buffer
+    uint32_t m_turnaroundUs = MLR_EMULATOR_TURNAROUND_US;  //!< Command turnaround time
+    uint32_t m_saveUs = MLR_EMULATOR_SAVE_US;              //!< Additional time for /W
+    uint32_t m_txSetupUs = MLR_EMULATOR_TX_SETUP_US;       //!< Time from "*DT" to the start of a transmission
+    uint32_t m_bwHz = MLR_EMULATOR_LORA_BW_HZ;             //!< LoRa bandwidth
+    uint32_t m_fskBitrate = MLR_EMULATOR_FSK_BITRATE;      //!< FSK bit rate
+    uint8_t m_lbtFailPct = 0;                              //!< Carrier sense failure probability
+    int16_t m_rssi = -80;                                  //!< RSSI reported by "@RS"
+    uint8_t m_registers[8] = {};                           //!< CH, MO, SF, EI, DI, GI, CI, BR
+
+    // application -> modem
+    uint32_t m_inFreeAt = 0;                               //!< micros() timestamp the last written byte arrives
+    uint8_t m_cmdLen = 0;                                  //!< Bytes of the current command line
+    uint8_t m_cmd[24];                                     //!< Current command line
+    int16_t m_dtLen = -1;                                  //!< Payload length of the current "@DT", -1 = none
+    uint16_t m_dtIdx = 0;                                  //!< Received payload bytes (including CR/LF)
+    uint8_t m_dtBuf[MLR_MAX_PAYLOAD_LEN + 2];              //!< Payload of the current "@DT"
+
+    // radio
+    bool m_txBusy = false;                                 //!< A transmission is on air
+    uint8_t m_txLen = 0;                                   //!< Length of the packet on air
+    uint8_t m_txBuf[MLR_MAX_PAYLOAD_LEN];                  //!< Packet on air
+
+    // modem -> application
+    uint32_t m_outFreeAt = 0;                              //!< micros() timestamp the last queued byte arrives
+    uint8_t m_eventCount = 0;                              //!< Scheduled lines
+    Event m_events[MLR_EMULATOR_MAX_EVENTS];               //!< Scheduled lines, sorted by time
+    uint16_t m_queueHead = 0;                              //!< Index of the oldest byte on the line
+    uint16_t m_queueCount = 0;                             //!< Bytes on the line
+    uint8_t m_queueData[MLR_EMULATOR_QUEUE_LEN];           //!< Bytes on the line
+    uint32_t m_queueReady[MLR_EMULATOR_QUEUE_LEN];         //!< micros() timestamps the bytes arrive
+    uint16_t m_fifoHead = 0;                               //!< Index of the next byte in the UART receive buffer
+    uint16_t m_fifoCount = 0;                              //!< Bytes in the UART receive buffer
+    uint8_t m_fifo[MLR_EMULATOR_UART_BUFFER_LEN];          //!< UART receive buffer
+
+    // generated packets
+    uint8_t m_floodLen = 0;                                //!< Length of the generated packets, 0 = off
+    uint32_t m_floodIntervalUs = 0;                        //!< Interval of the generated packets, 0 = line rate
+    uint32_t m_floodNext = 0;                              //!< micros() timestamp of the next generated packet
+    uint32_t m_floodCount = 0;                             //!< Generated packets
+
+    uint32_t m_txCount = 0;                                //!< Packets transmitted
+    uint32_t m_lbtFailCount = 0;                           //!< Carrier sense failures
+    uint32_t m_commandCount = 0;                           //!< Commands received
+    uint32_t m_overrunCount = 0;                           //!< Bytes lost in the UART receive buffer
+    MLR_EmulatorTiming m_timing = {};                      //!< Timestamps of the last command
+    bool m_responseStarted = false;                        //!< A response line of the last command has been output
+};
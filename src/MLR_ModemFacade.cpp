@@ -0,0 +1,292 @@
+//
+// MLR_ModemFacade.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Thread-safe access to one modem from several tasks or threads.
+//
+
+#include "MLR_ModemFacade.h"
+
+#if !defined(__AVR__)
+#include <string.h>
+
+void MLR_FacadeRequest::SetTransmit(const uint8_t *pData, uint8_t len)
+{
+    m_op = MLR_FacadeOp::Transmit;
+    m_len = len;
+    memcpy(m_data, pData, len);
+}
+
+void MLR_FacadeRequest::SetCommand(MLR_FacadeOp op, int32_t arg, bool saveValue)
+{
+    m_op = op;
+    m_arg = arg;
+    m_saveValue = saveValue;
+}
+
+MLR_Modem_Error MLR_FacadeRequest::Wait(uint32_t timeoutMs) const
+{
+    uint32_t start = millis();
+    while (!IsDone())
+    {
+        if (millis() - start >= timeoutMs)
+        {
+            return MLR_Modem_Error::Busy;
+        }
+        delay(1); // lets the driver thread run on a single core
+    }
+    return m_error;
+}
+
+MLR_FacadeQueue::MLR_FacadeQueue()
+{
+    for (uint32_t i = 0; i < MLR_FACADE_QUEUE_LEN; ++i)
+    {
+        m_cells[i].seq = i;
+        m_cells[i].pRequest = nullptr;
+    }
+}
+
+bool MLR_FacadeQueue::Push(MLR_FacadeRequest *pRequest)
+{
+    Cell *pCell;
+    uint32_t pos = __atomic_load_n(&m_enqueuePos, __ATOMIC_RELAXED);
+    while (true)
+    {
+        pCell = &m_cells[pos & (MLR_FACADE_QUEUE_LEN - 1)];
+        uint32_t seq = __atomic_load_n(&pCell->seq, __ATOMIC_ACQUIRE);
+        int32_t diff = static_cast<int32_t>(seq - pos);
+        if (diff == 0)
+        {
+            // the cell is free for this position; claim the position
+            if (__atomic_compare_exchange_n(&m_enqueuePos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return false; // the cell still holds the request of the previous round
+        }
+        else
+        {
+            pos = __atomic_load_n(&m_enqueuePos, __ATOMIC_RELAXED); // another producer was faster
+        }
+    }
+    pCell->pRequest = pRequest;
+    __atomic_store_n(&pCell->seq, pos + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+MLR_FacadeRequest *MLR_FacadeQueue::Pop()
+{
+    Cell *pCell;
+    uint32_t pos = __atomic_load_n(&m_dequeuePos, __ATOMIC_RELAXED);
+    while (true)
+    {
+        pCell = &m_cells[pos & (MLR_FACADE_QUEUE_LEN - 1)];
+        uint32_t seq = __atomic_load_n(&pCell->seq, __ATOMIC_ACQUIRE);
+        int32_t diff = static_cast<int32_t>(seq - (pos + 1));
+        if (diff == 0)
+        {
+            if (__atomic_compare_exchange_n(&m_dequeuePos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return nullptr; // not filled yet
+        }
+        else
+        {
+            pos = __atomic_load_n(&m_dequeuePos, __ATOMIC_RELAXED);
+        }
+    }
+    MLR_FacadeRequest *pRequest = pCell->pRequest;
+    // free the cell for the producer one round later
+    __atomic_store_n(&pCell->seq, pos + MLR_FACADE_QUEUE_LEN, __ATOMIC_RELEASE);
+    return pRequest;
+}
+
+MLR_Modem_Error MLR_ModemFacade::Submit(MLR_FacadeRequest *pRequest)
+{
+    if (!pRequest->IsDone())
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    // published to the driver thread by the release store of Push()
+    __atomic_store_n(&pRequest->m_done, false, __ATOMIC_RELAXED);
+    MLR_FacadeQueue &queue = (pRequest->m_op == MLR_FacadeOp::Transmit) ? m_transmits : m_commands;
+    if (!queue.Push(pRequest))
+    {
+        __atomic_store_n(&pRequest->m_done, true, __ATOMIC_RELAXED);
+        return MLR_Modem_Error::Busy;
+    }
+    return MLR_Modem_Error::Ok;
+}
+
+bool MLR_ModemFacade::Work()
+{
+    if (!m_pModem)
+    {
+        return false;
+    }
+
+    m_pModem->Work();
+    m_RetryCompletions();
+
+    // commands are short and go first, but a busy command queue must not starve the transmissions
+    MLR_FacadeRequest *pRequest = m_lastWasCommand ? m_transmits.Pop() : nullptr;
+    if (!pRequest)
+    {
+        pRequest = m_commands.Pop();
+    }
+    if (!pRequest)
+    {
+        pRequest = m_transmits.Pop();
+    }
+    if (!pRequest)
+    {
+        return false;
+    }
+    m_lastWasCommand = (pRequest->m_op != MLR_FacadeOp::Transmit);
+
+    m_Execute(pRequest);
+    m_Complete(pRequest);
+    return true;
+}
+
+void MLR_ModemFacade::m_Complete(MLR_FacadeRequest *pRequest)
+{
+    MLR_FacadeQueue *pCompletions = pRequest->m_pCompletions;
+    if (pCompletions)
+    {
+        // a completion must not overtake a deferred one of the same queue
+        bool deferred = false;
+        MLR_FacadeRequest **ppLink = &m_pDeferred;
+        while (*ppLink)
+        {
+            deferred = deferred || ((*ppLink)->m_pCompletions == pCompletions);
+            ppLink = &(*ppLink)->m_pNextDeferred;
+        }
+
+        if (deferred || !pCompletions->Push(pRequest))
+        {
+            // not done yet, the submitter must not reuse the request before it is delivered
+            pRequest->m_pNextDeferred = nullptr;
+            *ppLink = pRequest;
+            return;
+        }
+    }
+
+    // the submitter may reuse the request as soon as it is done, so it is pushed first
+    __atomic_store_n(&pRequest->m_done, true, __ATOMIC_RELEASE);
+}
+
+void MLR_ModemFacade::m_RetryCompletions()
+{
+    MLR_FacadeRequest **ppLink = &m_pDeferred;
+    while (*ppLink)
+    {
+        MLR_FacadeRequest *pRequest = *ppLink;
+        bool blocked = false;
+        for (MLR_FacadeRequest *pPrev = m_pDeferred; pPrev != pRequest; pPrev = pPrev->m_pNextDeferred)
+        {
+            blocked = blocked || (pPrev->m_pCompletions == pRequest->m_pCompletions);
+        }
+
+        if (!blocked && pRequest->m_pCompletions->Push(pRequest))
+        {
+            *ppLink = pRequest->m_pNextDeferred;
+            __atomic_store_n(&pRequest->m_done, true, __ATOMIC_RELEASE);
+        }
+        else
+        {
+            ppLink = &pRequest->m_pNextDeferred;
+        }
+    }
+}
+
+MLR_Modem_Error MLR_ModemFacade::Transmit(const uint8_t *pData, uint8_t len)
+{
+    MLR_FacadeRequest request;
+    request.SetTransmit(pData, len);
+    MLR_Modem_Error rv = Submit(&request);
+    // the driver always finishes a request, the modem calls time out on their own
+    return (rv == MLR_Modem_Error::Ok) ? request.Wait() : rv;
+}
+
+MLR_Modem_Error MLR_ModemFacade::Command(MLR_FacadeOp op, int32_t arg, int32_t *pValue)
+{
+    MLR_FacadeRequest request;
+    request.SetCommand(op, arg);
+    MLR_Modem_Error rv = Submit(&request);
+    if (rv == MLR_Modem_Error::Ok)
+    {
+        rv = request.Wait();
+    }
+    if (rv == MLR_Modem_Error::Ok && pValue)
+    {
+        *pValue = request.GetValue();
+    }
+    return rv;
+}
+
+void MLR_ModemFacade::m_Execute(MLR_FacadeRequest *pRequest)
+{
+    MLR_Modem_Error rv = MLR_Modem_Error::InvalidArg;
+    int32_t value = 0;
+    switch (pRequest->m_op)
+    {
+    case MLR_FacadeOp::Transmit:
+        rv = m_pModem->TransmitData(pRequest->m_data, pRequest->m_len);
+        break;
+    case MLR_FacadeOp::SetChannel:
+        rv = m_pModem->SetChannel(static_cast<uint8_t>(pRequest->m_arg), pRequest->m_saveValue);
+        break;
+    case MLR_FacadeOp::GetChannel:
+    {
+        uint8_t channel{};
+        rv = m_pModem->GetChannel(&channel);
+        value = channel;
+        break;
+    }
+    case MLR_FacadeOp::SetSpreadFactor:
+        rv = m_pModem->SetSpreadFactor(static_cast<MLR_ModemSpreadFactor>(pRequest->m_arg), pRequest->m_saveValue);
+        break;
+    case MLR_FacadeOp::GetSpreadFactor:
+    {
+        MLR_ModemSpreadFactor sf{};
+        rv = m_pModem->GetSpreadFactor(&sf);
+        value = static_cast<int32_t>(sf);
+        break;
+    }
+    case MLR_FacadeOp::GetRssiCurrentChannel:
+    {
+        int16_t rssi{};
+        rv = m_pModem->GetRssiCurrentChannel(&rssi);
+        value = rssi;
+        break;
+    }
+    case MLR_FacadeOp::GetRssiLastRx:
+    {
+        int16_t rssi{};
+        rv = m_pModem->GetRssiLastRx(&rssi);
+        value = rssi;
+        break;
+    }
+    case MLR_FacadeOp::GetSerialNumber:
+    {
+        uint32_t sn{};
+        rv = m_pModem->GetSerialNumber(&sn);
+        value = static_cast<int32_t>(sn);
+        break;
+    }
+    }
+    pRequest->m_error = rv;
+    pRequest->m_value = value;
+}
+
+#endif
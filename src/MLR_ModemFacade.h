@@ -0,0 +1,220 @@
+//
+// MLR_ModemFacade.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Thread-safe access to one modem from several tasks (RTOS) or threads (Linux).
+// MLR_Modem itself is not synchronized: concurrent calls corrupt its receive buffer and response state.
+// With the facade, one driver thread owns the modem and calls MLR_ModemFacade::Work(); every other thread
+// submits requests (transmissions and commands) into bounded lock-free queues (Vyukov's MPMC queue),
+// so submitting never takes a lock and never waits for the modem. Commands are executed before
+// transmissions, which may block the driver thread for the airtime of a packet; while both queues
+// are busy the driver alternates between them, so neither starves.
+//
+// A finished request is published with its result to the submitting thread: the submitter polls
+// IsDone(), blocks in Wait(), or passes a completion queue that it drains in its own loop.
+// Received packets are still delivered by MLR_Modem (callback, hooks) in the driver thread.
+//
+// Not available on AVR (no threads, no lock-free atomics).
+
+#pragma once
+#include "MLR_Modem.h"
+
+#if !defined(__AVR__)
+
+#ifndef MLR_FACADE_QUEUE_LEN
+/**
+ * @brief Capacity of each request queue, a power of two.
+ */
+#define MLR_FACADE_QUEUE_LEN 16
+#endif
+
+static_assert((MLR_FACADE_QUEUE_LEN & (MLR_FACADE_QUEUE_LEN - 1)) == 0, "MLR_FACADE_QUEUE_LEN must be a power of two");
+
+/**
+ * \brief Operations of a facade request.
+ */
+enum class MLR_FacadeOp : uint8_t
+{
+    Transmit,              //!< MLR_Modem::TransmitData(), the result includes carrier sense
+    SetChannel,            //!< MLR_Modem::SetChannel()
+    GetChannel,            //!< MLR_Modem::GetChannel(), the value is the channel
+    SetSpreadFactor,       //!< MLR_Modem::SetSpreadFactor()
+    GetSpreadFactor,       //!< MLR_Modem::GetSpreadFactor(), the value is the MLR_ModemSpreadFactor
+    GetRssiCurrentChannel, //!< MLR_Modem::GetRssiCurrentChannel(), the value is the RSSI in dBm
+    GetRssiLastRx,         //!< MLR_Modem::GetRssiLastRx(), the value is the RSSI in dBm
+    GetSerialNumber,       //!< MLR_Modem::GetSerialNumber(), the value is the serial number
+};
+
+class MLR_FacadeQueue;
+
+/**
+ * \brief A request to the driver thread and its result.
+ * The request is owned by the submitter and must stay valid until IsDone() returns true.
+ */
+class MLR_FacadeRequest
+{
+public:
+    /**
+     * \brief Prepares a transmission. The payload is copied into the request.
+     * \param pData The payload.
+     * \param len Payload length.
+     */
+    void SetTransmit(const uint8_t *pData, uint8_t len);
+
+    /**
+     * \brief Prepares a command.
+     * \param op The operation, not MLR_FacadeOp::Transmit.
+     * \param arg The argument of Set operations (channel or MLR_ModemSpreadFactor).
+     * \param saveValue For Set operations, whether the modem stores the value permanently.
+     */
+    void SetCommand(MLR_FacadeOp op, int32_t arg = 0, bool saveValue = false);
+
+    /**
+     * \brief Sets the queue that receives the request when it is done, or nullptr.
+     * \param pCompletions The completion queue of the submitting thread.
+     * \note The request is pushed to the queue just before it is marked done; if the queue is full, the driver
+     *       keeps the completion and pushes it in a later Work() call. A request taken from the queue may be reused
+     *       once IsDone() returns true (Wait() returns at once).
+     */
+    void SetCompletionQueue(MLR_FacadeQueue *pCompletions) { m_pCompletions = pCompletions; }
+
+    /**
+     * \brief Checks if the driver thread finished the request. Once true, the result is valid in the calling thread.
+     */
+    bool IsDone() const { return __atomic_load_n(&m_done, __ATOMIC_ACQUIRE); }
+
+    /**
+     * \brief Waits until the request is done.
+     * \param timeoutMs Maximum time to wait.
+     * \return The result of the request, or MLR_Modem_Error::Busy if it is not done yet. The request then
+     *         still belongs to the facade and must not be reused or destroyed.
+     */
+    MLR_Modem_Error Wait(uint32_t timeoutMs = UINT32_MAX) const;
+
+    /**
+     * \brief Gets the result of the request. Only valid when IsDone() is true.
+     */
+    MLR_Modem_Error GetError() const { return m_error; }
+
+    /**
+     * \brief Gets the value returned by a Get operation. Only valid when IsDone() is true.
+     */
+    int32_t GetValue() const { return m_value; }
+
+    /**
+     * \brief Gets the operation of the request.
+     */
+    MLR_FacadeOp GetOp() const { return m_op; }
+
+private:
+    friend class MLR_ModemFacade;
+
+    MLR_FacadeOp m_op = MLR_FacadeOp::GetChannel;          //!< Operation
+    bool m_saveValue = false;                              //!< Save flag of Set operations
+    bool m_done = true;                                    //!< Result is published (atomic)
+    uint8_t m_len = 0;                                     //!< Payload length
+    int32_t m_arg = 0;                                     //!< Argument of Set operations
+    int32_t m_value = 0;                                   //!< Value of Get operations
+    MLR_Modem_Error m_error = MLR_Modem_Error::Ok;         //!< Result
+    MLR_FacadeQueue *m_pCompletions = nullptr;             //!< Completion queue, or nullptr
+    MLR_FacadeRequest *m_pNextDeferred = nullptr;          //!< Next completion waiting for its queue (driver thread only)
+    uint8_t m_data[MLR_MAX_PAYLOAD_LEN];                   //!< Payload of a transmission
+};
+
+/**
+ * \brief Bounded lock-free multi-producer multi-consumer queue of requests (Dmitry Vyukov's algorithm).
+ * Every cell carries a sequence number that tells producers and consumers whether it is free or filled,
+ * so a push or pop is one compare-and-swap of the position plus one release store.
+ */
+class MLR_FacadeQueue
+{
+public:
+    MLR_FacadeQueue();
+
+    /**
+     * \brief Appends a request. May be called from any thread.
+     * \return false if the queue is full.
+     */
+    bool Push(MLR_FacadeRequest *pRequest);
+
+    /**
+     * \brief Removes the oldest request. May be called from any thread.
+     * \return The request, or nullptr if the queue is empty.
+     */
+    MLR_FacadeRequest *Pop();
+
+private:
+    //! Internal: One slot of the ring
+    struct Cell
+    {
+        uint32_t seq;                   //!< Position the cell is ready for: pos = free for pos, pos + 1 = filled at pos
+        MLR_FacadeRequest *pRequest;    //!< Stored request
+    };
+
+    Cell m_cells[MLR_FACADE_QUEUE_LEN]; //!< Ring of cells
+    uint32_t m_enqueuePos = 0;          //!< Next position to fill (atomic)
+    uint32_t m_dequeuePos = 0;          //!< Next position to take (atomic)
+};
+
+/**
+ * \brief Thread-safe front end of one MLR_Modem.
+ */
+class MLR_ModemFacade
+{
+public:
+    /**
+     * \brief Attaches the initialized modem driver. From now on only the driver thread may use the modem.
+     * \param modem The modem driver.
+     */
+    void begin(MLR_Modem &modem) { m_pModem = &modem; }
+
+    /**
+     * \brief Submits a request. May be called from any thread.
+     * \param pRequest The prepared request, not in use by the facade.
+     * \return MLR_Modem_Error::Ok if the request was queued, MLR_Modem_Error::Busy if the queue is full,
+     *         MLR_Modem_Error::InvalidArg if the request is still pending.
+     */
+    MLR_Modem_Error Submit(MLR_FacadeRequest *pRequest);
+
+    /**
+     * \brief Processes received data, delivers completions that found their queue full, and executes at most one request.
+     * This function must be called regularly by the driver thread, the only thread that uses the modem.
+     * \return true if a request was executed.
+     */
+    bool Work();
+
+    /**
+     * \brief Transmits a packet and waits for the result. May be called from any thread except the driver thread.
+     * \param pData The payload.
+     * \param len Payload length.
+     * \return The result of MLR_Modem::TransmitData(), or MLR_Modem_Error::Busy if the queue is full.
+     */
+    MLR_Modem_Error Transmit(const uint8_t *pData, uint8_t len);
+
+    /**
+     * \brief Executes a command and waits for the result. May be called from any thread except the driver thread.
+     * \param op The operation.
+     * \param arg The argument of Set operations.
+     * \param pValue Receives the value of Get operations, or nullptr.
+     * \return The result of the operation, or MLR_Modem_Error::Busy if the queue is full.
+     */
+    MLR_Modem_Error Command(MLR_FacadeOp op, int32_t arg = 0, int32_t *pValue = nullptr);
+
+private:
+    //! Internal: Runs a request on the modem
+    void m_Execute(MLR_FacadeRequest *pRequest);
+
+    //! Internal: Delivers the completion of an executed request and marks it done, or defers it if its queue is full
+    void m_Complete(MLR_FacadeRequest *pRequest);
+
+    //! Internal: Retries the deferred completions, in order per completion queue
+    void m_RetryCompletions();
+
+    MLR_Modem *m_pModem = nullptr;                         //!< Driver owned by the driver thread
+    MLR_FacadeQueue m_commands;                            //!< Pending commands
+    MLR_FacadeQueue m_transmits;                           //!< Pending transmissions
+    bool m_lastWasCommand = false;                         //!< Last executed request was a command (driver thread only)
+    MLR_FacadeRequest *m_pDeferred = nullptr;              //!< Completions waiting for their queue (driver thread only)
+};
+
+#endif
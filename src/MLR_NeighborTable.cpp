@@ -0,0 +1,130 @@
+//
+// MLR_NeighborTable.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Neighbor discovery and link-quality table for MLR modems.
+//
+
+#include "MLR_NeighborTable.h"
+
+// weight of a new sample in the smoothed values (1/8); the state is kept scaled by 8,
+// so that differences below one unit are not truncated away
+static constexpr uint8_t MLR_NEIGHBOR_EWMA_SHIFT = 3;
+
+//! Rounds an EWMA state back to the unscaled value
+static int16_t s_EwmaValue(int16_t acc)
+{
+    return static_cast<int16_t>((acc + (1 << (MLR_NEIGHBOR_EWMA_SHIFT - 1))) >> MLR_NEIGHBOR_EWMA_SHIFT);
+}
+
+// sequence gaps larger than this are treated as a restart of the sender, not as loss
+static constexpr uint8_t MLR_NEIGHBOR_MAX_SEQ_GAP = 64;
+
+MLR_Modem_Error MLR_NeighborTable::begin(MLR_Modem &modem, uint32_t beaconIntervalMs)
+{
+    m_pModem = &modem;
+    m_beaconIntervalMs = beaconIntervalMs;
+    m_table.Clear();
+    m_ScheduleBeacon();
+    modem.AddRxHook(this);
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_NeighborTable::end()
+{
+    if (m_pModem)
+    {
+        m_pModem->RemoveRxHook(this);
+        m_pModem = nullptr;
+    }
+}
+
+void MLR_NeighborTable::Work()
+{
+    if (!m_pModem)
+    {
+        return;
+    }
+
+    uint32_t now = millis();
+
+    if (m_timeoutMs != 0)
+    {
+        m_table.RemoveSilent(m_timeoutMs);
+    }
+
+    if (m_beaconIntervalMs != 0 && now - m_lastBeacon >= m_beaconDelay)
+    {
+        // a failed beacon (LBT, busy) is not retried, the next interval will do
+        m_pModem->TransmitFrame(MLR_FrameType::Beacon, nullptr, 0);
+        m_ScheduleBeacon();
+    }
+}
+
+MLR_ModemRxAction MLR_NeighborTable::OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi)
+{
+    MLR_FrameHeader header;
+    if (!MLR_Frame_ParseHeader(pPayload, *pLen, &header))
+    {
+        // not a framed packet, the sender is unknown
+        return MLR_ModemRxAction::Pass;
+    }
+
+    bool created = false;
+    MLR_Neighbor *pEntry = m_table.Insert(header.src, &created);
+
+    if (created)
+    {
+        pEntry->lossPercent = 0;
+        pEntry->lossAcc = 0;
+        pEntry->rssiAvg = rssi;
+        pEntry->rssiAcc = (rssi == MLR_RSSI_UNKNOWN) ? 0 : static_cast<int16_t>(rssi * (1 << MLR_NEIGHBOR_EWMA_SHIFT));
+        pEntry->rxCount = 0;
+    }
+    else
+    {
+        uint8_t gap = static_cast<uint8_t>(header.seq - pEntry->lastSeq);
+        if (gap == 0)
+        {
+            // repeated frame, does not tell anything about loss
+        }
+        else if (gap <= MLR_NEIGHBOR_MAX_SEQ_GAP)
+        {
+            // sample: fraction of frames lost since the last reception, in percent
+            int16_t sample = (100 * (gap - 1) + gap / 2) / gap;
+            pEntry->lossAcc += sample - s_EwmaValue(pEntry->lossAcc);
+            pEntry->lossPercent = static_cast<uint8_t>(s_EwmaValue(pEntry->lossAcc));
+        }
+
+        if (rssi != MLR_RSSI_UNKNOWN)
+        {
+            if (pEntry->rssiAvg == MLR_RSSI_UNKNOWN)
+            {
+                pEntry->rssiAcc = static_cast<int16_t>(rssi * (1 << MLR_NEIGHBOR_EWMA_SHIFT));
+            }
+            else
+            {
+                pEntry->rssiAcc += rssi - s_EwmaValue(pEntry->rssiAcc);
+            }
+            pEntry->rssiAvg = s_EwmaValue(pEntry->rssiAcc);
+        }
+    }
+
+    pEntry->lastSeq = header.seq;
+    pEntry->rssi = rssi;
+    pEntry->lastSeen = millis();
+    if (pEntry->rxCount != 0xFFFF)
+    {
+        ++pEntry->rxCount;
+    }
+
+    return (header.type == MLR_FrameType::Beacon) ? MLR_ModemRxAction::Drop : MLR_ModemRxAction::Pass;
+}
+
+void MLR_NeighborTable::m_ScheduleBeacon()
+{
+    m_lastBeacon = millis();
+    // up to +12.5 % jitter, so that nodes powered up together do not beacon at the same time
+    uint32_t jitter = m_beaconIntervalMs >> 3;
+    m_beaconDelay = m_beaconIntervalMs + ((jitter != 0) ? static_cast<uint32_t>(random(jitter)) : 0);
+}
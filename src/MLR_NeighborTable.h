@@ -0,0 +1,121 @@
+//
+// MLR_NeighborTable.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Neighbor discovery and link-quality table for MLR modems.
+// The table is populated from framed packets (see MLR_Frame.h) received by the driver
+// and from periodic header-only beacons.
+
+#pragma once
+#include "MLR_Modem.h"
+#include "MLR_PeerTable.h"
+
+#ifndef MLR_NEIGHBOR_TABLE_SIZE
+/**
+ * @brief Maximum number of neighbors kept in the table. The least recently seen neighbor is evicted when full.
+ */
+#define MLR_NEIGHBOR_TABLE_SIZE 16
+#endif
+
+/**
+ * @brief Default interval between two beacons in milliseconds.
+ */
+static constexpr uint32_t MLR_NEIGHBOR_BEACON_INTERVAL_MS = 60000;
+
+/**
+ * @brief Default time after which a silent neighbor is removed from the table in milliseconds.
+ */
+static constexpr uint32_t MLR_NEIGHBOR_TIMEOUT_MS = 5 * MLR_NEIGHBOR_BEACON_INTERVAL_MS;
+
+/**
+ * \brief Link information about one neighbor.
+ */
+struct MLR_Neighbor
+{
+    uint8_t id;          //!< Equipment ID of the neighbor
+    uint8_t lastSeq;     //!< Sequence number of the last received frame
+    uint8_t lossPercent; //!< Smoothed frame loss estimate (0-100 %), derived from sequence gaps
+    int16_t rssi;        //!< RSSI of the last received frame in dBm, or MLR_RSSI_UNKNOWN
+    int16_t rssiAvg;     //!< Smoothed RSSI in dBm, or MLR_RSSI_UNKNOWN
+    uint16_t rxCount;    //!< Number of frames received from this neighbor (saturates at 0xFFFF)
+    uint32_t lastSeen;   //!< millis() timestamp of the last received frame
+    uint16_t lossAcc;    //!< Internal: fixed-point state of lossPercent (scaled by 8)
+    int16_t rssiAcc;     //!< Internal: fixed-point state of rssiAvg (scaled by 8)
+};
+
+/**
+ * \brief Table of reachable peers with link quality, populated by the driver's receive path.
+ */
+class MLR_NeighborTable : public MLR_ModemRxHook
+{
+public:
+    /**
+     * \brief Registers the table with the driver.
+     * \param modem The initialized modem driver.
+     * \param beaconIntervalMs Interval between two beacons in milliseconds, 0 disables beacons.
+     * \return MLR_Modem_Error::Ok on success.
+     * \note Enable MLR_Modem::SetRssiEnrichment() to track the RSSI of each neighbor.
+     */
+    MLR_Modem_Error begin(MLR_Modem &modem, uint32_t beaconIntervalMs = MLR_NEIGHBOR_BEACON_INTERVAL_MS);
+
+    /**
+     * \brief Unregisters the table from the driver.
+     */
+    void end();
+
+    /**
+     * \brief Sends due beacons and removes neighbors that timed out.
+     * This function must be called regularly, e.g. after MLR_Modem::Work().
+     */
+    void Work();
+
+    /**
+     * \brief Sets the beacon interval.
+     * \param ms Interval between two beacons in milliseconds, 0 disables beacons.
+     */
+    void SetBeaconInterval(uint32_t ms) { m_beaconIntervalMs = ms; }
+
+    /**
+     * \brief Sets the time after which a silent neighbor is removed.
+     * \param ms Timeout in milliseconds, 0 keeps neighbors until they are evicted.
+     */
+    void SetTimeout(uint32_t ms) { m_timeoutMs = ms; }
+
+    /**
+     * \brief Looks up a neighbor by its Equipment ID.
+     * \param id The Equipment ID.
+     * \return Pointer to the entry, or nullptr if the neighbor is unknown.
+     */
+    const MLR_Neighbor *Find(uint8_t id) const { return m_table.Find(id); }
+
+    /**
+     * \brief Gets the number of known neighbors.
+     */
+    uint8_t GetCount() const { return m_table.GetCount(); }
+
+    /**
+     * \brief Gets a neighbor by table index.
+     * \param idx Index (0 to GetCount() - 1).
+     * \return Pointer to the entry, or nullptr if idx is out of range.
+     */
+    const MLR_Neighbor *GetEntry(uint8_t idx) const { return m_table.GetEntry(idx); }
+
+    /**
+     * \brief Removes all neighbors.
+     */
+    void Clear() { m_table.Clear(); }
+
+    //! Receive hook: updates the table from framed packets, consumes beacons
+    MLR_ModemRxAction OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi) override;
+
+private:
+    //! Internal: Restarts the beacon timer with some jitter to avoid synchronized beacons
+    void m_ScheduleBeacon();
+
+    MLR_Modem *m_pModem = nullptr;                        //!< Driver the table is registered with
+    uint32_t m_beaconIntervalMs = 0;                      //!< Beacon interval, 0 = disabled
+    uint32_t m_timeoutMs = MLR_NEIGHBOR_TIMEOUT_MS;       //!< Neighbor timeout, 0 = disabled
+    uint32_t m_lastBeacon = 0;                            //!< millis() timestamp of the last beacon
+    uint32_t m_beaconDelay = 0;                           //!< Delay until the next beacon (interval + jitter)
+    MLR_PeerTable<MLR_Neighbor, MLR_NEIGHBOR_TABLE_SIZE> m_table; //!< Neighbor entries
+};
@@ -0,0 +1,199 @@
+//
+// MLR_PacketFilter.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Receive-side packet filter evaluated by the driver before callback dispatch.
+//
+
+#include "MLR_PacketFilter.h"
+#include <string.h>
+
+// the token bucket counts in 1/60000 packets, so that a refill is elapsed_ms * framesPerMinute
+static constexpr uint32_t MLR_FILTER_TOKEN_SCALE = 60000;
+
+MLR_Modem_Error MLR_PacketFilter::begin(MLR_Modem &modem, MLR_FilterAction defaultAction)
+{
+    m_pModem = &modem;
+    m_defaultAction = defaultAction;
+    modem.AddRxHook(this, true);
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_PacketFilter::end()
+{
+    if (m_pModem)
+    {
+        m_pModem->RemoveRxHook(this);
+        m_pModem = nullptr;
+    }
+}
+
+int8_t MLR_PacketFilter::AddPrefixRule(MLR_FilterAction action, const uint8_t *pValue, const uint8_t *pMask, uint8_t len, uint8_t offset)
+{
+    if (!pValue || len == 0 || len > MLR_FILTER_MAX_MATCH_LEN)
+    {
+        return -1;
+    }
+
+    Rule *pRule = m_NewRule(action);
+    if (!pRule)
+    {
+        return -1;
+    }
+
+    pRule->offset = offset;
+    pRule->matchLen = len;
+    for (uint8_t i = 0; i < len; ++i)
+    {
+        pRule->mask[i] = pMask ? pMask[i] : 0xFF;
+        pRule->value[i] = pValue[i] & pRule->mask[i];
+    }
+    return static_cast<int8_t>(m_ruleCount - 1);
+}
+
+int8_t MLR_PacketFilter::AddLengthRule(MLR_FilterAction action, uint8_t minLen, uint8_t maxLen)
+{
+    if (minLen > maxLen)
+    {
+        return -1;
+    }
+
+    Rule *pRule = m_NewRule(action);
+    if (!pRule)
+    {
+        return -1;
+    }
+
+    pRule->minLen = minLen;
+    pRule->maxLen = maxLen;
+    return static_cast<int8_t>(m_ruleCount - 1);
+}
+
+MLR_Modem_Error MLR_PacketFilter::SetRateLimit(int8_t rule, uint16_t framesPerMinute, uint8_t burst)
+{
+    if (rule < 0 || rule >= m_ruleCount || m_rules[rule].action != MLR_FilterAction::Accept)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    Rule &r = m_rules[rule];
+    r.ratePerMinute = framesPerMinute;
+    r.burst = (burst == 0) ? 1 : burst;
+    r.tokens = r.burst * MLR_FILTER_TOKEN_SCALE;
+    r.lastRefill = millis();
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_PacketFilter::Clear()
+{
+    m_ruleCount = 0;
+    ResetCounters();
+}
+
+void MLR_PacketFilter::ResetCounters()
+{
+    m_droppedCount = 0;
+    m_rateLimitedCount = 0;
+    m_acceptedCount = 0;
+    for (uint8_t i = 0; i < m_ruleCount; ++i)
+    {
+        m_rules[i].hits = 0;
+    }
+}
+
+MLR_ModemRxAction MLR_PacketFilter::OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi)
+{
+    (void)rssi;
+
+    MLR_FilterAction action = m_defaultAction;
+    for (uint8_t i = 0; i < m_ruleCount; ++i)
+    {
+        Rule &rule = m_rules[i];
+        if (!m_Matches(rule, pPayload, *pLen))
+        {
+            continue;
+        }
+
+        ++rule.hits;
+        action = rule.action;
+        if (action == MLR_FilterAction::Accept && rule.ratePerMinute != 0 && !m_TakeToken(rule))
+        {
+            ++m_rateLimitedCount;
+            action = MLR_FilterAction::Drop;
+        }
+        break;
+    }
+
+    if (action == MLR_FilterAction::Drop)
+    {
+        ++m_droppedCount;
+        return MLR_ModemRxAction::Drop;
+    }
+
+    ++m_acceptedCount;
+    return MLR_ModemRxAction::Pass;
+}
+
+MLR_PacketFilter::Rule *MLR_PacketFilter::m_NewRule(MLR_FilterAction action)
+{
+    if (m_ruleCount >= MLR_FILTER_MAX_RULES)
+    {
+        return nullptr;
+    }
+
+    Rule *pRule = &m_rules[m_ruleCount++];
+    memset(pRule, 0, sizeof(*pRule));
+    pRule->action = action;
+    pRule->maxLen = 0xFF;
+    return pRule;
+}
+
+bool MLR_PacketFilter::m_Matches(const Rule &rule, const uint8_t *pPayload, uint8_t len)
+{
+    if (len < rule.minLen || len > rule.maxLen)
+    {
+        return false;
+    }
+
+    if (static_cast<uint16_t>(rule.offset) + rule.matchLen > len)
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < rule.matchLen; ++i)
+    {
+        if ((pPayload[rule.offset + i] & rule.mask[i]) != rule.value[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MLR_PacketFilter::m_TakeToken(Rule &rule)
+{
+    uint32_t now = millis();
+    uint32_t elapsed = now - rule.lastRefill;
+    uint32_t capacity = rule.burst * MLR_FILTER_TOKEN_SCALE;
+    rule.lastRefill = now;
+
+    // the bucket is full once the missing tokens have been refilled; comparing the time first
+    // keeps elapsed * rate within 32 bit after long idle periods
+    uint32_t missing = capacity - rule.tokens;
+    if (elapsed > missing / rule.ratePerMinute)
+    {
+        rule.tokens = capacity;
+    }
+    else
+    {
+        rule.tokens += elapsed * rule.ratePerMinute;
+    }
+
+    if (rule.tokens < MLR_FILTER_TOKEN_SCALE)
+    {
+        return false;
+    }
+
+    rule.tokens -= MLR_FILTER_TOKEN_SCALE;
+    return true;
+}
@@ -0,0 +1,157 @@
+//
+// MLR_PacketFilter.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Receive-side packet filter evaluated by the driver for every "*DR" telegram,
+// before any other hook and the application callback.
+// Rules are checked in the order they were added; the first matching rule decides.
+
+#pragma once
+#include "MLR_Modem.h"
+
+#ifndef MLR_FILTER_MAX_RULES
+/**
+ * @brief Maximum number of filter rules.
+ */
+#define MLR_FILTER_MAX_RULES 8
+#endif
+
+/**
+ * @brief Maximum number of payload bytes compared by one prefix rule.
+ */
+static constexpr uint8_t MLR_FILTER_MAX_MATCH_LEN = 4;
+
+/**
+ * \brief Action of a filter rule.
+ */
+enum class MLR_FilterAction : uint8_t
+{
+    Accept, //!< Hand the packet on (subject to the rule's rate limit)
+    Drop,   //!< Discard the packet without invoking the callback
+};
+
+/**
+ * \brief Packet filter rule engine.
+ * \note begin() inserts the filter in front of all other receive hooks, so that dropped packets
+ *       are never parsed by them.
+ */
+class MLR_PacketFilter : public MLR_ModemRxHook
+{
+public:
+    /**
+     * \brief Registers the filter with the driver.
+     * \param modem The initialized modem driver.
+     * \param defaultAction Action for packets no rule matches.
+     * \return MLR_Modem_Error::Ok on success.
+     */
+    MLR_Modem_Error begin(MLR_Modem &modem, MLR_FilterAction defaultAction = MLR_FilterAction::Accept);
+
+    /**
+     * \brief Unregisters the filter from the driver.
+     */
+    void end();
+
+    /**
+     * \brief Adds a rule matching masked payload bytes: (payload[offset + i] & pMask[i]) == pValue[i].
+     * \param action Action for matching packets.
+     * \param pValue Bytes to compare with.
+     * \param pMask Mask applied to the payload bytes, or nullptr to compare all bits.
+     * \param len Number of bytes to compare (1-MLR_FILTER_MAX_MATCH_LEN).
+     * \param offset Position of the first compared byte in the payload.
+     * \return Index of the rule, or -1 if the arguments are invalid or the rule table is full.
+     * \note Packets shorter than offset + len never match.
+     */
+    int8_t AddPrefixRule(MLR_FilterAction action, const uint8_t *pValue, const uint8_t *pMask, uint8_t len, uint8_t offset = 0);
+
+    /**
+     * \brief Adds a rule matching the payload length.
+     * \param action Action for matching packets.
+     * \param minLen Minimum payload length (inclusive).
+     * \param maxLen Maximum payload length (inclusive).
+     * \return Index of the rule, or -1 if the arguments are invalid or the rule table is full.
+     */
+    int8_t AddLengthRule(MLR_FilterAction action, uint8_t minLen, uint8_t maxLen);
+
+    /**
+     * \brief Limits the rate of packets accepted by a rule. Excess packets are dropped.
+     * \param rule Index of an Accept rule.
+     * \param framesPerMinute Long-term rate, 0 removes the limit.
+     * \param burst Number of packets that may be accepted back-to-back (at least 1).
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::InvalidArg if the rule does not exist or is a Drop rule.
+     */
+    MLR_Modem_Error SetRateLimit(int8_t rule, uint16_t framesPerMinute, uint8_t burst = 1);
+
+    /**
+     * \brief Sets the action for packets no rule matches.
+     */
+    void SetDefaultAction(MLR_FilterAction action) { m_defaultAction = action; }
+
+    /**
+     * \brief Removes all rules and resets the counters.
+     */
+    void Clear();
+
+    /**
+     * \brief Gets the number of packets a rule matched.
+     * \param rule Index of the rule.
+     */
+    uint32_t GetHits(int8_t rule) const { return (rule >= 0 && rule < m_ruleCount) ? m_rules[rule].hits : 0; }
+
+    /**
+     * \brief Gets the number of packets dropped by the filter (including rate limiting).
+     */
+    uint32_t GetDroppedCount() const { return m_droppedCount; }
+
+    /**
+     * \brief Gets the number of packets dropped because a rule's rate limit was exceeded.
+     */
+    uint32_t GetRateLimitedCount() const { return m_rateLimitedCount; }
+
+    /**
+     * \brief Gets the number of packets handed on by the filter.
+     */
+    uint32_t GetAcceptedCount() const { return m_acceptedCount; }
+
+    /**
+     * \brief Resets all counters.
+     */
+    void ResetCounters();
+
+    //! Receive hook: evaluates the rules
+    MLR_ModemRxAction OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi) override;
+
+private:
+    //! One filter rule
+    struct Rule
+    {
+        MLR_FilterAction action;                 //!< Action for matching packets
+        uint8_t offset;                          //!< Position of the compared bytes
+        uint8_t matchLen;                        //!< Number of compared bytes, 0 = length rule
+        uint8_t value[MLR_FILTER_MAX_MATCH_LEN]; //!< Bytes to compare with (already masked)
+        uint8_t mask[MLR_FILTER_MAX_MATCH_LEN];  //!< Mask for the compared bytes
+        uint8_t minLen;                          //!< Minimum payload length
+        uint8_t maxLen;                          //!< Maximum payload length
+        uint16_t ratePerMinute;                  //!< Rate limit, 0 = unlimited
+        uint8_t burst;                           //!< Token bucket size
+        uint32_t tokens;                         //!< Token bucket level, scaled by 60000 (one packet = 60000)
+        uint32_t lastRefill;                     //!< millis() timestamp of the last refill
+        uint32_t hits;                           //!< Number of matched packets
+    };
+
+    //! Internal: Returns a cleared rule slot, or nullptr if the table is full
+    Rule *m_NewRule(MLR_FilterAction action);
+
+    //! Internal: Checks whether a packet matches a rule
+    static bool m_Matches(const Rule &rule, const uint8_t *pPayload, uint8_t len);
+
+    //! Internal: Takes a token from the rule's bucket, returns false if it is empty
+    static bool m_TakeToken(Rule &rule);
+
+    MLR_Modem *m_pModem = nullptr;                                //!< Driver the filter is registered with
+    MLR_FilterAction m_defaultAction = MLR_FilterAction::Accept;  //!< Action if no rule matches
+    uint8_t m_ruleCount = 0;                                      //!< Number of rules
+    uint32_t m_droppedCount = 0;                                  //!< Dropped packets
+    uint32_t m_rateLimitedCount = 0;                              //!< Packets dropped by rate limits
+    uint32_t m_acceptedCount = 0;                                 //!< Accepted packets
+    Rule m_rules[MLR_FILTER_MAX_RULES];                           //!< Rule table
+};
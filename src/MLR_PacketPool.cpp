@@ -0,0 +1,153 @@
+//
+// MLR_PacketPool.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Fixed-size pool of reference-counted packet buffers.
+//
+
+#include "MLR_PacketPool.h"
+#include "MLR_Modem.h"
+
+#if defined(__AVR__)
+#include <util/atomic.h>
+
+// avr-gcc has no lock-free atomics; a short critical section is enough on the single core
+static bool s_ClaimRef(uint8_t *pRef)
+{
+    bool claimed = false;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (*pRef == 0)
+        {
+            *pRef = 1;
+            claimed = true;
+        }
+    }
+    return claimed;
+}
+
+static void s_AddRef(uint8_t *pRef)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        ++*pRef;
+    }
+}
+
+static bool s_TryAddRef(uint8_t *pRef)
+{
+    bool added = false;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        if (*pRef != 0)
+        {
+            ++*pRef;
+            added = true;
+        }
+    }
+    return added;
+}
+
+static void s_SubRef(uint8_t *pRef)
+{
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+    {
+        --*pRef;
+    }
+}
+
+static uint8_t s_LoadRef(const uint8_t *pRef)
+{
+    return *static_cast<const volatile uint8_t *>(pRef);
+}
+#else
+static bool s_ClaimRef(uint8_t *pRef)
+{
+    uint8_t expected = 0;
+    return __atomic_compare_exchange_n(pRef, &expected, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+static void s_AddRef(uint8_t *pRef)
+{
+    __atomic_add_fetch(pRef, 1, __ATOMIC_RELAXED);
+}
+
+static bool s_TryAddRef(uint8_t *pRef)
+{
+    uint8_t count = __atomic_load_n(pRef, __ATOMIC_RELAXED);
+    while (count != 0)
+    {
+        if (__atomic_compare_exchange_n(pRef, &count, count + 1, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void s_SubRef(uint8_t *pRef)
+{
+    __atomic_sub_fetch(pRef, 1, __ATOMIC_RELEASE);
+}
+
+static uint8_t s_LoadRef(const uint8_t *pRef)
+{
+    return __atomic_load_n(pRef, __ATOMIC_RELAXED);
+}
+#endif
+
+MLR_Packet *MLR_PacketPool::Alloc()
+{
+    for (MLR_Packet &packet : m_packets)
+    {
+        if (s_ClaimRef(&packet.refCount))
+        {
+            packet.len = 0;
+            packet.rssi = MLR_RSSI_UNKNOWN;
+            packet.timestamp = 0;
+            return &packet;
+        }
+    }
+
+    ++m_exhaustedCount;
+    return nullptr;
+}
+
+MLR_Packet *MLR_PacketPool::Acquire(const uint8_t *pPayload)
+{
+    for (MLR_Packet &packet : m_packets)
+    {
+        if (pPayload == packet.data)
+        {
+            // a packet already returned to the pool must not come back to life
+            return s_TryAddRef(&packet.refCount) ? &packet : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+void MLR_PacketPool::Retain(MLR_Packet *pPacket)
+{
+    s_AddRef(&pPacket->refCount);
+}
+
+void MLR_PacketPool::Release(MLR_Packet *pPacket)
+{
+    if (pPacket)
+    {
+        s_SubRef(&pPacket->refCount);
+    }
+}
+
+uint8_t MLR_PacketPool::GetFreeCount() const
+{
+    uint8_t count = 0;
+    for (const MLR_Packet &packet : m_packets)
+    {
+        if (s_LoadRef(&packet.refCount) == 0)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,80 @@
+//
+// MLR_PacketPool.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Fixed-size pool of reference-counted packet buffers.
+// When a pool is attached with MLR_Modem::SetPacketPool(), the driver parses every "*DR" telegram
+// directly into a pool buffer. Consumers (logger, forwarder, ...) take their own reference on the
+// packet instead of copying the payload; the buffer returns to the pool when the last reference is released.
+
+#pragma once
+#include "MLR_Frame.h"
+
+#ifndef MLR_PACKET_POOL_SIZE
+/**
+ * @brief Number of packet buffers in a pool. The driver holds one of them for the latest received packet.
+ */
+#define MLR_PACKET_POOL_SIZE 4
+#endif
+
+/**
+ * \brief A received packet in a pool buffer.
+ */
+struct MLR_Packet
+{
+    uint8_t len;                              //!< Payload length
+    int16_t rssi;                             //!< RSSI in dBm, or MLR_RSSI_UNKNOWN
+    uint32_t timestamp;                       //!< millis() timestamp of the reception
+    uint8_t data[MLR_MAX_PAYLOAD_LEN + 2];    //!< Payload (the parser also stores the trailing CR/LF here)
+    uint8_t refCount;                         //!< Number of references, 0 = free (managed by the pool)
+};
+
+/**
+ * \brief Allocation-free pool of reference-counted packet buffers.
+ * \note Reference counts are updated atomically, so references may be released from another task or an ISR.
+ */
+class MLR_PacketPool
+{
+public:
+    /**
+     * \brief Takes a free buffer from the pool.
+     * \return The packet with one reference, or nullptr if all buffers are in use.
+     */
+    MLR_Packet *Alloc();
+
+    /**
+     * \brief Takes an additional reference on the packet whose payload is pointed to by pPayload.
+     * This is the usual way for a receive hook or the async callback to keep a received packet.
+     * \param pPayload Payload pointer handed to the hook or callback.
+     * \return The packet, or nullptr if pPayload is not the payload of a packet of this pool
+     *         (e.g. the pool was exhausted and the driver fell back to its internal buffer)
+     *         or the packet has already been returned to the pool.
+     */
+    MLR_Packet *Acquire(const uint8_t *pPayload);
+
+    /**
+     * \brief Takes an additional reference on a packet.
+     * \param pPacket The packet. The caller must already hold a reference, use Acquire() otherwise.
+     */
+    static void Retain(MLR_Packet *pPacket);
+
+    /**
+     * \brief Releases a reference. The buffer returns to the pool when the last reference is released.
+     * \param pPacket The packet (nullptr is ignored).
+     */
+    static void Release(MLR_Packet *pPacket);
+
+    /**
+     * \brief Gets the number of free buffers.
+     */
+    uint8_t GetFreeCount() const;
+
+    /**
+     * \brief Gets the number of allocations that failed because all buffers were in use.
+     */
+    uint32_t GetExhaustedCount() const { return m_exhaustedCount; }
+
+private:
+    uint32_t m_exhaustedCount = 0;                    //!< Failed allocations
+    MLR_Packet m_packets[MLR_PACKET_POOL_SIZE] = {};  //!< Packet buffers
+};
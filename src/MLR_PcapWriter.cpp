@@ -0,0 +1,171 @@
+//
+// MLR_PcapWriter.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Radio capture in pcap format.
+//
+// File layout (all values little-endian, see https://www.tcpdump.org/manpages/pcap-savefile.5.html):
+//   file header:   magic(4)=A1B2C3D4 version(2+2)=2.4 thiszone(4) sigfigs(4) snaplen(4) linktype(4)
+//   record header: ts_sec(4) ts_usec(4) incl_len(4) orig_len(4), then the pseudo header and the packet
+//
+
+#include "MLR_PcapWriter.h"
+#include <string.h>
+
+static constexpr uint8_t MLR_PCAP_FILE_HEADER_LEN = 24;
+static constexpr uint8_t MLR_PCAP_RECORD_HEADER_LEN = 16;
+
+MLR_Modem_Error MLR_PcapWriter::begin(MLR_Modem &modem, Print &out, uint32_t startTime)
+{
+    MLR_ModemMode mode;
+    uint8_t channel;
+    MLR_ModemSpreadFactor sf;
+    MLR_Modem_Error rv = modem.GetMode(&mode);
+    if (rv == MLR_Modem_Error::Ok)
+    {
+        rv = modem.GetChannel(&channel);
+    }
+    if (rv == MLR_Modem_Error::Ok)
+    {
+        rv = modem.GetSpreadFactor(&sf);
+    }
+    if (rv != MLR_Modem_Error::Ok)
+    {
+        return rv;
+    }
+    SetLink(mode, channel, sf);
+
+    m_pModem = &modem;
+    m_pOut = &out;
+    m_startTime = startTime;
+    m_lastUs = micros();
+    m_elapsedUs = 0;
+    m_recordCount = 0;
+    m_dropCount = 0;
+    m_head = 0;
+    m_count = 0;
+
+    uint8_t header[MLR_PCAP_FILE_HEADER_LEN] = {};
+    MLR_Frame_PutU32(&header[0], 0xA1B2C3D4UL);
+    MLR_Frame_PutU16(&header[4], 2);
+    MLR_Frame_PutU16(&header[6], 4);
+    MLR_Frame_PutU32(&header[16], MLR_PCAP_PSEUDO_HEADER_LEN + MLR_MAX_PAYLOAD_LEN); // snaplen
+    MLR_Frame_PutU32(&header[20], MLR_PCAP_LINKTYPE);
+    m_Push(header, sizeof(header));
+
+    modem.AddRxHook(this, true);
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_PcapWriter::end()
+{
+    if (m_pModem)
+    {
+        m_pModem->RemoveRxHook(this);
+        m_pModem = nullptr;
+    }
+    if (m_pOut)
+    {
+        Work(m_count);
+        m_pOut->flush();
+        m_pOut = nullptr;
+    }
+}
+
+void MLR_PcapWriter::SetLink(MLR_ModemMode mode, uint8_t channel, MLR_ModemSpreadFactor sf)
+{
+    m_mode = static_cast<uint8_t>(mode);
+    m_channel = channel;
+    m_sf = static_cast<uint8_t>(sf);
+}
+
+size_t MLR_PcapWriter::Work(size_t maxBytes)
+{
+    size_t written = 0;
+    while (m_pOut && m_count > 0 && written < maxBytes)
+    {
+        // up to the end of the buffer, the rest on the next pass
+        size_t len = MLR_PCAP_BUFFER_LEN - m_head;
+        if (len > m_count)
+        {
+            len = m_count;
+        }
+        if (len > maxBytes - written)
+        {
+            len = maxBytes - written;
+        }
+
+        size_t n = m_pOut->write(&m_buffer[m_head], len);
+        m_head = (m_head + n) % MLR_PCAP_BUFFER_LEN;
+        m_count -= n;
+        written += n;
+        if (n < len)
+        {
+            break; // output full
+        }
+    }
+    return written;
+}
+
+MLR_ModemRxAction MLR_PcapWriter::OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi)
+{
+    m_Record(false, pPayload, *pLen, rssi);
+    return MLR_ModemRxAction::Pass;
+}
+
+void MLR_PcapWriter::OnFrameTransmitted(const uint8_t *pPayload, uint8_t len)
+{
+    m_Record(true, pPayload, len, MLR_RSSI_UNKNOWN);
+}
+
+void MLR_PcapWriter::m_Record(bool transmitted, const uint8_t *pPayload, uint8_t len, int16_t rssi)
+{
+    if (!m_pOut)
+    {
+        return;
+    }
+
+    uint16_t recordLen = MLR_PCAP_RECORD_HEADER_LEN + MLR_PCAP_PSEUDO_HEADER_LEN + len;
+    if (recordLen > MLR_PCAP_BUFFER_LEN - m_count)
+    {
+        ++m_dropCount;
+        return;
+    }
+
+    // 64-bit time base, micros() wraps after 71 minutes
+    uint32_t now = micros();
+    m_elapsedUs += now - m_lastUs;
+    m_lastUs = now;
+
+    uint8_t header[MLR_PCAP_RECORD_HEADER_LEN + MLR_PCAP_PSEUDO_HEADER_LEN];
+    MLR_Frame_PutU32(&header[0], m_startTime + static_cast<uint32_t>(m_elapsedUs / 1000000ULL));
+    MLR_Frame_PutU32(&header[4], static_cast<uint32_t>(m_elapsedUs % 1000000ULL));
+    MLR_Frame_PutU32(&header[8], MLR_PCAP_PSEUDO_HEADER_LEN + len);
+    MLR_Frame_PutU32(&header[12], MLR_PCAP_PSEUDO_HEADER_LEN + len);
+
+    uint8_t *pPseudo = &header[MLR_PCAP_RECORD_HEADER_LEN];
+    pPseudo[0] = 0; // version
+    pPseudo[1] = transmitted ? 1 : 0;
+    pPseudo[2] = m_mode;
+    pPseudo[3] = m_channel;
+    pPseudo[4] = m_sf;
+    pPseudo[5] = 0;
+    MLR_Frame_PutU16(&pPseudo[6], static_cast<uint16_t>(rssi));
+
+    m_Push(header, sizeof(header));
+    m_Push(pPayload, len);
+    ++m_recordCount;
+}
+
+void MLR_PcapWriter::m_Push(const uint8_t *pData, uint16_t len)
+{
+    uint16_t tail = (m_head + m_count) % MLR_PCAP_BUFFER_LEN;
+    uint16_t first = MLR_PCAP_BUFFER_LEN - tail;
+    if (first > len)
+    {
+        first = len;
+    }
+    memcpy(&m_buffer[tail], pData, first);
+    memcpy(m_buffer, pData + first, len - first);
+    m_count += len;
+}
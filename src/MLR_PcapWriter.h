@@ -0,0 +1,118 @@
+//
+// MLR_PcapWriter.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Radio capture in pcap format, for inspecting the traffic with Wireshark and other packet tools.
+// Every received "*DR" packet and every packet accepted for transmission with "@DT" becomes one pcap
+// record. The driver hooks only copy the record into a ring buffer; Work() writes the buffer to the
+// output in portions, so the capture never blocks the driver. When the buffer is full, the record is
+// dropped and counted.
+//
+// The file uses the link type MLR_PCAP_LINKTYPE (default LINKTYPE_USER0). Each record starts with an
+// 8-byte pseudo header, followed by the packet as handed to or received from the modem:
+//   version(1)=0  direction(1): 0 = received, 1 = transmitted  mode(1): MLR_ModemMode  channel(1)
+//   spread factor(1): MLR_ModemSpreadFactor  reserved(1)  rssi(2, little-endian, dBm, INT16_MIN = unknown)
+
+#pragma once
+#include "MLR_Modem.h"
+
+#ifndef MLR_PCAP_BUFFER_LEN
+/**
+ * @brief Size of the ring buffer between the driver hooks and the output in bytes.
+ */
+#define MLR_PCAP_BUFFER_LEN 2048
+#endif
+
+#ifndef MLR_PCAP_LINKTYPE
+/**
+ * @brief pcap link type of the capture (147 = LINKTYPE_USER0).
+ */
+#define MLR_PCAP_LINKTYPE 147
+#endif
+
+/**
+ * @brief Length of the pseudo header in front of each packet.
+ */
+static constexpr uint8_t MLR_PCAP_PSEUDO_HEADER_LEN = 8;
+
+/**
+ * \brief Capture of received and transmitted packets in pcap format.
+ */
+class MLR_PcapWriter : public MLR_ModemRxHook
+{
+public:
+    /**
+     * \brief Registers the capture with the driver and queues the pcap file header.
+     * \param modem The initialized modem driver. Mode, channel and spread factor are read from the modem.
+     * \param out Output for the capture file, e.g. an opened SD card file.
+     * \param startTime Unix time of the call in seconds, or 0 for timestamps relative to the start.
+     * \return MLR_Modem_Error::Ok on success, or the error of the modem query.
+     * \note The capture is inserted in front of the registered hooks, so it records the packets
+     *       before any hook changes them (e.g. decryption).
+     */
+    MLR_Modem_Error begin(MLR_Modem &modem, Print &out, uint32_t startTime = 0);
+
+    /**
+     * \brief Unregisters the capture from the driver and writes the remaining buffer (blocking).
+     */
+    void end();
+
+    /**
+     * \brief Updates the link metadata after the application changed the settings.
+     * \param mode The modem mode.
+     * \param channel The channel.
+     * \param sf The spread factor.
+     */
+    void SetLink(MLR_ModemMode mode, uint8_t channel, MLR_ModemSpreadFactor sf);
+
+    /**
+     * \brief Writes buffered records to the output.
+     * This function must be called regularly, e.g. after MLR_Modem::Work().
+     * \param maxBytes Maximum number of bytes to write, e.g. Serial.availableForWrite() for a serial port,
+     *                 so that the call never blocks.
+     * \return Number of bytes written.
+     */
+    size_t Work(size_t maxBytes = 64);
+
+    /**
+     * \brief Gets the number of captured packets.
+     */
+    uint32_t GetRecordCount() const { return m_recordCount; }
+
+    /**
+     * \brief Gets the number of packets dropped because the buffer was full.
+     */
+    uint32_t GetDropCount() const { return m_dropCount; }
+
+    /**
+     * \brief Gets the number of bytes waiting in the buffer.
+     */
+    uint16_t GetPending() const { return m_count; }
+
+    //! Receive hook: captures the packet and passes it on
+    MLR_ModemRxAction OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi) override;
+
+    //! Transmit hook: captures the packet
+    void OnFrameTransmitted(const uint8_t *pPayload, uint8_t len) override;
+
+private:
+    //! Internal: Queues one record, or drops it if it does not fit
+    void m_Record(bool transmitted, const uint8_t *pPayload, uint8_t len, int16_t rssi);
+
+    //! Internal: Appends bytes to the ring buffer
+    void m_Push(const uint8_t *pData, uint16_t len);
+
+    MLR_Modem *m_pModem = nullptr;                         //!< Driver the capture is registered with
+    Print *m_pOut = nullptr;                               //!< Capture output
+    uint32_t m_startTime = 0;                              //!< Unix time of begin()
+    uint32_t m_lastUs = 0;                                 //!< micros() timestamp of the last record
+    uint64_t m_elapsedUs = 0;                              //!< Time from begin() to the last record
+    uint8_t m_mode = 0;                                    //!< Modem mode for the pseudo header
+    uint8_t m_channel = 0;                                 //!< Channel for the pseudo header
+    uint8_t m_sf = 0;                                      //!< Spread factor for the pseudo header
+    uint32_t m_recordCount = 0;                            //!< Captured packets
+    uint32_t m_dropCount = 0;                              //!< Dropped packets
+    uint16_t m_head = 0;                                   //!< Index of the next byte to write to the output
+    uint16_t m_count = 0;                                  //!< Bytes in the buffer
+    uint8_t m_buffer[MLR_PCAP_BUFFER_LEN];                 //!< Ring buffer
+};
@@ -0,0 +1,120 @@
+//
+// MLR_PeerTable.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Fixed-size table of per-peer state keyed by Equipment ID.
+// Shared by the modules that keep state per sender of framed packets. When the table
+// is full, the peer heard longest ago is evicted.
+
+#pragma once
+#include "MLR_Modem.h"
+
+/**
+ * \brief Fixed-size table of per-peer entries with least-recently-heard eviction.
+ * \tparam Entry Entry type with the members `uint8_t id` and `uint32_t lastSeen` (millis() timestamp).
+ * \tparam Size Maximum number of entries (1-255).
+ */
+template <typename Entry, uint8_t Size>
+class MLR_PeerTable
+{
+public:
+    static_assert(Size > 0, "a peer table needs at least one entry");
+
+    /**
+     * \brief Looks up a peer.
+     * \param id The Equipment ID.
+     * \return Pointer to the entry, or nullptr if the peer is unknown.
+     */
+    const Entry *Find(uint8_t id) const
+    {
+        for (uint8_t i = 0; i < m_count; ++i)
+        {
+            if (m_entries[i].id == id)
+            {
+                return &m_entries[i];
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * \brief Looks up a peer.
+     * \param id The Equipment ID.
+     * \return Pointer to the entry, or nullptr if the peer is unknown.
+     */
+    Entry *Find(uint8_t id) { return const_cast<Entry *>(static_cast<const MLR_PeerTable *>(this)->Find(id)); }
+
+    /**
+     * \brief Looks up a peer and inserts it if it is unknown.
+     * If the table is full, the entry of the peer heard longest ago is reused.
+     * \param id The Equipment ID.
+     * \param pCreated Set to true if a new entry was inserted. Only its id is set, the caller initializes the rest.
+     * \return Pointer to the entry.
+     */
+    Entry *Insert(uint8_t id, bool *pCreated)
+    {
+        uint8_t lru = 0;
+        uint32_t now = millis();
+        for (uint8_t i = 0; i < m_count; ++i)
+        {
+            if (m_entries[i].id == id)
+            {
+                *pCreated = false;
+                return &m_entries[i];
+            }
+
+            // millis() wraps, so compare ages instead of timestamps
+            if (now - m_entries[i].lastSeen > now - m_entries[lru].lastSeen)
+            {
+                lru = i;
+            }
+        }
+
+        Entry *pEntry = (m_count < Size) ? &m_entries[m_count++] : &m_entries[lru];
+        pEntry->id = id;
+        *pCreated = true;
+        return pEntry;
+    }
+
+    /**
+     * \brief Removes the peers not heard for longer than a timeout.
+     * \param timeoutMs Timeout in milliseconds.
+     */
+    void RemoveSilent(uint32_t timeoutMs)
+    {
+        uint32_t now = millis();
+        uint8_t i = 0;
+        while (i < m_count)
+        {
+            if (now - m_entries[i].lastSeen > timeoutMs)
+            {
+                m_entries[i] = m_entries[--m_count];
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    /**
+     * \brief Gets the number of known peers.
+     */
+    uint8_t GetCount() const { return m_count; }
+
+    /**
+     * \brief Gets a peer by table index. The order changes when peers are removed.
+     * \param idx Index (0 to GetCount() - 1).
+     * \return Pointer to the entry, or nullptr if idx is out of range.
+     */
+    const Entry *GetEntry(uint8_t idx) const { return (idx < m_count) ? &m_entries[idx] : nullptr; }
+
+    /**
+     * \brief Removes all peers.
+     */
+    void Clear() { m_count = 0; }
+
+private:
+    uint8_t m_count = 0;   //!< Number of valid entries
+    Entry m_entries[Size]; //!< Peer entries
+};
@@ -0,0 +1,130 @@
+//
+// MLR_Profile.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Profiling hooks for the hot path of the driver, enabled with ENABLE_MLR_MODEM_PROFILE (see MLR_Modem.h).
+// Every profiled site accumulates its number of calls, its total time and its longest call in ticks of
+// the fastest clock available: the DWT cycle counter on Cortex-M3/M4/M7/M33, CLOCK_MONOTONIC in
+// nanoseconds on Linux, micros() elsewhere. Sites are measured inclusively: the time of a parser state
+// also contains a stream callback called from it, and Work() contains everything it calls.
+// Without ENABLE_MLR_MODEM_PROFILE the hooks compile to nothing.
+
+#pragma once
+#include <Arduino.h>
+
+#ifdef ENABLE_MLR_MODEM_PROFILE
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+/**
+ * \brief Profiled code sites.
+ */
+enum class MLR_ProfileSite : uint8_t
+{
+    Work,                     //!< MLR_Modem::Work() as a whole
+
+    // one site per MLR_ModemParserState, in the same order: the bytes parsed in that state
+    ParseStart,               //!< Parser state Start
+    ParseCmdFirstLetter,      //!< Parser state ReadCmdFirstLetter
+    ParseCmdSecondLetter,     //!< Parser state ReadCmdSecondLetter
+    ParseCmdParam,            //!< Parser state ReadCmdParam
+    ParseRawString,           //!< Parser state ReadRawString
+    ParseDrSize,              //!< Parser state RadioDrSize
+    ParseDrPayload,           //!< Parser state RadioDrPayload
+    ParseCmdUntilCR,          //!< Parser state ReadCmdUntilCR
+    ParseCmdUntilLF,          //!< Parser state ReadCmdUntilLF
+
+    FlushGarbage,             //!< Discarding garbage after a parser error
+    DispatchResponse,         //!< Dispatching a command response to the async callback
+    HandleDr,                 //!< Handling a received "*DR" telegram, including hooks and callback
+    RxHooks,                  //!< The receive hooks of one telegram
+    TxHooks,                  //!< The transmit hooks of one packet
+    UserCallback,             //!< The async callback
+    StreamCallback,           //!< The streaming receive callback
+
+    Count                     //!< Number of sites
+};
+
+/**
+ * @brief Number of profiled code sites.
+ */
+static constexpr uint8_t MLR_PROFILE_SITES = static_cast<uint8_t>(MLR_ProfileSite::Count);
+
+/**
+ * \brief Accumulated measurements of one site.
+ */
+struct MLR_ProfileEntry
+{
+    uint32_t calls;    //!< Number of measured calls
+    uint32_t maxTicks; //!< Longest call
+    uint64_t ticks;    //!< Total time of all calls
+};
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+// DWT cycle counter (Cortex-M3 and later, not available on Cortex-M0/M0+)
+#define MLR_PROFILE_DEMCR (*reinterpret_cast<volatile uint32_t *>(0xE000EDFCUL))
+#define MLR_PROFILE_DWT_CTRL (*reinterpret_cast<volatile uint32_t *>(0xE0001000UL))
+#define MLR_PROFILE_DWT_CYCCNT (*reinterpret_cast<volatile uint32_t *>(0xE0001004UL))
+
+static inline void MLR_ProfileInit()
+{
+    MLR_PROFILE_DEMCR |= (1UL << 24); // TRCENA
+    MLR_PROFILE_DWT_CTRL |= 1UL;      // CYCCNTENA
+}
+
+static inline uint32_t MLR_ProfileTicks() { return MLR_PROFILE_DWT_CYCCNT; }
+
+//! Ticks per microsecond (the CPU clock in MHz)
+static inline uint32_t MLR_ProfileTicksPerUs() { return F_CPU / 1000000UL; }
+#elif defined(__linux__)
+static inline void MLR_ProfileInit() {}
+
+static inline uint32_t MLR_ProfileTicks()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint32_t>(ts.tv_sec) * 1000000000UL + static_cast<uint32_t>(ts.tv_nsec);
+}
+
+//! Ticks per microsecond (nanoseconds)
+static inline uint32_t MLR_ProfileTicksPerUs() { return 1000; }
+#else
+static inline void MLR_ProfileInit() {}
+
+static inline uint32_t MLR_ProfileTicks() { return micros(); }
+
+//! Ticks per microsecond
+static inline uint32_t MLR_ProfileTicksPerUs() { return 1; }
+#endif
+
+/**
+ * \brief Measures the lifetime of the object and adds it to an entry.
+ */
+class MLR_ProfileScope
+{
+public:
+    explicit MLR_ProfileScope(MLR_ProfileEntry *pEntry) : m_pEntry(pEntry), m_start(MLR_ProfileTicks()) {}
+
+    ~MLR_ProfileScope()
+    {
+        uint32_t ticks = MLR_ProfileTicks() - m_start; // calls are much shorter than the wrap-around
+        ++m_pEntry->calls;
+        m_pEntry->ticks += ticks;
+        if (ticks > m_pEntry->maxTicks)
+        {
+            m_pEntry->maxTicks = ticks;
+        }
+    }
+
+private:
+    MLR_ProfileEntry *m_pEntry; //!< Entry of the measured site
+    uint32_t m_start;           //!< Tick count at construction
+};
+
+//! Measures the rest of the enclosing block as the given MLR_ProfileSite (inside MLR_Modem only)
+#define MLR_PROFILE_SCOPE(site) MLR_ProfileScope mlrProfileScope(&m_profile[static_cast<uint8_t>(site)])
+#else
+#define MLR_PROFILE_SCOPE(site)
+#endif
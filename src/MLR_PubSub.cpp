@@ -0,0 +1,194 @@
+//
+// MLR_PubSub.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Publish/subscribe layer with 1-byte topic IDs.
+//
+// Frame body following the frame header:
+//   Publish: topic(1) value(...)
+//
+
+#include "MLR_PubSub.h"
+#include <string.h>
+
+MLR_Modem_Error MLR_PubSub::begin(MLR_Modem &modem)
+{
+    m_pModem = &modem;
+    modem.AddRxHook(this);
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_PubSub::end()
+{
+    if (m_pModem)
+    {
+        m_pModem->RemoveRxHook(this);
+        m_pModem = nullptr;
+    }
+}
+
+MLR_Modem_Error MLR_PubSub::Subscribe(uint8_t topic, MLR_PubSubHandler pHandler, bool cache)
+{
+    // re-subscribing replaces handler and cache; all slots are checked first, so that a failure keeps the old subscription
+    const Subscription *pOld = m_Find(topic);
+    if (!pHandler && !cache)
+    {
+        Unsubscribe(topic);
+    }
+    else
+    {
+        if (!pOld && m_subscriptionCount >= MLR_PUBSUB_MAX_SUBSCRIPTIONS)
+        {
+            return MLR_Modem_Error::BufferTooSmall;
+        }
+
+        int8_t cacheIdx = -1;
+        if (cache)
+        {
+            cacheIdx = (pOld && pOld->cacheIdx >= 0) ? pOld->cacheIdx : m_FreeCacheSlot();
+            if (cacheIdx < 0)
+            {
+                return MLR_Modem_Error::BufferTooSmall;
+            }
+            m_cache[cacheIdx].valid = false;
+        }
+
+        Subscription &sub = pOld ? m_subscriptions[pOld - m_subscriptions] : m_subscriptions[m_subscriptionCount++];
+        sub.topic = topic;
+        sub.cacheIdx = cacheIdx;
+        sub.pHandler = pHandler;
+    }
+
+    m_subscribed[topic >> 3] |= (1 << (topic & 7));
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_PubSub::Unsubscribe(uint8_t topic)
+{
+    m_subscribed[topic >> 3] &= ~(1 << (topic & 7));
+
+    for (uint8_t i = 0; i < m_subscriptionCount; ++i)
+    {
+        if (m_subscriptions[i].topic == topic)
+        {
+            m_subscriptions[i] = m_subscriptions[--m_subscriptionCount];
+            return;
+        }
+    }
+}
+
+MLR_Modem_Error MLR_PubSub::Publish(uint8_t topic, const uint8_t *pValue, uint8_t len)
+{
+    if (!m_pModem)
+    {
+        return MLR_Modem_Error::Fail;
+    }
+
+    if (len > MLR_PUBSUB_MAX_VALUE_LEN || (len > 0 && !pValue))
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    uint8_t body[MLR_FRAME_MAX_PAYLOAD_LEN];
+    body[0] = topic;
+    if (len > 0)
+    {
+        memcpy(&body[1], pValue, len);
+    }
+    return m_pModem->TransmitFrame(MLR_FrameType::Publish, body, len + 1);
+}
+
+MLR_Modem_Error MLR_PubSub::GetLatest(uint8_t topic, const uint8_t **ppValue, uint8_t *pLen, uint32_t *pAgeMs) const
+{
+    const Subscription *pSub = m_Find(topic);
+    if (!pSub || pSub->cacheIdx < 0 || !m_cache[pSub->cacheIdx].valid)
+    {
+        return MLR_Modem_Error::Fail;
+    }
+
+    const CacheEntry &entry = m_cache[pSub->cacheIdx];
+    *ppValue = entry.value;
+    *pLen = entry.len;
+    if (pAgeMs)
+    {
+        *pAgeMs = millis() - entry.timestamp;
+    }
+    return MLR_Modem_Error::Ok;
+}
+
+MLR_ModemRxAction MLR_PubSub::OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi)
+{
+    (void)rssi;
+
+    // check the type byte first, most frames are not published values
+    if (*pLen <= MLR_FRAME_HEADER_LEN || pPayload[0] != static_cast<uint8_t>(MLR_FrameType::Publish) ||
+        !MLR_Frame_ParseHeader(pPayload, *pLen, nullptr))
+    {
+        return MLR_ModemRxAction::Pass;
+    }
+
+    uint8_t topic = pPayload[MLR_FRAME_HEADER_LEN];
+    if (!IsSubscribed(topic))
+    {
+        ++m_filteredCount;
+        return MLR_ModemRxAction::Drop;
+    }
+
+    const Subscription *pSub = m_Find(topic);
+    if (!pSub)
+    {
+        // subscribed without handler: the application gets the whole frame
+        return MLR_ModemRxAction::Pass;
+    }
+
+    const uint8_t *pValue = &pPayload[MLR_FRAME_HEADER_LEN + 1];
+    uint8_t len = *pLen - MLR_FRAME_HEADER_LEN - 1;
+
+    if (pSub->cacheIdx >= 0)
+    {
+        CacheEntry &entry = m_cache[pSub->cacheIdx];
+        entry.len = (len < MLR_PUBSUB_CACHE_LEN) ? len : MLR_PUBSUB_CACHE_LEN;
+        memcpy(entry.value, pValue, entry.len);
+        entry.timestamp = millis();
+        entry.valid = true;
+    }
+
+    if (!pSub->pHandler)
+    {
+        // cached only: the application gets the whole frame as well
+        return MLR_ModemRxAction::Pass;
+    }
+
+    pSub->pHandler(topic, pPayload[1], pValue, len);
+    return MLR_ModemRxAction::Drop;
+}
+
+const MLR_PubSub::Subscription *MLR_PubSub::m_Find(uint8_t topic) const
+{
+    for (uint8_t i = 0; i < m_subscriptionCount; ++i)
+    {
+        if (m_subscriptions[i].topic == topic)
+        {
+            return &m_subscriptions[i];
+        }
+    }
+    return nullptr;
+}
+
+int8_t MLR_PubSub::m_FreeCacheSlot() const
+{
+    for (int8_t slot = 0; slot < MLR_PUBSUB_MAX_CACHED; ++slot)
+    {
+        bool used = false;
+        for (uint8_t i = 0; i < m_subscriptionCount; ++i)
+        {
+            used |= (m_subscriptions[i].cacheIdx == slot);
+        }
+
+        if (!used)
+        {
+            return slot;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,163 @@
+//
+// MLR_PubSub.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Publish/subscribe layer with 1-byte topic IDs on top of the MLR frame header.
+// Published values of topics this node has not subscribed to are dropped inside the driver,
+// before the application callback is invoked.
+
+#pragma once
+#include "MLR_Modem.h"
+
+#ifndef MLR_PUBSUB_MAX_SUBSCRIPTIONS
+/**
+ * @brief Maximum number of topics with a handler or a latest-value cache.
+ */
+#define MLR_PUBSUB_MAX_SUBSCRIPTIONS 8
+#endif
+
+#ifndef MLR_PUBSUB_MAX_CACHED
+/**
+ * @brief Maximum number of topics keeping their latest value.
+ */
+#define MLR_PUBSUB_MAX_CACHED 4
+#endif
+
+#ifndef MLR_PUBSUB_CACHE_LEN
+/**
+ * @brief Number of bytes kept per cached value. Longer values are truncated in the cache.
+ */
+#define MLR_PUBSUB_CACHE_LEN 32
+#endif
+
+/**
+ * @brief Maximum length of a published value.
+ */
+static constexpr uint8_t MLR_PUBSUB_MAX_VALUE_LEN = MLR_FRAME_MAX_PAYLOAD_LEN - 1;
+
+//! Internal: FNV-1a hash evaluated at compile time
+constexpr uint32_t MLR_PubSub_Fnv1a(const char *pName, uint32_t hash = 2166136261u)
+{
+    return (*pName == 0) ? hash : MLR_PubSub_Fnv1a(pName + 1, (hash ^ static_cast<uint8_t>(*pName)) * 16777619u);
+}
+
+/**
+ * \brief Maps a topic name to its 1-byte topic ID (evaluated at compile time for string literals).
+ * \param pName The null-terminated topic name, e.g. "temp".
+ * \return The topic ID.
+ * \note Different names may map to the same ID; use explicit IDs if a fleet has many topics.
+ */
+constexpr uint8_t MLR_PubSub_TopicId(const char *pName)
+{
+    return static_cast<uint8_t>(MLR_PubSub_Fnv1a(pName) ^ (MLR_PubSub_Fnv1a(pName) >> 8) ^
+                                (MLR_PubSub_Fnv1a(pName) >> 16) ^ (MLR_PubSub_Fnv1a(pName) >> 24));
+}
+
+/**
+ * \brief Callback for received values of a subscribed topic.
+ * \param topic The topic ID.
+ * \param src Equipment ID of the publisher.
+ * \param pValue Pointer to the value (only valid during the callback).
+ * \param len Length of the value.
+ */
+typedef void (*MLR_PubSubHandler)(uint8_t topic, uint8_t src, const uint8_t *pValue, uint8_t len);
+
+/**
+ * \brief Publish/subscribe layer with per-topic filtering and latest-value caches.
+ */
+class MLR_PubSub : public MLR_ModemRxHook
+{
+public:
+    /**
+     * \brief Registers the layer with the driver.
+     * \param modem The initialized modem driver.
+     * \return MLR_Modem_Error::Ok on success.
+     */
+    MLR_Modem_Error begin(MLR_Modem &modem);
+
+    /**
+     * \brief Unregisters the layer from the driver.
+     */
+    void end();
+
+    /**
+     * \brief Subscribes to a topic.
+     * \param topic The topic ID.
+     * \param pHandler Callback for received values. If nullptr, the whole frame is passed to the
+     *                 application callback as MLR_Modem_Response::DataReceived.
+     * \param cache If true, the latest value is kept and can be read with GetLatest().
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::BufferTooSmall if no subscription or cache slot is free.
+     *         On failure an existing subscription of the topic is kept unchanged.
+     */
+    MLR_Modem_Error Subscribe(uint8_t topic, MLR_PubSubHandler pHandler = nullptr, bool cache = false);
+
+    /**
+     * \brief Unsubscribes from a topic and frees its handler and cache.
+     * \param topic The topic ID.
+     */
+    void Unsubscribe(uint8_t topic);
+
+    /**
+     * \brief Checks if a topic is subscribed.
+     * \param topic The topic ID.
+     */
+    bool IsSubscribed(uint8_t topic) const { return (m_subscribed[topic >> 3] & (1 << (topic & 7))) != 0; }
+
+    /**
+     * \brief Publishes a value.
+     * \param topic The topic ID.
+     * \param pValue Pointer to the value.
+     * \param len Length of the value (0-MLR_PUBSUB_MAX_VALUE_LEN bytes).
+     * \return Same as MLR_Modem::TransmitData().
+     */
+    MLR_Modem_Error Publish(uint8_t topic, const uint8_t *pValue, uint8_t len);
+
+    /**
+     * \brief Gets the latest cached value of a topic.
+     * \param topic The topic ID.
+     * \param ppValue Pointer set to the cached value. Valid until the next value of the topic is received.
+     * \param pLen Pointer to store the length of the cached value.
+     * \param pAgeMs Pointer to store the age of the value in milliseconds (may be nullptr).
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::Fail if the topic is not cached or no value was received yet.
+     */
+    MLR_Modem_Error GetLatest(uint8_t topic, const uint8_t **ppValue, uint8_t *pLen, uint32_t *pAgeMs = nullptr) const;
+
+    /**
+     * \brief Gets the number of published values dropped because the topic is not subscribed.
+     */
+    uint32_t GetFilteredCount() const { return m_filteredCount; }
+
+    //! Receive hook: dispatches values of subscribed topics, drops the others
+    MLR_ModemRxAction OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi) override;
+
+private:
+    //! Subscription with handler and optional cache slot
+    struct Subscription
+    {
+        uint8_t topic;              //!< Topic ID
+        int8_t cacheIdx;            //!< Index into m_cache, -1 if not cached
+        MLR_PubSubHandler pHandler; //!< Handler, nullptr = pass to the application
+    };
+
+    //! Latest value of a cached topic
+    struct CacheEntry
+    {
+        bool valid;                         //!< A value has been received
+        uint8_t len;                        //!< Length of the stored value
+        uint32_t timestamp;                 //!< millis() timestamp of reception
+        uint8_t value[MLR_PUBSUB_CACHE_LEN]; //!< Stored value (truncated)
+    };
+
+    //! Internal: Returns the subscription entry of a topic, or nullptr
+    const Subscription *m_Find(uint8_t topic) const;
+
+    //! Internal: Returns a cache slot not used by any subscription, or -1
+    int8_t m_FreeCacheSlot() const;
+
+    MLR_Modem *m_pModem = nullptr;                               //!< Driver the layer is registered with
+    uint32_t m_filteredCount = 0;                                //!< Values dropped by the subscription filter
+    uint8_t m_subscriptionCount = 0;                             //!< Number of entries in m_subscriptions
+    uint8_t m_subscribed[256 / 8] = {};                          //!< Bitmap of subscribed topics (O(1) filter)
+    Subscription m_subscriptions[MLR_PUBSUB_MAX_SUBSCRIPTIONS];  //!< Topics with handler or cache
+    CacheEntry m_cache[MLR_PUBSUB_MAX_CACHED];                   //!< Latest-value caches
+};
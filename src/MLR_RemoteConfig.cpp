@@ -0,0 +1,563 @@
+//
+// MLR_RemoteConfig.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Over-the-air change of radio settings across a group of modems.
+//
+// Frame bodies following the frame header (all values little-endian):
+//   ConfigSet: version(4) attempt(1) delay_ms(4) window_ms(2) count(1) items(2 * count) acked(...) tag(8)
+//              items: param(1) value(1); acked: bitmap of confirmed nodes (bit n = Equipment ID n),
+//              trailing zero bytes omitted; count 0 cancels the change
+//   ConfigAck: version(4) attempt(1) bitmap(...) tag(8)
+//              attempt: the broadcast that triggered the ACK, a node acknowledges each broadcast at most once
+// The tag authenticates the body (Poly1305 with an empty ChaCha20-Poly1305 plaintext).
+// Nonce: src(1) version(4) attempt(1) zero(5) domain(1) - 0xA0 for ConfigSet, 0xA1 for ConfigAck; the domain
+// also separates the nonces from MLR_SecureChannel nonces.
+//
+
+#include "MLR_RemoteConfig.h"
+#include <string.h>
+
+static constexpr uint8_t MLR_CONFIG_SET_HEADER_LEN = 12;
+static constexpr uint8_t MLR_CONFIG_ACK_HEADER_LEN = 5;
+static constexpr uint8_t MLR_CONFIG_NONCE_SET = 0xA0;
+static constexpr uint8_t MLR_CONFIG_NONCE_ACK = 0xA1;
+
+// the last broadcast numbers are kept for cancellations
+static constexpr uint8_t MLR_CONFIG_MAX_BROADCASTS = 250;
+static constexpr uint8_t MLR_CONFIG_CANCEL_REPEATS = 3;
+
+static inline bool s_TestBit(const uint8_t *pBitmap, uint8_t idx)
+{
+    return (pBitmap[idx >> 3] & (1 << (idx & 7))) != 0;
+}
+
+static inline void s_SetBit(uint8_t *pBitmap, uint8_t idx)
+{
+    pBitmap[idx >> 3] |= (1 << (idx & 7));
+}
+
+//! Length of a 256-bit bitmap without trailing zero bytes
+static uint8_t s_BitmapLen(const uint8_t *pBitmap)
+{
+    uint8_t len = 32;
+    while (len > 0 && pBitmap[len - 1] == 0)
+    {
+        --len;
+    }
+    return len;
+}
+
+static void s_Nonce(uint8_t src, uint32_t version, uint8_t attempt, uint8_t domain, uint8_t *pNonce)
+{
+    memset(pNonce, 0, MLR_AEAD_NONCE_LEN);
+    pNonce[0] = src;
+    MLR_Frame_PutU32(&pNonce[1], version);
+    pNonce[5] = attempt;
+    pNonce[MLR_AEAD_NONCE_LEN - 1] = domain;
+}
+
+//! Verifies a ConfigAck body of a sender, returns false if it is malformed or forged
+static bool s_VerifyAck(const uint8_t *pKey, uint8_t src, const uint8_t *pBody, uint8_t bodyLen)
+{
+    if (bodyLen <= MLR_CONFIG_ACK_HEADER_LEN + MLR_CONFIG_TAG_LEN)
+    {
+        return false;
+    }
+
+    uint8_t signedLen = bodyLen - MLR_CONFIG_TAG_LEN;
+    uint8_t nonce[MLR_AEAD_NONCE_LEN];
+    s_Nonce(src, MLR_Frame_GetU32(pBody), pBody[4], MLR_CONFIG_NONCE_ACK, nonce);
+    return MLR_Aead_Open(pKey, nonce, pBody, signedLen, nullptr, 0, &pBody[signedLen], MLR_CONFIG_TAG_LEN);
+}
+
+static bool s_IsValidItem(const MLR_ConfigItem &item)
+{
+    switch (item.param)
+    {
+    case MLR_ConfigParam::Mode:
+        return item.value == static_cast<uint8_t>(MLR_ModemMode::FskCmd) || item.value == static_cast<uint8_t>(MLR_ModemMode::LoRaCmd);
+    case MLR_ConfigParam::SpreadFactor:
+        return item.value <= static_cast<uint8_t>(MLR_ModemSpreadFactor::Chips4096);
+    case MLR_ConfigParam::Channel:
+    case MLR_ConfigParam::GroupId:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static MLR_Modem_Error s_Apply(MLR_Modem &modem, const MLR_ConfigItem *pItems, uint8_t count, bool save)
+{
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        MLR_Modem_Error rv = MLR_Modem_Error::InvalidArg;
+        switch (pItems[i].param)
+        {
+        case MLR_ConfigParam::Mode:
+            rv = modem.SetMode(static_cast<MLR_ModemMode>(pItems[i].value), save);
+            break;
+        case MLR_ConfigParam::SpreadFactor:
+            rv = modem.SetSpreadFactor(static_cast<MLR_ModemSpreadFactor>(pItems[i].value), save);
+            break;
+        case MLR_ConfigParam::Channel:
+            rv = modem.SetChannel(pItems[i].value, save);
+            break;
+        case MLR_ConfigParam::GroupId:
+            rv = modem.SetGroupID(pItems[i].value, save);
+            break;
+        }
+
+        if (rv != MLR_Modem_Error::Ok)
+        {
+            return rv;
+        }
+    }
+    return MLR_Modem_Error::Ok;
+}
+
+// ----------------------------------------------------------------------------
+// MLR_ConfigSender
+// ----------------------------------------------------------------------------
+
+MLR_Modem_Error MLR_ConfigSender::begin(MLR_Modem &modem, const uint8_t *pKey)
+{
+    if (!pKey)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    MLR_Modem_Error rv = modem.GetEquipmentID(&m_src);
+    if (rv != MLR_Modem_Error::Ok)
+    {
+        return rv;
+    }
+
+    memcpy(m_key, pKey, sizeof(m_key));
+    m_state = MLR_ConfigState::Idle;
+    m_pModem = &modem;
+    modem.AddRxHook(this);
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_ConfigSender::end()
+{
+    if (m_pModem)
+    {
+        m_pModem->RemoveRxHook(this);
+        m_pModem = nullptr;
+    }
+    m_state = MLR_ConfigState::Idle;
+    memset(m_key, 0, sizeof(m_key));
+}
+
+MLR_Modem_Error MLR_ConfigSender::Start(uint32_t version, const MLR_ConfigItem *pItems, uint8_t count,
+                                        uint32_t activationDelayMs, const uint8_t *pNodes, uint8_t nodeCount)
+{
+    if (!m_pModem)
+    {
+        return MLR_Modem_Error::Fail;
+    }
+
+    if (m_state == MLR_ConfigState::Broadcasting || m_state == MLR_ConfigState::Collecting ||
+        m_state == MLR_ConfigState::Pending || m_state == MLR_ConfigState::Canceling)
+    {
+        return MLR_Modem_Error::Busy;
+    }
+
+    // one window to collect ACKs and one to cancel in time
+    if (!pItems || count == 0 || count > MLR_CONFIG_MAX_ITEMS || !pNodes || nodeCount == 0 ||
+        version <= m_version || activationDelayMs <= 2UL * m_ackWindowMs || activationDelayMs > INT32_MAX)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        if (!s_IsValidItem(pItems[i]))
+        {
+            return MLR_Modem_Error::InvalidArg;
+        }
+    }
+
+    m_version = version;
+    m_count = count;
+    memcpy(m_items, pItems, count * sizeof(MLR_ConfigItem));
+    memset(m_expected, 0, sizeof(m_expected));
+    memset(m_acked, 0, sizeof(m_acked));
+    for (uint8_t i = 0; i < nodeCount; ++i)
+    {
+        s_SetBit(m_expected, pNodes[i]);
+    }
+
+    m_attempt = 0;
+    m_activation = millis() + activationDelayMs;
+    m_state = MLR_ConfigState::Broadcasting;
+    return MLR_Modem_Error::Ok;
+}
+
+uint16_t MLR_ConfigSender::GetMissingCount() const
+{
+    uint16_t missing = 0;
+    for (uint8_t i = 0; i < sizeof(m_expected); ++i)
+    {
+        uint8_t bits = m_expected[i] & ~m_acked[i];
+        while (bits)
+        {
+            bits &= bits - 1;
+            ++missing;
+        }
+    }
+    return missing;
+}
+
+void MLR_ConfigSender::Work()
+{
+    int32_t remaining = static_cast<int32_t>(m_activation - millis());
+
+    switch (m_state)
+    {
+    case MLR_ConfigState::Broadcasting:
+    {
+        if (remaining <= 2L * m_ackWindowMs || m_attempt >= MLR_CONFIG_MAX_BROADCASTS)
+        {
+            m_cancelsLeft = MLR_CONFIG_CANCEL_REPEATS;
+            m_state = MLR_ConfigState::Canceling;
+            break;
+        }
+
+        // on failure (e.g. LBT) the broadcast is retried on the next call
+        if (m_SendSet(m_count, static_cast<uint32_t>(remaining)) == MLR_Modem_Error::Ok)
+        {
+            m_windowStart = millis();
+            m_state = MLR_ConfigState::Collecting;
+        }
+        break;
+    }
+
+    case MLR_ConfigState::Collecting:
+    {
+        if (GetMissingCount() == 0)
+        {
+            m_state = MLR_ConfigState::Pending;
+        }
+        else if (millis() - m_windowStart >= m_ackWindowMs)
+        {
+            m_state = MLR_ConfigState::Broadcasting;
+        }
+        break;
+    }
+
+    case MLR_ConfigState::Canceling:
+    {
+        if (m_cancelsLeft == 0 || m_attempt == UINT8_MAX)
+        {
+            m_state = MLR_ConfigState::Failed;
+        }
+        else if (m_SendSet(0, 0) == MLR_Modem_Error::Ok)
+        {
+            --m_cancelsLeft;
+        }
+        break;
+    }
+
+    case MLR_ConfigState::Pending:
+    {
+        if (remaining <= 0)
+        {
+            bool ok = (s_Apply(*m_pModem, m_items, m_count, m_saveValues) == MLR_Modem_Error::Ok);
+            m_state = ok ? MLR_ConfigState::Done : MLR_ConfigState::Failed;
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+MLR_Modem_Error MLR_ConfigSender::m_SendSet(uint8_t count, uint32_t delayMs)
+{
+    if (m_attempt == UINT8_MAX)
+    {
+        return MLR_Modem_Error::Fail; // the broadcast number is part of the nonce and must not wrap
+    }
+
+    uint8_t frame[MLR_FRAME_MAX_PAYLOAD_LEN];
+    uint8_t attempt = m_attempt++;
+
+    MLR_Frame_PutU32(&frame[0], m_version);
+    frame[4] = attempt;
+    MLR_Frame_PutU32(&frame[5], delayMs);
+    MLR_Frame_PutU16(&frame[9], m_ackWindowMs);
+    frame[11] = count;
+
+    uint8_t len = MLR_CONFIG_SET_HEADER_LEN;
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        frame[len++] = static_cast<uint8_t>(m_items[i].param);
+        frame[len++] = m_items[i].value;
+    }
+
+    if (count > 0)
+    {
+        // nodes that already confirmed stay silent
+        uint8_t ackedLen = s_BitmapLen(m_acked);
+        memcpy(&frame[len], m_acked, ackedLen);
+        len += ackedLen;
+    }
+
+    uint8_t nonce[MLR_AEAD_NONCE_LEN];
+    s_Nonce(m_src, m_version, attempt, MLR_CONFIG_NONCE_SET, nonce);
+    MLR_Aead_Seal(m_key, nonce, frame, len, nullptr, 0, &frame[len], MLR_CONFIG_TAG_LEN);
+
+    return m_pModem->TransmitFrame(MLR_FrameType::ConfigSet, frame, len + MLR_CONFIG_TAG_LEN);
+}
+
+MLR_ModemRxAction MLR_ConfigSender::OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi)
+{
+    (void)rssi;
+
+    MLR_FrameHeader header;
+    if (!MLR_Frame_ParseHeader(pPayload, *pLen, &header) || header.type != MLR_FrameType::ConfigAck)
+    {
+        return MLR_ModemRxAction::Pass;
+    }
+
+    const uint8_t *pBody = &pPayload[MLR_FRAME_HEADER_LEN];
+    uint8_t bodyLen = *pLen - MLR_FRAME_HEADER_LEN;
+    if (bodyLen > MLR_CONFIG_ACK_HEADER_LEN && MLR_Frame_GetU32(pBody) == m_version &&
+        (m_state == MLR_ConfigState::Broadcasting || m_state == MLR_ConfigState::Collecting))
+    {
+        if (!s_VerifyAck(m_key, header.src, pBody, bodyLen))
+        {
+            ++m_authFailCount;
+            return MLR_ModemRxAction::Drop;
+        }
+
+        uint8_t bitmapLen = bodyLen - MLR_CONFIG_ACK_HEADER_LEN - MLR_CONFIG_TAG_LEN;
+        for (uint8_t i = 0; i < bitmapLen && i < sizeof(m_acked); ++i)
+        {
+            m_acked[i] |= pBody[MLR_CONFIG_ACK_HEADER_LEN + i];
+        }
+    }
+    return MLR_ModemRxAction::Drop;
+}
+
+// ----------------------------------------------------------------------------
+// MLR_ConfigReceiver
+// ----------------------------------------------------------------------------
+
+MLR_Modem_Error MLR_ConfigReceiver::begin(MLR_Modem &modem, const uint8_t *pKey, uint32_t appliedVersion,
+                                          MLR_ConfigAppliedCallback pApplied)
+{
+    if (!pKey)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    MLR_Modem_Error rv = modem.GetEquipmentID(&m_src);
+    if (rv != MLR_Modem_Error::Ok)
+    {
+        return rv;
+    }
+
+    memcpy(m_key, pKey, sizeof(m_key));
+    m_appliedVersion = appliedVersion;
+    m_canceledVersion = 0;
+    m_pApplied = pApplied;
+    m_state = MLR_ConfigState::Idle;
+    m_ackDue = false;
+    m_pModem = &modem;
+    modem.AddRxHook(this);
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_ConfigReceiver::end()
+{
+    if (m_pModem)
+    {
+        m_pModem->RemoveRxHook(this);
+        m_pModem = nullptr;
+    }
+    memset(m_key, 0, sizeof(m_key));
+}
+
+void MLR_ConfigReceiver::Work()
+{
+    if (!m_pModem || m_state != MLR_ConfigState::Pending)
+    {
+        return;
+    }
+
+    if (static_cast<int32_t>(m_activation - millis()) <= 0)
+    {
+        m_ackDue = false;
+        MLR_Modem_Error rv = s_Apply(*m_pModem, m_items, m_count, m_saveValues);
+        m_appliedVersion = m_pendingVersion;
+        m_state = MLR_ConfigState::Done;
+        if (m_pApplied)
+        {
+            m_pApplied(m_appliedVersion, rv);
+        }
+    }
+    else if (m_ackDue && millis() - m_ackScheduled >= m_ackDelay)
+    {
+        // an ACK lost to LBT is not retried: the gateway broadcasts again
+        m_ackDue = false;
+        m_SendAck();
+    }
+}
+
+MLR_ModemRxAction MLR_ConfigReceiver::OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi)
+{
+    (void)rssi;
+
+    MLR_FrameHeader header;
+    if (!MLR_Frame_ParseHeader(pPayload, *pLen, &header))
+    {
+        return MLR_ModemRxAction::Pass;
+    }
+
+    const uint8_t *pBody = &pPayload[MLR_FRAME_HEADER_LEN];
+    uint8_t bodyLen = *pLen - MLR_FRAME_HEADER_LEN;
+
+    switch (header.type)
+    {
+    case MLR_FrameType::ConfigSet:
+    {
+        if (bodyLen < MLR_CONFIG_SET_HEADER_LEN + MLR_CONFIG_TAG_LEN)
+        {
+            break;
+        }
+
+        uint32_t version = MLR_Frame_GetU32(&pBody[0]);
+        uint8_t attempt = pBody[4];
+        uint8_t count = pBody[11];
+        uint8_t signedLen = bodyLen - MLR_CONFIG_TAG_LEN;
+        if (count > MLR_CONFIG_MAX_ITEMS || MLR_CONFIG_SET_HEADER_LEN + 2 * count > signedLen)
+        {
+            break;
+        }
+
+        uint8_t nonce[MLR_AEAD_NONCE_LEN];
+        s_Nonce(header.src, version, attempt, MLR_CONFIG_NONCE_SET, nonce);
+        if (!MLR_Aead_Open(m_key, nonce, pBody, signedLen, nullptr, 0, &pBody[signedLen], MLR_CONFIG_TAG_LEN))
+        {
+            ++m_authFailCount;
+            break;
+        }
+
+        bool current = (m_state == MLR_ConfigState::Pending && version == m_pendingVersion);
+        if (version <= m_appliedVersion || version <= m_canceledVersion || (current && attempt <= m_attempt))
+        {
+            // already applied or canceled, or a repeated or older broadcast of the pending change; a repeated
+            // one would move the activation time and make this node switch after the others
+            break;
+        }
+
+        if (count == 0)
+        {
+            // cancellation; remembered also if the change was missed, so that a replay of it is not applied alone
+            m_canceledVersion = version;
+            if (current)
+            {
+                m_state = MLR_ConfigState::Idle;
+                m_ackDue = false;
+            }
+            break;
+        }
+
+        if (!current)
+        {
+            for (uint8_t i = 0; i < count; ++i)
+            {
+                m_items[i].param = static_cast<MLR_ConfigParam>(pBody[MLR_CONFIG_SET_HEADER_LEN + 2 * i]);
+                m_items[i].value = pBody[MLR_CONFIG_SET_HEADER_LEN + 2 * i + 1];
+                if (!s_IsValidItem(m_items[i]))
+                {
+                    return MLR_ModemRxAction::Drop;
+                }
+            }
+            m_count = count;
+            m_pendingVersion = version;
+            m_ackDue = false;
+            memset(m_acked, 0, sizeof(m_acked));
+            m_state = MLR_ConfigState::Pending;
+        }
+
+        // every broadcast carries the remaining delay, the latest one is the most accurate
+        m_attempt = attempt;
+        m_activation = millis() + MLR_Frame_GetU32(&pBody[5]);
+
+        uint8_t ackedOffset = MLR_CONFIG_SET_HEADER_LEN + 2 * count;
+        for (uint8_t i = 0; ackedOffset + i < signedLen && i < sizeof(m_acked); ++i)
+        {
+            m_acked[i] |= pBody[ackedOffset + i];
+        }
+
+        bool confirmed = ((m_src >> 3) < signedLen - ackedOffset) && s_TestBit(&pBody[ackedOffset], m_src);
+        s_SetBit(m_acked, m_src);
+        if (!confirmed && !m_ackDue)
+        {
+            // answer at a random time within the first 3/4 of the window, so that nodes
+            // do not collide and can overhear (and aggregate) each other
+            uint16_t window = MLR_Frame_GetU16(&pBody[9]);
+            m_ackScheduled = millis();
+            m_ackDelay = static_cast<uint32_t>(random((window * 3) / 4 + 1));
+            m_ackDue = true;
+        }
+        break;
+    }
+
+    case MLR_FrameType::ConfigAck:
+    {
+        if (m_state != MLR_ConfigState::Pending || bodyLen <= MLR_CONFIG_ACK_HEADER_LEN ||
+            MLR_Frame_GetU32(pBody) != m_pendingVersion)
+        {
+            break;
+        }
+        if (!s_VerifyAck(m_key, header.src, pBody, bodyLen))
+        {
+            // a forged ACK must not silence this node's own confirmation
+            ++m_authFailCount;
+            break;
+        }
+
+        // another node's ACK: aggregate it, and stay silent if it already reports everything we know
+        const uint8_t *pBitmap = &pBody[MLR_CONFIG_ACK_HEADER_LEN];
+        uint8_t bitmapLen = bodyLen - MLR_CONFIG_ACK_HEADER_LEN - MLR_CONFIG_TAG_LEN;
+        bool covered = true;
+        for (uint8_t i = 0; i < sizeof(m_acked); ++i)
+        {
+            uint8_t other = (i < bitmapLen) ? pBitmap[i] : 0;
+            covered = covered && ((m_acked[i] & ~other) == 0);
+            m_acked[i] |= other;
+        }
+        if (covered)
+        {
+            m_ackDue = false;
+        }
+        break;
+    }
+
+    default:
+        return MLR_ModemRxAction::Pass;
+    }
+
+    return MLR_ModemRxAction::Drop;
+}
+
+MLR_Modem_Error MLR_ConfigReceiver::m_SendAck()
+{
+    uint8_t frame[MLR_CONFIG_ACK_HEADER_LEN + 32 + MLR_CONFIG_TAG_LEN];
+    MLR_Frame_PutU32(&frame[0], m_pendingVersion);
+    frame[4] = m_attempt;
+    uint8_t len = MLR_CONFIG_ACK_HEADER_LEN + s_BitmapLen(m_acked);
+    memcpy(&frame[MLR_CONFIG_ACK_HEADER_LEN], m_acked, len - MLR_CONFIG_ACK_HEADER_LEN);
+
+    uint8_t nonce[MLR_AEAD_NONCE_LEN];
+    s_Nonce(m_src, m_pendingVersion, m_attempt, MLR_CONFIG_NONCE_ACK, nonce);
+    MLR_Aead_Seal(m_key, nonce, frame, len, nullptr, 0, &frame[len], MLR_CONFIG_TAG_LEN);
+    return m_pModem->TransmitFrame(MLR_FrameType::ConfigAck, frame, len + MLR_CONFIG_TAG_LEN);
+}
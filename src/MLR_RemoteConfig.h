@@ -0,0 +1,266 @@
+//
+// MLR_RemoteConfig.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Over-the-air change of radio settings (channel, spreading factor, ...) across a group of modems.
+// The gateway broadcasts a signed configuration change with an activation delay. Nodes verify it,
+// confirm it and apply it locally when the delay has elapsed, so that the whole group switches at
+// the same moment. Confirmations are aggregated: every ACK carries a bitmap of all nodes the sender
+// knows to have the change, including ACKs overheard from other nodes, and nodes whose confirmation
+// is already known stay silent. The gateway repeats the change (with the remaining delay) until all
+// expected nodes have confirmed; if the time runs out first, it cancels the change so that no node
+// switches alone and gets stranded.
+//
+// Changes and ACKs are authenticated with Poly1305 (see MLR_Aead.h) under a key shared by the group,
+// so a forged ACK cannot make the gateway skip the cancellation. The version number must increase
+// with every change; nodes ignore versions they have already applied.
+
+#pragma once
+#include "MLR_Modem.h"
+#include "MLR_Aead.h"
+
+#ifndef MLR_CONFIG_MAX_ITEMS
+/**
+ * @brief Maximum number of settings in one configuration change.
+ */
+#define MLR_CONFIG_MAX_ITEMS 8
+#endif
+
+/**
+ * @brief Default time the gateway waits for ACKs after each broadcast in milliseconds.
+ */
+static constexpr uint16_t MLR_CONFIG_ACK_WINDOW_MS = 3000;
+
+/**
+ * @brief Length of the truncated authentication tag of a configuration change in bytes.
+ */
+static constexpr uint8_t MLR_CONFIG_TAG_LEN = 8;
+
+/**
+ * \brief Setting changed by a remote configuration item.
+ */
+enum class MLR_ConfigParam : uint8_t
+{
+    Mode = 0x01,         //!< MLR_ModemMode, see MLR_Modem::SetMode()
+    SpreadFactor = 0x02, //!< MLR_ModemSpreadFactor, see MLR_Modem::SetSpreadFactor()
+    Channel = 0x03,      //!< Channel, see MLR_Modem::SetChannel()
+    GroupId = 0x04,      //!< Group ID, see MLR_Modem::SetGroupID()
+};
+
+/**
+ * \brief One setting of a configuration change.
+ */
+struct MLR_ConfigItem
+{
+    MLR_ConfigParam param; //!< The setting
+    uint8_t value;         //!< The new value
+};
+
+/**
+ * \brief State of a remote configuration change.
+ */
+enum class MLR_ConfigState : uint8_t
+{
+    Idle,         //!< No change in progress
+    Broadcasting, //!< Gateway: sending the change
+    Collecting,   //!< Gateway: waiting for ACKs after a broadcast
+    Pending,      //!< Waiting for the activation time
+    Canceling,    //!< Gateway: not all nodes confirmed in time, sending the cancellation
+    Done,         //!< The change has been applied
+    Failed,       //!< Gateway: the change was canceled, or applying a setting failed
+};
+
+/**
+ * \brief Callback signaling that a configuration change has been applied.
+ * \param version Version of the change.
+ * \param result MLR_Modem_Error::Ok, or the error of the first setting that could not be applied.
+ */
+typedef void (*MLR_ConfigAppliedCallback)(uint32_t version, MLR_Modem_Error result);
+
+/**
+ * \brief Gateway side of the remote configuration.
+ */
+class MLR_ConfigSender : public MLR_ModemRxHook
+{
+public:
+    /**
+     * \brief Registers the sender with the driver.
+     * \param modem The initialized modem driver.
+     * \param pKey The group key (MLR_AEAD_KEY_LEN bytes), copied.
+     * \return MLR_Modem_Error::Ok on success, or the error reading the Equipment ID.
+     */
+    MLR_Modem_Error begin(MLR_Modem &modem, const uint8_t *pKey);
+
+    /**
+     * \brief Unregisters the sender from the driver and aborts a running change without canceling it.
+     */
+    void end();
+
+    /**
+     * \brief Starts a configuration change.
+     * \param version Version of the change, must be higher than any version used before with this key.
+     * \param pItems The settings, applied in this order (change the mode before the spreading factor).
+     * \param count Number of settings (1-MLR_CONFIG_MAX_ITEMS).
+     * \param activationDelayMs Time until the group switches in milliseconds. Should cover several broadcasts
+     *                          and ACK windows.
+     * \param pNodes Equipment IDs of the nodes that have to confirm the change.
+     * \param nodeCount Number of nodes.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::Busy if a change is in progress,
+     *         MLR_Modem_Error::InvalidArg on invalid parameters.
+     * \note The gateway applies the change itself at the activation time. Persist the version, a repeated
+     *       version would be ignored by the nodes and weaken the signature.
+     */
+    MLR_Modem_Error Start(uint32_t version, const MLR_ConfigItem *pItems, uint8_t count, uint32_t activationDelayMs,
+                          const uint8_t *pNodes, uint8_t nodeCount);
+
+    /**
+     * \brief Sends the change, evaluates ACKs, cancels or applies the change.
+     * This function must be called regularly, e.g. after MLR_Modem::Work(). It blocks while a frame is transmitted.
+     */
+    void Work();
+
+    /**
+     * \brief Sets the time to wait for ACKs after each broadcast.
+     * \param ms ACK window in milliseconds.
+     */
+    void SetAckWindow(uint16_t ms) { m_ackWindowMs = ms; }
+
+    /**
+     * \brief Selects whether the settings are saved to the modem's non-volatile memory when applied.
+     * \param save true to save the settings (/W option).
+     */
+    void SetSaveValues(bool save) { m_saveValues = save; }
+
+    /**
+     * \brief Gets the state of the change.
+     */
+    MLR_ConfigState GetState() const { return m_state; }
+
+    /**
+     * \brief Gets the number of expected nodes that have not confirmed the change.
+     */
+    uint16_t GetMissingCount() const;
+
+    /**
+     * \brief Checks whether a node has confirmed the change.
+     * \param id Equipment ID of the node.
+     */
+    bool HasConfirmed(uint8_t id) const { return (m_acked[id >> 3] & (1 << (id & 7))) != 0; }
+
+    /**
+     * \brief Gets the number of broadcasts of the current change.
+     */
+    uint8_t GetBroadcastCount() const { return m_attempt; }
+
+    /**
+     * \brief Gets the number of received ACKs with an invalid signature.
+     */
+    uint32_t GetAuthFailCount() const { return m_authFailCount; }
+
+    //! Receive hook: merges ACKs of the current change
+    MLR_ModemRxAction OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi) override;
+
+private:
+    //! Internal: Signs and transmits the change (count 0 = cancellation)
+    MLR_Modem_Error m_SendSet(uint8_t count, uint32_t delayMs);
+
+    MLR_Modem *m_pModem = nullptr;                         //!< Driver the sender is registered with
+    uint8_t m_key[MLR_AEAD_KEY_LEN] = {};                  //!< Group key
+    uint8_t m_src = 0;                                     //!< Own Equipment ID
+    MLR_ConfigState m_state = MLR_ConfigState::Idle;       //!< State of the change
+    bool m_saveValues = false;                             //!< Save settings when applied
+    uint8_t m_attempt = 0;                                 //!< Number of broadcasts (part of the nonce)
+    uint8_t m_cancelsLeft = 0;                             //!< Cancellations still to send
+    uint8_t m_count = 0;                                   //!< Number of settings
+    uint16_t m_ackWindowMs = MLR_CONFIG_ACK_WINDOW_MS;     //!< ACK window after a broadcast
+    uint32_t m_version = 0;                                //!< Version of the change
+    uint32_t m_activation = 0;                             //!< millis() timestamp of the activation
+    uint32_t m_windowStart = 0;                            //!< millis() timestamp of the last broadcast
+    uint32_t m_authFailCount = 0;                          //!< ACKs with an invalid signature
+    MLR_ConfigItem m_items[MLR_CONFIG_MAX_ITEMS] = {};     //!< Settings of the change
+    uint8_t m_expected[32] = {};                           //!< Bitmap of nodes that have to confirm
+    uint8_t m_acked[32] = {};                              //!< Bitmap of nodes that confirmed
+};
+
+/**
+ * \brief Node side of the remote configuration.
+ */
+class MLR_ConfigReceiver : public MLR_ModemRxHook
+{
+public:
+    /**
+     * \brief Registers the receiver with the driver.
+     * \param modem The initialized modem driver.
+     * \param pKey The group key (MLR_AEAD_KEY_LEN bytes), copied.
+     * \param appliedVersion Version of the last change applied or canceled (persisted by the application, see
+     *                       GetCanceledVersion()), older and equal versions are ignored.
+     * \param pApplied Callback called after a change has been applied (may be nullptr).
+     * \return MLR_Modem_Error::Ok on success, or the error reading the Equipment ID.
+     */
+    MLR_Modem_Error begin(MLR_Modem &modem, const uint8_t *pKey, uint32_t appliedVersion = 0,
+                          MLR_ConfigAppliedCallback pApplied = nullptr);
+
+    /**
+     * \brief Unregisters the receiver from the driver.
+     */
+    void end();
+
+    /**
+     * \brief Sends a scheduled ACK and applies a pending change at its activation time.
+     * This function must be called regularly, e.g. after MLR_Modem::Work().
+     */
+    void Work();
+
+    /**
+     * \brief Selects whether the settings are saved to the modem's non-volatile memory when applied.
+     * \param save true to save the settings (/W option).
+     */
+    void SetSaveValues(bool save) { m_saveValues = save; }
+
+    /**
+     * \brief Gets the state of the receiver (Idle, Pending or Done).
+     */
+    MLR_ConfigState GetState() const { return m_state; }
+
+    /**
+     * \brief Gets the version of the last applied change.
+     */
+    uint32_t GetAppliedVersion() const { return m_appliedVersion; }
+
+    /**
+     * \brief Gets the version of the last canceled change, or 0. A replayed broadcast of a canceled change is
+     *        ignored; persist the higher of this and GetAppliedVersion() to keep ignoring it after a restart.
+     */
+    uint32_t GetCanceledVersion() const { return m_canceledVersion; }
+
+    /**
+     * \brief Gets the number of received changes and ACKs with an invalid signature.
+     */
+    uint32_t GetAuthFailCount() const { return m_authFailCount; }
+
+    //! Receive hook: verifies changes, schedules ACKs, aggregates overheard ACKs
+    MLR_ModemRxAction OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi) override;
+
+private:
+    //! Internal: Transmits the ACK bitmap
+    MLR_Modem_Error m_SendAck();
+
+    MLR_Modem *m_pModem = nullptr;                         //!< Driver the receiver is registered with
+    uint8_t m_key[MLR_AEAD_KEY_LEN] = {};                  //!< Group key
+    uint8_t m_src = 0;                                     //!< Own Equipment ID
+    MLR_ConfigAppliedCallback m_pApplied = nullptr;        //!< Callback after applying
+    MLR_ConfigState m_state = MLR_ConfigState::Idle;       //!< State of the receiver
+    bool m_saveValues = false;                             //!< Save settings when applied
+    bool m_ackDue = false;                                 //!< An ACK is scheduled
+    uint8_t m_attempt = 0;                                 //!< Latest broadcast of the pending change
+    uint8_t m_count = 0;                                   //!< Number of pending settings
+    uint32_t m_appliedVersion = 0;                         //!< Version of the last applied change
+    uint32_t m_pendingVersion = 0;                         //!< Version of the pending change
+    uint32_t m_canceledVersion = 0;                        //!< Version of the last canceled change
+    uint32_t m_activation = 0;                             //!< millis() timestamp of the activation
+    uint32_t m_ackScheduled = 0;                           //!< millis() timestamp of the broadcast that scheduled the ACK
+    uint32_t m_ackDelay = 0;                               //!< Delay of the ACK after the broadcast
+    uint32_t m_authFailCount = 0;                          //!< Changes and ACKs with an invalid signature
+    MLR_ConfigItem m_items[MLR_CONFIG_MAX_ITEMS] = {};     //!< Pending settings
+    uint8_t m_acked[32] = {};                              //!< Bitmap of nodes known to have the pending change
+};
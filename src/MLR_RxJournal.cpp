@@ -0,0 +1,372 @@
+//
+// MLR_RxJournal.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Crash-safe receive journal for gateways running the driver on a Linux host.
+//
+// File layout: Header, followed by the ring area. Positions are byte offsets that grow
+// monotonically (64 bit); a position maps to pos % capacity in the ring area.
+// A record is written in this order: header fields and payload, then its own position
+// as commit marker (release store), then the new write position in the file header.
+// Before the writer overwrites old records, it advances tailPos and invalidates their markers,
+// so a reader detects records that changed while it copied them (seqlock style).
+//
+
+#include "MLR_RxJournal.h"
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+static constexpr uint32_t MLR_JOURNAL_MAGIC = 0x4A524C4D; // "MLRJ"
+static constexpr uint16_t MLR_JOURNAL_VERSION = 1;
+
+// record flag: padding up to the end of the ring area
+static constexpr uint8_t MLR_JOURNAL_FLAG_PAD = 0x01;
+
+// marker of a record that is about to be overwritten
+static constexpr uint64_t MLR_JOURNAL_INVALID_POS = ~static_cast<uint64_t>(0);
+
+MLR_Modem_Error MLR_RxJournal::Open(const char *pPath, uint32_t capacity, bool readOnly)
+{
+    Close();
+
+    int fd = open(pPath, readOnly ? O_RDONLY : (O_RDWR | O_CREAT), 0644);
+    if (fd < 0)
+    {
+        return MLR_Modem_Error::Fail;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return MLR_Modem_Error::Fail;
+    }
+
+    bool create = (st.st_size == 0);
+    if (create)
+    {
+        capacity &= ~7UL;
+        if (readOnly || capacity < 2 * (sizeof(Record) + MLR_MAX_PAYLOAD_LEN))
+        {
+            close(fd);
+            return MLR_Modem_Error::InvalidArg;
+        }
+        if (ftruncate(fd, sizeof(Header) + capacity) != 0)
+        {
+            close(fd);
+            return MLR_Modem_Error::Fail;
+        }
+    }
+    else if (static_cast<size_t>(st.st_size) < sizeof(Header))
+    {
+        close(fd);
+        return MLR_Modem_Error::InvalidArg;
+    }
+    else
+    {
+        capacity = static_cast<uint32_t>(st.st_size - sizeof(Header));
+    }
+
+    size_t mapLen = sizeof(Header) + capacity;
+    void *pMap = mmap(nullptr, mapLen, readOnly ? PROT_READ : (PROT_READ | PROT_WRITE), MAP_SHARED, fd, 0);
+    if (pMap == MAP_FAILED)
+    {
+        close(fd);
+        return MLR_Modem_Error::Fail;
+    }
+
+    Header *pHeader = static_cast<Header *>(pMap);
+    if (create)
+    {
+        pHeader->version = MLR_JOURNAL_VERSION;
+        pHeader->capacity = capacity;
+        pHeader->writePos = 0;
+        pHeader->tailPos = 0;
+        // the new ring area reads as zero, which would be a valid marker for the first record
+        reinterpret_cast<Record *>(pHeader + 1)->pos = MLR_JOURNAL_INVALID_POS;
+        __atomic_store_n(&pHeader->magic, MLR_JOURNAL_MAGIC, __ATOMIC_RELEASE);
+    }
+    else if (pHeader->magic != MLR_JOURNAL_MAGIC || pHeader->version != MLR_JOURNAL_VERSION ||
+             pHeader->capacity != capacity || (capacity & 7) != 0)
+    {
+        munmap(pMap, mapLen);
+        close(fd);
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    m_fd = fd;
+    m_readOnly = readOnly;
+    m_pHeader = pHeader;
+    m_pRing = static_cast<uint8_t *>(pMap) + sizeof(Header);
+    m_capacity = capacity;
+
+    if (!readOnly)
+    {
+        m_Recover();
+    }
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_RxJournal::Close()
+{
+    end();
+
+    if (m_pHeader)
+    {
+        munmap(m_pHeader, sizeof(Header) + m_capacity);
+        close(m_fd);
+        m_pHeader = nullptr;
+        m_pRing = nullptr;
+        m_fd = -1;
+        m_capacity = 0;
+    }
+}
+
+MLR_Modem_Error MLR_RxJournal::begin(MLR_Modem &modem)
+{
+    if (!m_pHeader || m_readOnly)
+    {
+        return MLR_Modem_Error::Fail;
+    }
+
+    m_pModem = &modem;
+    modem.AddRxHook(this);
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_RxJournal::end()
+{
+    if (m_pModem)
+    {
+        m_pModem->RemoveRxHook(this);
+        m_pModem = nullptr;
+    }
+}
+
+MLR_Modem_Error MLR_RxJournal::Append(const uint8_t *pData, uint8_t len, int16_t rssi)
+{
+    if (!m_pHeader || m_readOnly || (len > 0 && !pData))
+    {
+        return MLR_Modem_Error::Fail;
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    uint64_t timeMs = static_cast<uint64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+
+    uint64_t pos = m_pHeader->writePos; // only this process writes it
+    uint32_t size = (sizeof(Record) + len + 7) & ~7UL;
+    uint32_t rest = m_capacity - static_cast<uint32_t>(pos % m_capacity);
+
+    if (rest < size)
+    {
+        // records never wrap around the end of the ring area
+        m_Reserve(pos, rest);
+        if (rest >= sizeof(Record))
+        {
+            Record *pPad = m_RecordAt(pos);
+            pPad->timeMs = 0;
+            pPad->rssi = 0;
+            pPad->len = 0;
+            pPad->flags = MLR_JOURNAL_FLAG_PAD;
+            pPad->reserved = 0;
+            __atomic_store_n(&pPad->pos, pos, __ATOMIC_RELEASE);
+        }
+        pos += rest;
+    }
+
+    m_Reserve(pos, size);
+
+    Record *pRecord = m_RecordAt(pos);
+    pRecord->timeMs = timeMs;
+    pRecord->rssi = rssi;
+    pRecord->len = len;
+    pRecord->flags = 0;
+    pRecord->reserved = 0;
+    memcpy(pRecord + 1, pData, len);
+    __atomic_store_n(&pRecord->pos, pos, __ATOMIC_RELEASE);
+
+    __atomic_store_n(&m_pHeader->writePos, pos + size, __ATOMIC_RELEASE);
+    return MLR_Modem_Error::Ok;
+}
+
+MLR_Modem_Error MLR_RxJournal::Read(uint64_t *pPos, MLR_JournalEntry *pEntry, uint64_t *pLost) const
+{
+    if (!m_pHeader)
+    {
+        return MLR_Modem_Error::Fail;
+    }
+
+    uint64_t pos = *pPos;
+    uint64_t lost = 0;
+    MLR_Modem_Error err = MLR_Modem_Error::Fail;
+
+    for (;;)
+    {
+        uint64_t tail = __atomic_load_n(&m_pHeader->tailPos, __ATOMIC_ACQUIRE);
+        if (pos < tail)
+        {
+            lost += tail - pos;
+            pos = tail;
+        }
+
+        if (pos >= __atomic_load_n(&m_pHeader->writePos, __ATOMIC_ACQUIRE))
+        {
+            break;
+        }
+
+        const Record *pRecord = m_RecordAt(pos);
+        uint32_t rest = m_capacity - static_cast<uint32_t>(pos % m_capacity);
+        if (rest < sizeof(Record))
+        {
+            pos += rest;
+            continue;
+        }
+
+        if (__atomic_load_n(&pRecord->pos, __ATOMIC_ACQUIRE) != pos)
+        {
+            if (pos >= __atomic_load_n(&m_pHeader->tailPos, __ATOMIC_ACQUIRE))
+            {
+                // not overwritten, so pos is not the start of a record
+                err = MLR_Modem_Error::InvalidArg;
+                break;
+            }
+            continue;
+        }
+
+        uint8_t flags = pRecord->flags;
+        uint8_t len = pRecord->len;
+        if (len > rest - sizeof(Record))
+        {
+            // torn by a writer overwriting it right now, or corrupt; never copy past the end of the ring
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&pRecord->pos, __ATOMIC_RELAXED) == pos &&
+                pos >= __atomic_load_n(&m_pHeader->tailPos, __ATOMIC_ACQUIRE))
+            {
+                err = MLR_Modem_Error::InvalidArg;
+                break;
+            }
+            continue;
+        }
+
+        pEntry->timeMs = pRecord->timeMs;
+        pEntry->rssi = pRecord->rssi;
+        pEntry->len = len;
+        memcpy(pEntry->data, pRecord + 1, len);
+
+        // the record must still be the same after copying it
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&pRecord->pos, __ATOMIC_RELAXED) != pos)
+        {
+            continue;
+        }
+
+        if (flags & MLR_JOURNAL_FLAG_PAD)
+        {
+            pos += rest;
+            continue;
+        }
+
+        pEntry->pos = pos;
+        pos += (sizeof(Record) + len + 7) & ~7UL;
+        err = MLR_Modem_Error::Ok;
+        break;
+    }
+
+    *pPos = pos;
+    if (pLost)
+    {
+        *pLost = lost;
+    }
+    return err;
+}
+
+MLR_Modem_Error MLR_RxJournal::Sync()
+{
+    if (!m_pHeader)
+    {
+        return MLR_Modem_Error::Fail;
+    }
+    return (msync(m_pHeader, sizeof(Header) + m_capacity, MS_ASYNC) == 0) ? MLR_Modem_Error::Ok : MLR_Modem_Error::Fail;
+}
+
+uint64_t MLR_RxJournal::GetWritePos() const
+{
+    return m_pHeader ? __atomic_load_n(&m_pHeader->writePos, __ATOMIC_ACQUIRE) : 0;
+}
+
+uint64_t MLR_RxJournal::GetTailPos() const
+{
+    return m_pHeader ? __atomic_load_n(&m_pHeader->tailPos, __ATOMIC_ACQUIRE) : 0;
+}
+
+MLR_ModemRxAction MLR_RxJournal::OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi)
+{
+    Append(pPayload, *pLen, rssi);
+    return MLR_ModemRxAction::Pass;
+}
+
+MLR_RxJournal::Record *MLR_RxJournal::m_RecordAt(uint64_t pos) const
+{
+    return reinterpret_cast<Record *>(m_pRing + pos % m_capacity);
+}
+
+uint32_t MLR_RxJournal::m_RecordSize(uint64_t pos, const Record *pRecord) const
+{
+    uint32_t rest = m_capacity - static_cast<uint32_t>(pos % m_capacity);
+    if (rest < sizeof(Record) || (pRecord->flags & MLR_JOURNAL_FLAG_PAD))
+    {
+        return rest;
+    }
+    return (sizeof(Record) + pRecord->len + 7) & ~7UL;
+}
+
+void MLR_RxJournal::m_Reserve(uint64_t writePos, uint32_t size)
+{
+    uint64_t tail = m_pHeader->tailPos;
+    if (tail + m_capacity >= writePos + size)
+    {
+        return;
+    }
+
+    while (tail + m_capacity < writePos + size)
+    {
+        Record *pRecord = m_RecordAt(tail);
+        uint32_t recordSize = m_RecordSize(tail, pRecord);
+        if (recordSize >= sizeof(Record))
+        {
+            __atomic_store_n(&pRecord->pos, MLR_JOURNAL_INVALID_POS, __ATOMIC_RELAXED);
+        }
+        tail += recordSize;
+    }
+
+    __atomic_store_n(&m_pHeader->tailPos, tail, __ATOMIC_RELEASE);
+    // the invalidated markers must be visible before the new data
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void MLR_RxJournal::m_Recover()
+{
+    uint64_t pos = m_pHeader->writePos;
+    for (;;)
+    {
+        uint32_t rest = m_capacity - static_cast<uint32_t>(pos % m_capacity);
+        uint64_t next = (rest < sizeof(Record)) ? pos + rest : pos;
+        const Record *pRecord = m_RecordAt(next);
+        if (pRecord->pos != next)
+        {
+            break;
+        }
+        pos = next + m_RecordSize(next, pRecord);
+    }
+    m_pHeader->writePos = pos;
+}
+
+#endif // __linux__
@@ -0,0 +1,170 @@
+//
+// MLR_RxJournal.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Crash-safe receive journal for gateways running the driver on a Linux host.
+// Received frames are appended to a memory-mapped ring file. A record becomes visible by storing
+// its position as commit marker after the payload, so a process crash never leaves a torn record
+// behind, and no fsync is needed per packet (the page cache survives the process).
+// Consumers keep their own read position and continue where they stopped after a restart.
+//
+// Only available when compiled for Linux (__linux__).
+
+#pragma once
+#include "MLR_Modem.h"
+
+#if defined(__linux__)
+
+/**
+ * @brief Default size of the ring area of a new journal file in bytes.
+ */
+static constexpr uint32_t MLR_JOURNAL_DEFAULT_CAPACITY = 1024UL * 1024UL;
+
+/**
+ * \brief A frame read from the journal.
+ */
+struct MLR_JournalEntry
+{
+    uint64_t pos;                       //!< Journal position of the record
+    uint64_t timeMs;                    //!< Reception time (Unix time in milliseconds)
+    int16_t rssi;                       //!< RSSI in dBm, or MLR_RSSI_UNKNOWN
+    uint8_t len;                        //!< Payload length
+    uint8_t data[MLR_MAX_PAYLOAD_LEN];  //!< Payload
+};
+
+/**
+ * \brief Append-only, memory-mapped ring journal of received frames.
+ * \note One process writes the journal (the one that called begin() or Append()), any number
+ *       of processes may open the same file to read it.
+ */
+class MLR_RxJournal : public MLR_ModemRxHook
+{
+public:
+    ~MLR_RxJournal() { Close(); }
+
+    /**
+     * \brief Opens or creates a journal file and maps it into memory.
+     * \param pPath Path of the journal file.
+     * \param capacity Size of the ring area for a new file in bytes (rounded down to a multiple of 8).
+     *                 An existing file keeps its capacity.
+     * \param readOnly If true, the file is mapped read-only and must exist.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::InvalidArg if the capacity is too small
+     *         or the file is not a journal, MLR_Modem_Error::Fail on I/O errors.
+     * \note Reopening a journal after a crash recovers records that were committed but not yet published in the file header.
+     */
+    MLR_Modem_Error Open(const char *pPath, uint32_t capacity = MLR_JOURNAL_DEFAULT_CAPACITY, bool readOnly = false);
+
+    /**
+     * \brief Unmaps and closes the journal file.
+     */
+    void Close();
+
+    /**
+     * \brief Registers the journal as receive hook, so that every received packet is appended.
+     * \param modem The initialized modem driver.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::Fail if the journal is not open for writing.
+     * \note Only packets reaching the journal in the hook chain are recorded; register filters before and
+     *       consuming layers (e.g. MLR_PubSub with handlers) after the journal.
+     */
+    MLR_Modem_Error begin(MLR_Modem &modem);
+
+    /**
+     * \brief Unregisters the journal from the driver. The file stays open.
+     */
+    void end();
+
+    /**
+     * \brief Appends a frame. Records that no longer fit overwrite the oldest ones.
+     * \param pData Pointer to the payload.
+     * \param len Payload length.
+     * \param rssi RSSI in dBm, or MLR_RSSI_UNKNOWN.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::Fail if the journal is not open for writing.
+     */
+    MLR_Modem_Error Append(const uint8_t *pData, uint8_t len, int16_t rssi = MLR_RSSI_UNKNOWN);
+
+    /**
+     * \brief Reads the record at a position and advances the position to the next record.
+     * \param pPos Read position of the consumer. Start with GetTailPos() or a position saved earlier.
+     *             If the record was already overwritten, the position moves to the oldest record.
+     * \param pEntry Pointer to store the record.
+     * \param pLost Pointer to store the number of bytes of records skipped because they were overwritten (may be nullptr).
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::Fail if there is no further record,
+     *         MLR_Modem_Error::InvalidArg if the position is not the start of a record or the record is corrupt.
+     */
+    MLR_Modem_Error Read(uint64_t *pPos, MLR_JournalEntry *pEntry, uint64_t *pLost = nullptr) const;
+
+    /**
+     * \brief Schedules writing the mapped pages to disk (msync with MS_ASYNC).
+     * Only needed to bound the loss on power failure; a process crash does not lose committed records.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::Fail otherwise.
+     */
+    MLR_Modem_Error Sync();
+
+    /**
+     * \brief Checks whether a journal file is open.
+     */
+    bool IsOpen() const { return m_pHeader != nullptr; }
+
+    /**
+     * \brief Gets the position of the next record to be written.
+     */
+    uint64_t GetWritePos() const;
+
+    /**
+     * \brief Gets the position of the oldest record still in the journal.
+     */
+    uint64_t GetTailPos() const;
+
+    /**
+     * \brief Gets the size of the ring area in bytes.
+     */
+    uint32_t GetCapacity() const { return m_capacity; }
+
+    //! Receive hook: appends the packet, always passes it on
+    MLR_ModemRxAction OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi) override;
+
+private:
+    //! File header at the start of the journal file
+    struct Header
+    {
+        uint32_t magic;     //!< Identifies a journal file
+        uint16_t version;   //!< Layout version
+        uint16_t reserved;  //!< Reserved, 0
+        uint32_t capacity;  //!< Size of the ring area in bytes
+        uint32_t reserved2; //!< Reserved, 0
+        uint64_t writePos;  //!< Position of the next record (published after each commit)
+        uint64_t tailPos;   //!< Position of the oldest record (advanced before it is overwritten)
+    };
+
+    //! Record header in the ring area, followed by the payload and padded to 8 bytes
+    struct Record
+    {
+        uint64_t pos;       //!< Commit marker: the record's own position once it is complete
+        uint64_t timeMs;    //!< Reception time (Unix time in milliseconds)
+        int16_t rssi;       //!< RSSI in dBm
+        uint8_t len;        //!< Payload length
+        uint8_t flags;      //!< Record flags (padding at the end of the ring area)
+        uint32_t reserved;  //!< Reserved, 0
+    };
+
+    //! Internal: Returns the record at a journal position
+    Record *m_RecordAt(uint64_t pos) const;
+
+    //! Internal: Returns the size of a record including padding, or the rest of the ring area for padding
+    uint32_t m_RecordSize(uint64_t pos, const Record *pRecord) const;
+
+    //! Internal: Advances the tail until [writePos, writePos + size) may be overwritten
+    void m_Reserve(uint64_t writePos, uint32_t size);
+
+    //! Internal: Skips records committed after the header was last updated (crash recovery)
+    void m_Recover();
+
+    MLR_Modem *m_pModem = nullptr;  //!< Driver the journal is registered with
+    int m_fd = -1;                  //!< File descriptor of the journal file
+    bool m_readOnly = false;        //!< File is mapped read-only
+    Header *m_pHeader = nullptr;    //!< Mapped file header
+    uint8_t *m_pRing = nullptr;     //!< Mapped ring area
+    uint32_t m_capacity = 0;        //!< Size of the ring area
+};
+
+#endif // __linux__
@@ -0,0 +1,210 @@
+//
+// MLR_SecureChannel.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Authenticated encryption of radio payloads with a fixed per-frame overhead.
+//
+// Nonce: src(1) counter(4, little-endian) zero(7)
+// Additional authenticated data: the secure frame header
+//
+
+#include "MLR_SecureChannel.h"
+#include <string.h>
+#include <array>
+
+// number of counters behind the highest one that are tracked per sender (reordered frames)
+static constexpr uint8_t MLR_SECURE_REPLAY_WINDOW = 32;
+
+// inner type of a raw (unframed) payload
+static constexpr uint8_t MLR_SECURE_INNER_RAW = 0x00;
+
+MLR_Modem_Error MLR_SecureChannel::begin(MLR_Modem &modem, const uint8_t *pKey, uint32_t txCounter)
+{
+    if (!pKey)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    MLR_Modem_Error rv = modem.GetEquipmentID(&m_src);
+    if (rv != MLR_Modem_Error::Ok)
+    {
+        return rv;
+    }
+
+    memcpy(m_key, pKey, sizeof(m_key));
+    m_txCounter = txCounter;
+    m_peers.Clear();
+    m_pModem = &modem;
+    modem.AddRxHook(this, true);
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_SecureChannel::end()
+{
+    if (m_pModem)
+    {
+        m_pModem->RemoveRxHook(this);
+        m_pModem = nullptr;
+    }
+    memset(m_key, 0, sizeof(m_key));
+}
+
+MLR_Modem_Error MLR_SecureChannel::TransmitData(const uint8_t *pMsg, uint8_t len)
+{
+    if (!pMsg || len == 0)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+    return m_Transmit(MLR_SECURE_INNER_RAW, pMsg, len);
+}
+
+MLR_Modem_Error MLR_SecureChannel::TransmitFrame(MLR_FrameType type, const uint8_t *pMsg, uint8_t len)
+{
+    if (len > 0 && !pMsg)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+    return m_Transmit(static_cast<uint8_t>(type), pMsg, len);
+}
+
+MLR_Modem_Error MLR_SecureChannel::m_Transmit(uint8_t innerType, const uint8_t *pMsg, uint8_t len)
+{
+    if (!m_pModem)
+    {
+        return MLR_Modem_Error::Fail;
+    }
+    if (len > MLR_SECURE_MAX_PAYLOAD_LEN)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+    if (m_txCounter == UINT32_MAX)
+    {
+        // the key has to be changed before the nonce repeats
+        return MLR_Modem_Error::Fail;
+    }
+
+    // a regular frame header with the low byte of the counter as sequence number, then the upper counter bytes
+    std::array<uint8_t, MLR_MAX_PAYLOAD_LEN> frame;
+    MLR_FrameHeader header{MLR_FrameType::Secure, m_src, static_cast<uint8_t>(m_txCounter)};
+    MLR_Frame_WriteHeader(frame.data(), header);
+    frame[MLR_FRAME_HEADER_LEN] = static_cast<uint8_t>(m_txCounter >> 8);
+    frame[MLR_FRAME_HEADER_LEN + 1] = static_cast<uint8_t>(m_txCounter >> 16);
+    frame[MLR_FRAME_HEADER_LEN + 2] = static_cast<uint8_t>(m_txCounter >> 24);
+    frame[MLR_SECURE_HEADER_LEN] = innerType;
+    if (len > 0)
+    {
+        memcpy(&frame[MLR_SECURE_HEADER_LEN + 1], pMsg, len);
+    }
+
+    uint8_t nonce[MLR_AEAD_NONCE_LEN];
+    m_Nonce(m_src, m_txCounter, nonce);
+    uint8_t cipherLen = 1 + len;
+    MLR_Aead_Seal(m_key, nonce, frame.data(), MLR_SECURE_HEADER_LEN, &frame[MLR_SECURE_HEADER_LEN], cipherLen,
+                  &frame[MLR_SECURE_HEADER_LEN + cipherLen], MLR_SECURE_TAG_LEN);
+
+    // the counter advances even if LBT fails, a nonce is never used twice
+    ++m_txCounter;
+    return m_pModem->TransmitData(frame.data(), MLR_SECURE_HEADER_LEN + cipherLen + MLR_SECURE_TAG_LEN);
+}
+
+MLR_ModemRxAction MLR_SecureChannel::OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi)
+{
+    (void)rssi;
+
+    uint8_t len = *pLen;
+    MLR_FrameHeader header;
+    if (!MLR_Frame_ParseHeader(pPayload, len, &header) || header.type != MLR_FrameType::Secure)
+    {
+        return m_requireEncryption ? MLR_ModemRxAction::Drop : MLR_ModemRxAction::Pass;
+    }
+
+    if (len < MLR_SECURE_HEADER_LEN + 1 + MLR_SECURE_TAG_LEN)
+    {
+        ++m_authFailCount;
+        return MLR_ModemRxAction::Drop;
+    }
+
+    uint8_t src = header.src;
+    uint32_t counter = header.seq | (static_cast<uint32_t>(pPayload[MLR_FRAME_HEADER_LEN]) << 8) |
+                       (static_cast<uint32_t>(pPayload[MLR_FRAME_HEADER_LEN + 1]) << 16) |
+                       (static_cast<uint32_t>(pPayload[MLR_FRAME_HEADER_LEN + 2]) << 24);
+    Peer *pPeer = m_peers.Find(src);
+    if (pPeer && m_IsReplay(pPeer, counter))
+    {
+        ++m_replayCount;
+        return MLR_ModemRxAction::Drop;
+    }
+
+    uint8_t nonce[MLR_AEAD_NONCE_LEN];
+    m_Nonce(src, counter, nonce);
+    uint8_t cipherLen = len - MLR_SECURE_HEADER_LEN - MLR_SECURE_TAG_LEN;
+    if (!MLR_Aead_Open(m_key, nonce, pPayload, MLR_SECURE_HEADER_LEN, &pPayload[MLR_SECURE_HEADER_LEN], cipherLen,
+                       &pPayload[len - MLR_SECURE_TAG_LEN], MLR_SECURE_TAG_LEN))
+    {
+        ++m_authFailCount;
+        return MLR_ModemRxAction::Drop;
+    }
+
+    // only verified frames may claim a replay window, so forged frames cannot evict senders
+    if (!pPeer)
+    {
+        bool created = false;
+        pPeer = m_peers.Insert(src, &created);
+        pPeer->counter = 0;
+        pPeer->seen = 0;
+    }
+    m_Accept(pPeer, counter);
+
+    uint8_t innerType = pPayload[MLR_SECURE_HEADER_LEN];
+    uint8_t bodyLen = cipherLen - 1;
+    if (innerType == MLR_SECURE_INNER_RAW)
+    {
+        memmove(pPayload, &pPayload[MLR_SECURE_HEADER_LEN + 1], bodyLen);
+        *pLen = bodyLen;
+    }
+    else
+    {
+        MLR_FrameHeader inner{static_cast<MLR_FrameType>(innerType), src, static_cast<uint8_t>(counter)};
+        MLR_Frame_WriteHeader(pPayload, inner);
+        memmove(&pPayload[MLR_FRAME_HEADER_LEN], &pPayload[MLR_SECURE_HEADER_LEN + 1], bodyLen);
+        *pLen = MLR_FRAME_HEADER_LEN + bodyLen;
+    }
+    return MLR_ModemRxAction::Pass;
+}
+
+void MLR_SecureChannel::m_Nonce(uint8_t src, uint32_t counter, uint8_t *pNonce)
+{
+    memset(pNonce, 0, MLR_AEAD_NONCE_LEN);
+    pNonce[0] = src;
+    MLR_Frame_PutU32(&pNonce[1], counter);
+}
+
+bool MLR_SecureChannel::m_IsReplay(const Peer *pPeer, uint32_t counter)
+{
+    if (counter > pPeer->counter)
+    {
+        return false;
+    }
+
+    uint32_t age = pPeer->counter - counter;
+    if (age >= MLR_SECURE_REPLAY_WINDOW)
+    {
+        return true;
+    }
+    return (pPeer->seen & (1UL << age)) != 0;
+}
+
+void MLR_SecureChannel::m_Accept(Peer *pPeer, uint32_t counter)
+{
+    pPeer->lastSeen = millis();
+    if (pPeer->seen == 0 || counter > pPeer->counter)
+    {
+        uint32_t shift = (pPeer->seen == 0) ? MLR_SECURE_REPLAY_WINDOW : counter - pPeer->counter;
+        pPeer->seen = (shift >= MLR_SECURE_REPLAY_WINDOW) ? 1 : (pPeer->seen << shift) | 1;
+        pPeer->counter = counter;
+    }
+    else
+    {
+        pPeer->seen |= 1UL << (pPeer->counter - counter);
+    }
+}
@@ -0,0 +1,153 @@
+//
+// MLR_SecureChannel.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Authenticated encryption of radio payloads with a fixed per-frame overhead.
+// Frames are encrypted with ChaCha20-Poly1305 (see MLR_Aead.h) under a key shared by the
+// group. The nonce is derived from the sender's Equipment ID and a 32-bit frame counter,
+// so only the counter (whose low byte doubles as the frame sequence number) and a
+// truncated tag are sent. Received frames are verified and decrypted in place in the
+// driver's receive buffer, and the following hooks and the application see the plain frame.
+// Every node of a group needs a unique Equipment ID and must never reuse a frame counter,
+// also across restarts (see MLR_SecureChannel::begin()).
+//
+// Frame on air (MLR_SECURE_OVERHEAD bytes more than the plain frame):
+//   type=Secure(1) src(1) counter&0xFF(1) check(1) counter>>8(3) encrypted[innerType(1) body(...)] tag(MLR_SECURE_TAG_LEN)
+// Delivered after verification:
+//   innerType(1) src(1) counter&0xFF(1) check(1) body(...)   for framed payloads (MLR_FrameType)
+//   body(...)                                               for raw payloads (innerType 0)
+
+#pragma once
+#include "MLR_Modem.h"
+#include "MLR_Aead.h"
+#include "MLR_PeerTable.h"
+
+#ifndef MLR_SECURE_PEERS
+/**
+ * @brief Number of senders with replay protection state. The least recently heard sender is evicted when full.
+ */
+#define MLR_SECURE_PEERS 8
+#endif
+
+/**
+ * @brief Length of the truncated authentication tag in bytes.
+ */
+static constexpr uint8_t MLR_SECURE_TAG_LEN = 8;
+
+/**
+ * @brief Length of the secure frame header (frame header with the counter's low byte, upper 3 counter bytes).
+ */
+static constexpr uint8_t MLR_SECURE_HEADER_LEN = MLR_FRAME_HEADER_LEN + 3;
+
+/**
+ * @brief Bytes added to a frame sent with MLR_Modem::TransmitFrame() (counter bytes not in the frame header, inner type and tag).
+ */
+static constexpr uint8_t MLR_SECURE_OVERHEAD = MLR_SECURE_HEADER_LEN - MLR_FRAME_HEADER_LEN + 1 + MLR_SECURE_TAG_LEN;
+
+/**
+ * @brief Maximum body length of a secure frame.
+ */
+static constexpr uint8_t MLR_SECURE_MAX_PAYLOAD_LEN = MLR_MAX_PAYLOAD_LEN - MLR_SECURE_HEADER_LEN - 1 - MLR_SECURE_TAG_LEN;
+
+/**
+ * \brief Authenticated encryption of frames with replay protection.
+ */
+class MLR_SecureChannel : public MLR_ModemRxHook
+{
+public:
+    /**
+     * \brief Registers the channel with the driver.
+     * \param modem The initialized modem driver.
+     * \param pKey The group key (MLR_AEAD_KEY_LEN bytes), copied.
+     * \param txCounter The first frame counter to send, restored from non-volatile memory. It must be higher than
+     *                  every counter sent before under this key; 0 is only valid for a new key.
+     * \return MLR_Modem_Error::Ok on success, or the error reading the Equipment ID.
+     * \note The nonce is built from the Equipment ID and the counter, so a counter must never repeat for the same key
+     *       and Equipment ID. Instead of writing every counter, reserve a block: store GetTxCounter() + 256 whenever
+     *       GetTxCounter() reaches the stored value, and pass the stored value after a restart.
+     * \note Replay windows are kept in RAM for MLR_SECURE_PEERS senders. When a sender is evicted (more active
+     *       senders than MLR_SECURE_PEERS) or the receiver restarts, the counters seen are forgotten and a frame
+     *       recorded earlier is accepted once more. Set MLR_SECURE_PEERS to the number of senders in the group, and
+     *       let the application reject stale commands where a replay after a restart matters.
+     * \note The channel is inserted in front of the registered hooks, so that forged frames are dropped before
+     *       other modules see them; call begin() after the other modules.
+     */
+    MLR_Modem_Error begin(MLR_Modem &modem, const uint8_t *pKey, uint32_t txCounter);
+
+    /**
+     * \brief Unregisters the channel from the driver and clears the key.
+     */
+    void end();
+
+    /**
+     * \brief Drops received payloads that are not secure frames.
+     * \param require true to accept secure frames only.
+     */
+    void SetRequireEncryption(bool require) { m_requireEncryption = require; }
+
+    /**
+     * \brief Encrypts and sends a raw payload.
+     * \param pMsg The payload.
+     * \param len Length of the payload (1-MLR_SECURE_MAX_PAYLOAD_LEN bytes).
+     * \return Same as MLR_Modem::TransmitData(); MLR_Modem_Error::Fail if the frame counter is exhausted.
+     */
+    MLR_Modem_Error TransmitData(const uint8_t *pMsg, uint8_t len);
+
+    /**
+     * \brief Encrypts and sends a frame, the secure counterpart of MLR_Modem::TransmitFrame().
+     * \param type The frame type.
+     * \param pMsg The frame body, may be nullptr if len is 0.
+     * \param len Length of the frame body (0-MLR_SECURE_MAX_PAYLOAD_LEN bytes).
+     * \return Same as TransmitData().
+     */
+    MLR_Modem_Error TransmitFrame(MLR_FrameType type, const uint8_t *pMsg, uint8_t len);
+
+    /**
+     * \brief Gets the next frame counter to send.
+     */
+    uint32_t GetTxCounter() const { return m_txCounter; }
+
+    /**
+     * \brief Gets the number of received frames with an invalid tag.
+     */
+    uint32_t GetAuthFailCount() const { return m_authFailCount; }
+
+    /**
+     * \brief Gets the number of received frames rejected as replayed.
+     */
+    uint32_t GetReplayCount() const { return m_replayCount; }
+
+    //! Receive hook: verifies and decrypts secure frames in place
+    MLR_ModemRxAction OnFrameReceived(uint8_t *pPayload, uint8_t *pLen, int16_t rssi) override;
+
+private:
+    //! Replay window of one sender
+    struct Peer
+    {
+        uint8_t id;        //!< Equipment ID of the sender
+        uint32_t counter;  //!< Highest frame counter received
+        uint32_t seen;     //!< Bit n: counter - n was received
+        uint32_t lastSeen; //!< millis() timestamp of the last frame
+    };
+
+    //! Internal: Builds, seals and sends a secure frame
+    MLR_Modem_Error m_Transmit(uint8_t innerType, const uint8_t *pMsg, uint8_t len);
+
+    //! Internal: Builds the nonce from the source ID and the frame counter
+    static void m_Nonce(uint8_t src, uint32_t counter, uint8_t *pNonce);
+
+    //! Internal: Returns true if the counter has already been received from the sender
+    static bool m_IsReplay(const Peer *pPeer, uint32_t counter);
+
+    //! Internal: Records a verified counter
+    static void m_Accept(Peer *pPeer, uint32_t counter);
+
+    MLR_Modem *m_pModem = nullptr;         //!< Driver the channel is registered with
+    uint8_t m_key[MLR_AEAD_KEY_LEN] = {};  //!< Group key
+    uint8_t m_src = 0;                     //!< Own Equipment ID
+    uint32_t m_txCounter = 0;              //!< Next frame counter to send
+    bool m_requireEncryption = false;      //!< Drop payloads that are not secure frames
+    uint32_t m_authFailCount = 0;          //!< Frames with an invalid tag
+    uint32_t m_replayCount = 0;            //!< Replayed frames
+    MLR_PeerTable<Peer, MLR_SECURE_PEERS> m_peers; //!< Replay windows
+};
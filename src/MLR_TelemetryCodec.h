@@ -0,0 +1,291 @@
+//
+// MLR_TelemetryCodec.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Compact, schema-based encoding of telemetry records for radio payloads.
+// A record is a fixed list of integer fields described by a schema shared by sender and receiver.
+// Integers are written as varints (signed ones zigzag-encoded), booleans are packed into bits,
+// and fields marked as delta are written as the difference to the previous record.
+// Everything is header-only and works on caller-provided buffers; the decoder reads the payload
+// in place, e.g. directly from the receive callback or a packet pool buffer.
+//
+// Record layout: flags(1) bools(ceil(n/8)) varints(...)
+//   flags bit 0: record is delta-encoded against the previous record (sequence number - 1)
+//   flags bits 1-7: sequence number of the record, so that a receiver that missed the base
+//                   of a delta record rejects it instead of decoding wrong values
+
+#pragma once
+#include <stdint.h>
+
+/**
+ * \brief Type of a telemetry field.
+ */
+enum class MLR_TelemetryType : uint8_t
+{
+    Unsigned, //!< Non-negative integer, varint
+    Signed,   //!< Signed integer, zigzag varint
+    Bool,     //!< Boolean, one bit
+};
+
+/**
+ * \brief Description of one field of a telemetry record.
+ */
+struct MLR_TelemetryField
+{
+    MLR_TelemetryType type; //!< Type of the field
+    bool delta;             //!< Encode as difference to the previous record (slowly changing values)
+};
+
+/**
+ * @brief Flag in the first byte of a record: the record is delta-encoded.
+ */
+static constexpr uint8_t MLR_TELEMETRY_FLAG_DELTA = 0x01;
+
+/**
+ * @brief Position of the 7-bit sequence number in the first byte of a record.
+ */
+static constexpr uint8_t MLR_TELEMETRY_SEQ_SHIFT = 1;
+
+/**
+ * @brief Mask of the sequence number of a record (7 bits).
+ */
+static constexpr uint8_t MLR_TELEMETRY_SEQ_MASK = 0x7F;
+
+/**
+ * \brief Gets the sequence number of an encoded record.
+ * \param pSrc The encoded record (at least one byte).
+ * \return The sequence number (0-127).
+ */
+inline uint8_t MLR_Telemetry_GetSequence(const uint8_t *pSrc)
+{
+    return pSrc[0] >> MLR_TELEMETRY_SEQ_SHIFT;
+}
+
+//! Internal: zigzag mapping of signed to unsigned integers (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...)
+inline uint32_t MLR_Telemetry_ZigZag(int32_t value)
+{
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+//! Internal: inverse of MLR_Telemetry_ZigZag()
+inline int32_t MLR_Telemetry_UnZigZag(uint32_t value)
+{
+    return static_cast<int32_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+/**
+ * \brief Writes an unsigned varint (7 bits per byte, least significant group first).
+ * \param pDst Buffer.
+ * \param capacity Size of the buffer.
+ * \param pPos Write position, advanced by the number of bytes written.
+ * \param value The value.
+ * \return false if the buffer is too small.
+ */
+inline bool MLR_Telemetry_PutVarint(uint8_t *pDst, uint8_t capacity, uint8_t *pPos, uint32_t value)
+{
+    do
+    {
+        if (*pPos >= capacity)
+        {
+            return false;
+        }
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        pDst[(*pPos)++] = byte | (value ? 0x80 : 0);
+    } while (value);
+    return true;
+}
+
+/**
+ * \brief Reads an unsigned varint.
+ * \param pSrc Buffer.
+ * \param len Number of valid bytes in the buffer.
+ * \param pPos Read position, advanced by the number of bytes read.
+ * \param pValue Pointer to store the value.
+ * \return false if the varint is truncated or does not fit in 32 bits.
+ */
+inline bool MLR_Telemetry_GetVarint(const uint8_t *pSrc, uint8_t len, uint8_t *pPos, uint32_t *pValue)
+{
+    uint32_t value = 0;
+    for (uint8_t shift = 0; shift < 35; shift += 7)
+    {
+        if (*pPos >= len)
+        {
+            return false;
+        }
+        uint8_t byte = pSrc[(*pPos)++];
+        if (shift == 28 && byte > 0x0F)
+        {
+            return false; // the 5th byte holds the top 4 bits and must be the last one
+        }
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+            *pValue = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * \brief Encodes a telemetry record.
+ * \param pSchema The field descriptions.
+ * \param fieldCount Number of fields.
+ * \param pValues The field values (Bool fields: 0 or 1).
+ * \param pPrev Values of the previous record for delta encoding, or nullptr to write a self-contained (key) record.
+ * \param seq Sequence number of the record (only the lower 7 bits are sent). Increment it for every record;
+ *            a delta record must be encoded against the record with sequence number seq - 1.
+ * \param pDst Buffer for the encoded record.
+ * \param capacity Size of the buffer.
+ * \return Length of the encoded record, or 0 if the buffer is too small.
+ * \note Receivers can only decode a delta record if they received the previous one; send key records regularly.
+ */
+inline uint8_t MLR_Telemetry_Encode(const MLR_TelemetryField *pSchema, uint8_t fieldCount, const int32_t *pValues,
+                                    const int32_t *pPrev, uint8_t seq, uint8_t *pDst, uint8_t capacity)
+{
+    uint8_t boolCount = 0;
+    for (uint8_t i = 0; i < fieldCount; ++i)
+    {
+        boolCount += (pSchema[i].type == MLR_TelemetryType::Bool);
+    }
+
+    uint8_t pos = 1 + (boolCount + 7) / 8;
+    if (pos > capacity)
+    {
+        return 0;
+    }
+
+    pDst[0] = static_cast<uint8_t>(seq << MLR_TELEMETRY_SEQ_SHIFT) | (pPrev ? MLR_TELEMETRY_FLAG_DELTA : 0);
+    for (uint8_t i = 1; i < pos; ++i)
+    {
+        pDst[i] = 0;
+    }
+
+    uint8_t bit = 0;
+    for (uint8_t i = 0; i < fieldCount; ++i)
+    {
+        const MLR_TelemetryField &field = pSchema[i];
+        if (field.type == MLR_TelemetryType::Bool)
+        {
+            if (pValues[i])
+            {
+                pDst[1 + bit / 8] |= 1 << (bit % 8);
+            }
+            ++bit;
+            continue;
+        }
+
+        uint32_t raw;
+        if (field.delta && pPrev)
+        {
+            // differences can be negative even for unsigned fields
+            raw = MLR_Telemetry_ZigZag(static_cast<int32_t>(static_cast<uint32_t>(pValues[i]) - static_cast<uint32_t>(pPrev[i])));
+        }
+        else if (field.type == MLR_TelemetryType::Signed)
+        {
+            raw = MLR_Telemetry_ZigZag(pValues[i]);
+        }
+        else
+        {
+            raw = static_cast<uint32_t>(pValues[i]);
+        }
+
+        if (!MLR_Telemetry_PutVarint(pDst, capacity, &pos, raw))
+        {
+            return 0;
+        }
+    }
+    return pos;
+}
+
+//! Internal: Parses the fields of a record; stores the values only if pValues is not nullptr
+inline bool MLR_Telemetry_ReadFields(const MLR_TelemetryField *pSchema, uint8_t fieldCount, const uint8_t *pSrc, uint8_t len,
+                                     int32_t *pValues, const int32_t *pPrev)
+{
+    bool delta = (pSrc[0] & MLR_TELEMETRY_FLAG_DELTA) != 0;
+
+    uint8_t boolCount = 0;
+    for (uint8_t i = 0; i < fieldCount; ++i)
+    {
+        boolCount += (pSchema[i].type == MLR_TelemetryType::Bool);
+    }
+
+    uint8_t pos = 1 + (boolCount + 7) / 8;
+    if (pos > len)
+    {
+        return false;
+    }
+
+    uint8_t bit = 0;
+    for (uint8_t i = 0; i < fieldCount; ++i)
+    {
+        const MLR_TelemetryField &field = pSchema[i];
+        if (field.type == MLR_TelemetryType::Bool)
+        {
+            if (pValues)
+            {
+                pValues[i] = (pSrc[1 + bit / 8] >> (bit % 8)) & 1;
+            }
+            ++bit;
+            continue;
+        }
+
+        uint32_t raw;
+        if (!MLR_Telemetry_GetVarint(pSrc, len, &pos, &raw))
+        {
+            return false;
+        }
+        if (!pValues)
+        {
+            continue;
+        }
+
+        if (field.delta && delta)
+        {
+            pValues[i] = static_cast<int32_t>(static_cast<uint32_t>(pPrev[i]) + static_cast<uint32_t>(MLR_Telemetry_UnZigZag(raw)));
+        }
+        else if (field.type == MLR_TelemetryType::Signed)
+        {
+            pValues[i] = MLR_Telemetry_UnZigZag(raw);
+        }
+        else
+        {
+            pValues[i] = static_cast<int32_t>(raw);
+        }
+    }
+    return pos == len;
+}
+
+/**
+ * \brief Decodes a telemetry record.
+ * \param pSchema The field descriptions (same as for encoding).
+ * \param fieldCount Number of fields.
+ * \param pSrc The encoded record.
+ * \param len Length of the encoded record.
+ * \param pValues Buffer for the field values, left unchanged if decoding fails.
+ * \param pPrev Values of the previous record, or nullptr if unknown. May be the same buffer as pValues.
+ * \param prevSeq Sequence number of the record in pPrev (see MLR_Telemetry_GetSequence()).
+ * \return true on success, false if the record is malformed, or delta-encoded and pPrev is nullptr or not its base.
+ */
+inline bool MLR_Telemetry_Decode(const MLR_TelemetryField *pSchema, uint8_t fieldCount, const uint8_t *pSrc, uint8_t len,
+                                 int32_t *pValues, const int32_t *pPrev, uint8_t prevSeq)
+{
+    if (len < 1)
+    {
+        return false;
+    }
+
+    if (pSrc[0] & MLR_TELEMETRY_FLAG_DELTA)
+    {
+        uint8_t base = (MLR_Telemetry_GetSequence(pSrc) - 1) & MLR_TELEMETRY_SEQ_MASK;
+        if (!pPrev || base != (prevSeq & MLR_TELEMETRY_SEQ_MASK))
+        {
+            return false;
+        }
+    }
+
+    // validate the whole record first, so that a malformed one does not overwrite pValues (or pPrev) partially
+    return MLR_Telemetry_ReadFields(pSchema, fieldCount, pSrc, len, nullptr, pPrev) &&
+           MLR_Telemetry_ReadFields(pSchema, fieldCount, pSrc, len, pValues, pPrev);
+}
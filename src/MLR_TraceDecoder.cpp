@@ -0,0 +1,365 @@
+//
+// MLR_TraceDecoder.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Offline analyzer for captured serial traffic between application and modem.
+//
+
+#include "MLR_TraceDecoder.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+// longest formatted line: the "commands" summary line or the JSON event prefix with 10-digit uint32 fields
+static constexpr uint8_t MLR_TRACE_LINE_LEN = 112;
+
+static const char *const s_eventNames[] = {"command", "transmit", "response", "receive",
+                                           "tx_done", "lbt_fail", "error",    "garbage"};
+
+static const char s_hexDigits[] = "0123456789ABCDEF";
+
+//! Writes formatted text, truncated to MLR_TRACE_LINE_LEN - 1 characters if it does not fit
+static void s_Printf(Print &out, const char *pFormat, ...) __attribute__((format(printf, 2, 3)));
+static void s_Printf(Print &out, const char *pFormat, ...)
+{
+    char line[MLR_TRACE_LINE_LEN];
+    va_list args;
+    va_start(args, pFormat);
+    int len = vsnprintf(line, sizeof(line), pFormat, args);
+    va_end(args);
+    if (len < 0)
+    {
+        return;
+    }
+    out.write(reinterpret_cast<const uint8_t *>(line), (static_cast<size_t>(len) < sizeof(line)) ? len : sizeof(line) - 1);
+}
+
+static bool s_ParseHexByte(const uint8_t *pData, uint8_t *pValue)
+{
+    uint8_t value = 0;
+    for (uint8_t i = 0; i < 2; ++i)
+    {
+        uint8_t c = pData[i];
+        value <<= 4;
+        if (c >= '0' && c <= '9')
+        {
+            value |= c - '0';
+        }
+        else if (c >= 'A' && c <= 'F')
+        {
+            value |= c - 'A' + 10;
+        }
+        else if (c >= 'a' && c <= 'f')
+        {
+            value |= c - 'a' + 10;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    *pValue = value;
+    return true;
+}
+
+void MLR_TraceDecoder::begin(Print *pOut, MLR_TraceFormat format)
+{
+    m_pOut = pOut;
+    m_format = format;
+    m_parser.m_Attach(m_source, nullptr);
+    m_source.m_len = 0;
+    m_started = false;
+    m_cmdPending = false;
+    m_txPending = false;
+    m_decodedBytes = 0;
+    m_txLen = 0;
+    m_txDataLeft = 0;
+    memset(&m_summary, 0, sizeof(m_summary));
+
+    if (m_pOut && m_format == MLR_TraceFormat::Csv)
+    {
+        m_pOut->write("time_us,dir,event,len,latency_us,data\r\n");
+    }
+}
+
+void MLR_TraceDecoder::Feed(MLR_TraceDirection direction, const uint8_t *pData, size_t len, uint32_t timestampUs)
+{
+    if (!pData || len == 0)
+    {
+        return;
+    }
+
+    if (!m_started)
+    {
+        m_summary.firstUs = timestampUs;
+        m_started = true;
+    }
+    m_summary.lastUs = timestampUs;
+
+    if (direction == MLR_TraceDirection::Tx)
+    {
+        m_summary.txBytes += len;
+        for (size_t i = 0; i < len; ++i)
+        {
+            m_FeedTx(pData[i], timestampUs);
+        }
+        return;
+    }
+
+    m_summary.rxBytes += len;
+    m_source.m_pData = pData;
+    m_source.m_len = len;
+    while (m_source.m_len > 0)
+    {
+        switch (m_parser.m_Parse())
+        {
+        case MLR_ModemCmdState::FinishedCmdResponse:
+            m_decodedBytes += m_parser.m_rxIdx + 2;
+            m_OnResponse(timestampUs);
+            break;
+
+        case MLR_ModemCmdState::FinishedDrResponse:
+        {
+            uint8_t frameLen = m_parser.m_drMessageLen;
+            m_decodedBytes += frameLen + 8;
+            if (m_summary.frames == 0 || frameLen < m_summary.minFrameLen)
+            {
+                m_summary.minFrameLen = frameLen;
+            }
+            if (frameLen > m_summary.maxFrameLen)
+            {
+                m_summary.maxFrameLen = frameLen;
+            }
+            ++m_summary.frames;
+            m_summary.frameBytes += frameLen;
+            m_Emit(timestampUs, MLR_TraceDirection::Rx, MLR_TraceEventType::Receive, m_parser.m_pDrBuffer, frameLen, 0);
+            break;
+        }
+
+        case MLR_ModemCmdState::Garbage:
+        case MLR_ModemCmdState::Overflow:
+            ++m_summary.garbage;
+            m_Emit(timestampUs, MLR_TraceDirection::Rx, MLR_TraceEventType::Garbage, nullptr, 0, 0);
+            break;
+
+        default:
+            break;
+        }
+    }
+}
+
+const MLR_TraceSummary &MLR_TraceDecoder::GetSummary()
+{
+    // bytes of a message in progress are not counted until it completes
+    if (m_parser.m_parserState == MLR_ModemParserState::Start)
+    {
+        uint32_t kept = (m_parser.m_oneByteBuf != -1) ? 1 : 0; // '*' kept for the next message
+        m_summary.discardedBytes = m_summary.rxBytes - m_decodedBytes - kept;
+    }
+    return m_summary;
+}
+
+void MLR_TraceDecoder::PrintSummary(Print &out)
+{
+    const MLR_TraceSummary &s = GetSummary();
+    s_Printf(out, "duration        : %lu us\r\n", static_cast<unsigned long>(s.lastUs - s.firstUs));
+    s_Printf(out, "bytes rx / tx   : %lu / %lu (discarded %lu)\r\n", static_cast<unsigned long>(s.rxBytes),
+             static_cast<unsigned long>(s.txBytes), static_cast<unsigned long>(s.discardedBytes));
+    s_Printf(out, "commands        : %lu, responses %lu, errors %lu, parser errors %lu\r\n",
+             static_cast<unsigned long>(s.commands), static_cast<unsigned long>(s.responses),
+             static_cast<unsigned long>(s.errors), static_cast<unsigned long>(s.garbage));
+    if (s.latencyCount > 0)
+    {
+        s_Printf(out, "latency         : min %lu us, avg %lu us, max %lu us\r\n",
+                 static_cast<unsigned long>(s.latencyMinUs), static_cast<unsigned long>(s.latencySumUs / s.latencyCount),
+                 static_cast<unsigned long>(s.latencyMaxUs));
+    }
+    s_Printf(out, "transmissions   : %lu, finished %lu, LBT failures %lu\r\n",
+             static_cast<unsigned long>(s.transmits), static_cast<unsigned long>(s.txDone),
+             static_cast<unsigned long>(s.lbtFails));
+    if (s.txTimeCount > 0)
+    {
+        s_Printf(out, "tx time         : avg %lu us, max %lu us\r\n",
+                 static_cast<unsigned long>(s.txTimeSumUs / s.txTimeCount), static_cast<unsigned long>(s.txTimeMaxUs));
+    }
+    s_Printf(out, "received frames : %lu, %lu bytes", static_cast<unsigned long>(s.frames),
+             static_cast<unsigned long>(s.frameBytes));
+    if (s.frames > 0)
+    {
+        s_Printf(out, ", size min %u, avg %lu, max %u", s.minFrameLen,
+                 static_cast<unsigned long>(s.frameBytes / s.frames), s.maxFrameLen);
+    }
+    out.write("\r\n");
+}
+
+void MLR_TraceDecoder::m_FeedTx(uint8_t c, uint32_t timestampUs)
+{
+    // "@DT" payload, may contain any byte
+    if (m_txDataLeft > 0)
+    {
+        m_txLine[m_txLen++] = c;
+        if (--m_txDataLeft == 0)
+        {
+            m_OnCommand(MLR_TraceEventType::Transmit, &m_txLine[5], m_txLen - 5, timestampUs);
+            m_txLen = 0; // the following CR/LF is skipped as empty line
+        }
+        return;
+    }
+
+    if (c == '\r' || c == '\n')
+    {
+        if (m_txLen > 0)
+        {
+            m_OnCommand(MLR_TraceEventType::Command, m_txLine, m_txLen, timestampUs);
+            m_txLen = 0;
+        }
+        return;
+    }
+
+    if (m_txLen == 0 && c != '@')
+    {
+        return; // not a command
+    }
+
+    if (m_txLen < 5)
+    {
+        m_txLine[m_txLen++] = c;
+        uint8_t dataLen;
+        if (m_txLen == 5 && memcmp(m_txLine, "@DT", 3) == 0 && s_ParseHexByte(&m_txLine[3], &dataLen))
+        {
+            m_txDataLeft = dataLen;
+            if (dataLen == 0)
+            {
+                m_OnCommand(MLR_TraceEventType::Transmit, &m_txLine[5], 0, timestampUs);
+                m_txLen = 0;
+            }
+        }
+    }
+    else if (m_txLen < sizeof(m_txLine))
+    {
+        m_txLine[m_txLen++] = c;
+    }
+}
+
+void MLR_TraceDecoder::m_OnCommand(MLR_TraceEventType type, const uint8_t *pData, uint16_t len, uint32_t timestampUs)
+{
+    ++m_summary.commands;
+    m_cmdPending = true;
+    m_cmdAt = timestampUs;
+    if (type == MLR_TraceEventType::Transmit)
+    {
+        ++m_summary.transmits;
+        m_txPending = true;
+        m_txAt = timestampUs;
+    }
+    m_Emit(timestampUs, MLR_TraceDirection::Tx, type, pData, len, 0);
+}
+
+void MLR_TraceDecoder::m_OnResponse(uint32_t timestampUs)
+{
+    const uint8_t *pText = m_parser.m_rxMessage;
+    uint16_t len = m_parser.m_rxIdx;
+    MLR_TraceEventType type = MLR_TraceEventType::Response;
+    uint32_t latencyUs = 0;
+
+    ++m_summary.responses;
+    if (len >= 6 && memcmp(pText, "*IR=0", 5) == 0)
+    {
+        // end of a transmission, the duration is measured from "@DT"
+        type = (pText[5] == '3') ? MLR_TraceEventType::TxDone : MLR_TraceEventType::LbtFail;
+        ++((type == MLR_TraceEventType::TxDone) ? m_summary.txDone : m_summary.lbtFails);
+        if (m_txPending)
+        {
+            m_txPending = false;
+            latencyUs = timestampUs - m_txAt;
+            ++m_summary.txTimeCount;
+            m_summary.txTimeSumUs += latencyUs;
+            if (latencyUs > m_summary.txTimeMaxUs)
+            {
+                m_summary.txTimeMaxUs = latencyUs;
+            }
+        }
+    }
+    else
+    {
+        if (len >= 3 && memcmp(pText, "*ER", 3) == 0)
+        {
+            type = MLR_TraceEventType::Error;
+            ++m_summary.errors;
+        }
+
+        // only the first response of a command, e.g. not "*CH=0E" after "*WR=PS"
+        if (m_cmdPending)
+        {
+            m_cmdPending = false;
+            latencyUs = timestampUs - m_cmdAt;
+            if (m_summary.latencyCount == 0 || latencyUs < m_summary.latencyMinUs)
+            {
+                m_summary.latencyMinUs = latencyUs;
+            }
+            if (latencyUs > m_summary.latencyMaxUs)
+            {
+                m_summary.latencyMaxUs = latencyUs;
+            }
+            ++m_summary.latencyCount;
+            m_summary.latencySumUs += latencyUs;
+        }
+    }
+
+    m_Emit(timestampUs, MLR_TraceDirection::Rx, type, pText, len, latencyUs);
+}
+
+void MLR_TraceDecoder::m_Emit(uint32_t timeUs, MLR_TraceDirection direction, MLR_TraceEventType type,
+                              const uint8_t *pData, uint16_t len, uint32_t latencyUs)
+{
+    if (!m_pOut)
+    {
+        return;
+    }
+
+    const char *pDir = (direction == MLR_TraceDirection::Rx) ? "rx" : "tx";
+    const char *pEvent = s_eventNames[static_cast<uint8_t>(type)];
+    bool json = (m_format == MLR_TraceFormat::Json);
+    char buf[80];
+
+    if (json)
+    {
+        s_Printf(*m_pOut, "{\"t\":%lu,\"dir\":\"%s\",\"event\":\"%s\",\"len\":%u,\"latency_us\":%lu,\"data\":\"",
+                 static_cast<unsigned long>(timeUs), pDir, pEvent, len, static_cast<unsigned long>(latencyUs));
+    }
+    else
+    {
+        s_Printf(*m_pOut, "%lu,%s,%s,%u,%lu,\"", static_cast<unsigned long>(timeUs), pDir, pEvent, len,
+                 static_cast<unsigned long>(latencyUs));
+    }
+
+    // payloads as hex, text with the quotes escaped and other bytes replaced
+    bool binary = (type == MLR_TraceEventType::Transmit || type == MLR_TraceEventType::Receive);
+    uint8_t n = 0;
+    for (uint16_t i = 0; i < len; ++i)
+    {
+        uint8_t c = pData[i];
+        if (binary)
+        {
+            buf[n++] = s_hexDigits[c >> 4];
+            buf[n++] = s_hexDigits[c & 0x0F];
+        }
+        else if (c == '"' || (json && c == '\\'))
+        {
+            buf[n++] = json ? '\\' : '"';
+            buf[n++] = c;
+        }
+        else
+        {
+            buf[n++] = (c >= 0x20 && c < 0x7F) ? c : '.';
+        }
+
+        if (n >= sizeof(buf) - 2)
+        {
+            m_pOut->write(reinterpret_cast<const uint8_t *>(buf), n);
+            n = 0;
+        }
+    }
+    m_pOut->write(reinterpret_cast<const uint8_t *>(buf), n);
+    m_pOut->write(json ? "\"}\r\n" : "\"\r\n");
+}
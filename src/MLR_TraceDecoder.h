@@ -0,0 +1,154 @@
+//
+// MLR_TraceDecoder.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Offline analyzer for captured serial traffic between application and modem (incident analysis).
+// The bytes received from the modem are decoded by the driver's own parser, so the trace is seen exactly
+// as the driver sees it; the bytes sent to the modem are split into commands and "@DT" transmissions.
+// Every decoded item is written as one CSV row or one JSON object per line (JSON Lines) with its
+// timestamp, and a summary collects counts, response latencies, transmission times and frame sizes.
+// The decoder does not use the serial port, so it also runs on a PC with an Arduino compatibility layer.
+
+#pragma once
+#include "MLR_Modem.h"
+
+/**
+ * \brief Direction of the captured bytes.
+ */
+enum class MLR_TraceDirection
+{
+    Rx, //!< From the modem to the application
+    Tx, //!< From the application to the modem
+};
+
+/**
+ * \brief Output format of the decoded events.
+ */
+enum class MLR_TraceFormat
+{
+    Csv,  //!< One row per event after a header row: time_us,dir,event,len,latency_us,data
+    Json, //!< One JSON object per line
+};
+
+/**
+ * \brief Type of a decoded event.
+ */
+enum class MLR_TraceEventType
+{
+    Command,  //!< Command sent to the modem, e.g. "@CH0E"
+    Transmit, //!< "@DT" transmission, the data is the payload
+    Response, //!< Command response, e.g. "*CH=0E"
+    Receive,  //!< "*DR" telegram, the data is the payload
+    TxDone,   //!< "*IR=03": transmission finished
+    LbtFail,  //!< "*IR=01"/"*IR=02": transmission rejected by carrier sense
+    Error,    //!< "*ER=..." response
+    Garbage,  //!< Input the parser rejected (malformed or too long)
+};
+
+/**
+ * \brief Counts and timings of a decoded trace.
+ */
+struct MLR_TraceSummary
+{
+    uint32_t firstUs;          //!< Timestamp of the first byte
+    uint32_t lastUs;           //!< Timestamp of the last byte
+    uint32_t rxBytes;          //!< Bytes received from the modem
+    uint32_t txBytes;          //!< Bytes sent to the modem
+    uint32_t discardedBytes;   //!< Received bytes that were not part of a decoded response or telegram
+    uint32_t commands;         //!< Commands, including transmissions
+    uint32_t responses;        //!< Responses, including "*IR" and "*ER"
+    uint32_t errors;           //!< "*ER" responses
+    uint32_t garbage;          //!< Parser errors
+    uint32_t transmits;        //!< "@DT" transmissions
+    uint32_t txDone;           //!< Finished transmissions
+    uint32_t lbtFails;         //!< Transmissions rejected by carrier sense
+    uint32_t frames;           //!< Received "*DR" telegrams
+    uint32_t frameBytes;       //!< Payload bytes of the received telegrams
+    uint8_t minFrameLen;       //!< Shortest received payload
+    uint8_t maxFrameLen;       //!< Longest received payload
+    uint32_t latencyCount;     //!< Responses with a measured latency
+    uint32_t latencyMinUs;     //!< Shortest time from the end of a command to its first response
+    uint32_t latencyMaxUs;     //!< Longest time from the end of a command to its first response
+    uint64_t latencySumUs;     //!< Sum of the response latencies
+    uint32_t txTimeCount;      //!< Transmissions with a measured duration
+    uint32_t txTimeMaxUs;      //!< Longest time from "@DT" to "*IR"
+    uint64_t txTimeSumUs;      //!< Sum of the transmission durations
+};
+
+/**
+ * \brief Decoder for captured serial traffic.
+ */
+class MLR_TraceDecoder
+{
+public:
+    /**
+     * \brief Starts a new trace.
+     * \param pOut Output for the events (e.g. &Serial or a file), or nullptr to collect the summary only.
+     * \param format Output format. For CSV the header row is written immediately.
+     */
+    void begin(Print *pOut, MLR_TraceFormat format = MLR_TraceFormat::Csv);
+
+    /**
+     * \brief Decodes a chunk of captured bytes.
+     * \param direction Direction of the bytes.
+     * \param pData The bytes. Messages may be split across chunks.
+     * \param len Number of bytes.
+     * \param timestampUs Capture timestamp of the chunk in microseconds, used for all events completed
+     *                    by the chunk. Pass 0 for raw captures without timestamps.
+     * \note For an accurate latency, feed the chunks of both directions in capture order.
+     */
+    void Feed(MLR_TraceDirection direction, const uint8_t *pData, size_t len, uint32_t timestampUs = 0);
+
+    /**
+     * \brief Gets the summary of the trace so far.
+     */
+    const MLR_TraceSummary &GetSummary();
+
+    /**
+     * \brief Writes the summary in readable form.
+     * \param out Output for the summary.
+     */
+    void PrintSummary(Print &out);
+
+private:
+    //! Internal: Stream that hands the bytes of the current chunk to the parser
+    class Source : public Stream
+    {
+    public:
+        int available() override { return static_cast<int>(m_len); }
+        int read() override { return m_len ? (--m_len, *m_pData++) : -1; }
+        int peek() override { return m_len ? *m_pData : -1; }
+        size_t write(uint8_t) override { return 0; } // the parser never writes
+
+        const uint8_t *m_pData = nullptr; //!< Next byte of the chunk
+        size_t m_len = 0;                 //!< Remaining bytes of the chunk
+    };
+
+    //! Internal: Decodes one byte sent to the modem
+    void m_FeedTx(uint8_t c, uint32_t timestampUs);
+
+    //! Internal: Classifies a response completed by the parser
+    void m_OnResponse(uint32_t timestampUs);
+
+    //! Internal: Records a command sent to the modem
+    void m_OnCommand(MLR_TraceEventType type, const uint8_t *pData, uint16_t len, uint32_t timestampUs);
+
+    //! Internal: Writes one event in the selected format
+    void m_Emit(uint32_t timeUs, MLR_TraceDirection direction, MLR_TraceEventType type, const uint8_t *pData,
+                uint16_t len, uint32_t latencyUs);
+
+    Print *m_pOut = nullptr;                               //!< Event output, or nullptr
+    MLR_TraceFormat m_format = MLR_TraceFormat::Csv;       //!< Event output format
+    MLR_Modem m_parser;                                    //!< Driver instance used for its receive parser only
+    Source m_source;                                       //!< Input of m_parser
+    bool m_started = false;                                //!< At least one byte was fed
+    bool m_cmdPending = false;                             //!< A command waits for its first response
+    bool m_txPending = false;                              //!< A transmission waits for "*IR"
+    uint32_t m_cmdAt = 0;                                  //!< Timestamp of the pending command
+    uint32_t m_txAt = 0;                                   //!< Timestamp of the pending transmission
+    uint32_t m_decodedBytes = 0;                           //!< Received bytes that belong to decoded events
+    uint16_t m_txLen = 0;                                  //!< Bytes in m_txLine
+    uint16_t m_txDataLeft = 0;                             //!< Payload bytes of "@DT" still expected
+    MLR_TraceSummary m_summary = {};                       //!< Summary of the trace
+    uint8_t m_txLine[5 + MLR_MAX_PAYLOAD_LEN];             //!< Command being sent ("@DTvv" and payload)
+};
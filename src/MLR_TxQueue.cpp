@@ -0,0 +1,573 @@
+//
+// MLR_TxQueue.cpp
+//
+// (c) 2026 CircuitDesign,Inc.
+// Store-and-forward transmit queue.
+//
+// Storage layout, per sector:
+//   header: magic(4) seq(4)    seq grows by one for every sector that is started
+//   records: state(1) ~len(1) data(len), written back to back until the sector is full
+// The length is stored inverted, so that a record never has an erased length byte (frames are
+// never empty). A record is programmed as length and data first, then its state byte (commit).
+// A state byte of 0xFF with a programmed length is a record torn by a reset and is skipped.
+// Sent records are marked by programming the state byte once more.
+//
+
+#include "MLR_TxQueue.h"
+#include <string.h>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static constexpr uint32_t MLR_TXQUEUE_SECTOR_MAGIC = 0x5154524D; // "MRTQ"
+static constexpr uint8_t MLR_TXQUEUE_SECTOR_HEADER_LEN = 8;
+static constexpr uint8_t MLR_TXQUEUE_RECORD_HEADER_LEN = 2;
+
+static constexpr uint8_t MLR_TXQUEUE_STATE_ERASED = 0xFF;
+static constexpr uint8_t MLR_TXQUEUE_STATE_VALID = 0x7F;
+static constexpr uint8_t MLR_TXQUEUE_STATE_SENT = 0x3F;
+
+MLR_Modem_Error MLR_TxQueue::begin(MLR_Modem &modem, MLR_TxStorage *pStorage)
+{
+    m_pModem = &modem;
+    m_pStorage = pStorage;
+    m_stagedCount = 0;
+    m_stagedLen = 0;
+    m_storedCount = 0;
+    m_retryDelay = 0;
+    m_budgetRefill = millis();
+    m_budgetFrac = 0;
+
+    if (!pStorage)
+    {
+        return MLR_Modem_Error::Ok;
+    }
+
+    MLR_Modem_Error err = m_Mount();
+    if (err != MLR_Modem_Error::Ok)
+    {
+        m_pStorage = nullptr;
+    }
+    return err;
+}
+
+void MLR_TxQueue::end()
+{
+    if (m_pStorage)
+    {
+        Flush();
+    }
+    m_pModem = nullptr;
+}
+
+MLR_Modem_Error MLR_TxQueue::Enqueue(const uint8_t *pData, uint8_t len)
+{
+    if (!pData || len == 0)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    if (m_stagedLen + 1 + len > MLR_TXQUEUE_STAGING_SIZE && Flush() != MLR_Modem_Error::Ok)
+    {
+        return MLR_Modem_Error::BufferTooSmall;
+    }
+
+    if (m_stagedCount == 0)
+    {
+        m_stagedSince = millis();
+    }
+
+    m_staged[m_stagedLen] = len;
+    memcpy(&m_staged[m_stagedLen + 1], pData, len);
+    m_stagedLen += 1 + len;
+    ++m_stagedCount;
+
+    if (m_pStorage && m_commitIntervalMs == 0)
+    {
+        return Flush();
+    }
+    return MLR_Modem_Error::Ok;
+}
+
+MLR_Modem_Error MLR_TxQueue::Flush()
+{
+    if (m_stagedCount == 0)
+    {
+        return MLR_Modem_Error::Ok;
+    }
+
+    if (!m_pStorage)
+    {
+        return MLR_Modem_Error::Fail;
+    }
+
+    while (m_stagedCount > 0)
+    {
+        MLR_Modem_Error err = m_Store(&m_staged[1], m_staged[0]);
+        if (err != MLR_Modem_Error::Ok)
+        {
+            return err;
+        }
+        m_PopStaged();
+    }
+    return MLR_Modem_Error::Ok;
+}
+
+void MLR_TxQueue::Work()
+{
+    if (!m_pModem)
+    {
+        return;
+    }
+
+    uint32_t now = millis();
+
+    // frames that could be sent quickly never touch the storage
+    if (m_pStorage && m_stagedCount > 0 && now - m_stagedSince >= m_commitIntervalMs)
+    {
+        Flush();
+    }
+
+    if (GetPendingCount() == 0 || (m_retryDelay != 0 && now - m_retryAt < m_retryDelay + m_retryJitter))
+    {
+        return;
+    }
+
+    // stored frames are always older than staged ones
+    uint8_t buf[MLR_MAX_PAYLOAD_LEN];
+    const uint8_t *pData = buf;
+    uint8_t len = 0;
+    bool fromStorage = (m_storedCount > 0);
+    if (fromStorage)
+    {
+        if (!m_LoadHead(buf, &len))
+        {
+            return;
+        }
+    }
+    else
+    {
+        len = m_staged[0];
+        pData = &m_staged[1];
+    }
+
+    uint32_t airtimeUs = 0;
+    if (m_budgetMsPerHour != 0)
+    {
+        airtimeUs = (m_pModem->GetCachedMode() == MLR_ModemMode::FskCmd) ? MLR_Airtime_FskUs(len, m_budgetFskBitrate)
+                                                                        : MLR_Airtime_LoRaUs(len, m_budgetSf, m_budgetBwHz);
+        if (!m_CheckAirtime(airtimeUs))
+        {
+            return;
+        }
+    }
+
+    MLR_Modem_Error err = m_pModem->TransmitData(pData, len);
+    if (err == MLR_Modem_Error::Busy)
+    {
+        return;
+    }
+
+    if (err != MLR_Modem_Error::Ok)
+    {
+        ++m_retryCount;
+        m_retryDelay = (m_retryDelay == 0) ? MLR_TXQUEUE_RETRY_MIN_MS : m_retryDelay * 2;
+        if (m_retryDelay > MLR_TXQUEUE_RETRY_MAX_MS)
+        {
+            m_retryDelay = MLR_TXQUEUE_RETRY_MAX_MS;
+        }
+        // jitter keeps nodes that failed on the same busy channel from retrying in lockstep;
+        // it only delays this retry, so it neither accumulates nor lifts the cap
+        m_retryJitter = random(m_retryDelay / 4 + 1);
+        m_retryAt = millis();
+        return;
+    }
+
+    m_budgetUs -= airtimeUs;
+    m_retryDelay = 0;
+    ++m_sentCount;
+    if (fromStorage)
+    {
+        m_ConsumeHead();
+    }
+    else
+    {
+        m_PopStaged();
+    }
+}
+
+void MLR_TxQueue::SetAirtimeBudget(uint32_t msPerHour, MLR_ModemSpreadFactor sf, uint32_t bwHz, uint32_t fskBitrate)
+{
+    m_budgetMsPerHour = (bwHz != 0 && fskBitrate != 0) ? msPerHour : 0;
+    m_budgetSf = MLR_Airtime_SpreadFactor(sf);
+    m_budgetBwHz = bwHz;
+    m_budgetFskBitrate = fskBitrate;
+    m_budgetUs = static_cast<int64_t>(m_budgetMsPerHour) * 1000;
+    m_budgetRefill = millis();
+    m_budgetFrac = 0;
+}
+
+bool MLR_TxQueue::m_CheckAirtime(uint32_t airtimeUs)
+{
+    uint32_t now = millis();
+    int64_t capacity = static_cast<int64_t>(m_budgetMsPerHour) * 1000;
+
+    // msPerHour milliseconds per 3600000 ms are msPerHour / 3600 us per elapsed ms; the remainder
+    // of the division is carried over, otherwise frequent checks of a small budget would never refill it
+    uint64_t credit = static_cast<uint64_t>(now - m_budgetRefill) * m_budgetMsPerHour + m_budgetFrac;
+    m_budgetUs += static_cast<int64_t>(credit / 3600);
+    m_budgetFrac = static_cast<uint16_t>(credit % 3600);
+    m_budgetRefill = now;
+    if (m_budgetUs > capacity)
+    {
+        m_budgetUs = capacity;
+    }
+
+    // a frame longer than the whole budget is sent with a full budget and leaves it in debt
+    return m_budgetUs >= airtimeUs || m_budgetUs == capacity;
+}
+
+void MLR_TxQueue::m_PopStaged()
+{
+    uint16_t recordLen = 1 + m_staged[0];
+    m_stagedLen -= recordLen;
+    memmove(m_staged, &m_staged[recordLen], m_stagedLen);
+    --m_stagedCount;
+}
+
+MLR_Modem_Error MLR_TxQueue::m_Mount()
+{
+    m_sectorCount = m_pStorage->GetSectorCount();
+    m_sectorSize = m_pStorage->GetSectorSize();
+    if (m_sectorCount < 2 || m_sectorSize < MLR_TXQUEUE_SECTOR_HEADER_LEN + MLR_TXQUEUE_RECORD_HEADER_LEN + MLR_MAX_PAYLOAD_LEN)
+    {
+        return MLR_Modem_Error::InvalidArg;
+    }
+
+    // the sector with the highest sequence number is the one being written
+    bool found = false;
+    uint16_t newest = 0;
+    uint32_t newestSeq = 0;
+    for (uint16_t sector = 0; sector < m_sectorCount; ++sector)
+    {
+        uint8_t header[MLR_TXQUEUE_SECTOR_HEADER_LEN];
+        if (!m_pStorage->Read(sector * m_sectorSize, header, sizeof(header)))
+        {
+            return MLR_Modem_Error::Fail;
+        }
+
+        uint32_t seq = MLR_Frame_GetU32(&header[4]);
+        if (MLR_Frame_GetU32(header) == MLR_TXQUEUE_SECTOR_MAGIC && (!found || static_cast<int32_t>(seq - newestSeq) > 0))
+        {
+            found = true;
+            newest = sector;
+            newestSeq = seq;
+        }
+    }
+
+    if (!found)
+    {
+        // empty storage: the first frame starts a new sector
+        m_writeSector = m_sectorCount - 1;
+        m_writeSeq = 0;
+        m_writeOffset = m_sectorSize;
+        m_readSector = m_writeSector;
+        m_readOffset = m_writeOffset;
+        return MLR_Modem_Error::Ok;
+    }
+
+    // the preceding sectors with consecutive sequence numbers may still hold unsent frames
+    uint16_t oldest = newest;
+    uint32_t oldestSeq = newestSeq;
+    for (uint16_t i = 1; i < m_sectorCount; ++i)
+    {
+        uint16_t prev = (oldest + m_sectorCount - 1) % m_sectorCount;
+        uint8_t header[MLR_TXQUEUE_SECTOR_HEADER_LEN];
+        if (!m_pStorage->Read(prev * m_sectorSize, header, sizeof(header)) ||
+            MLR_Frame_GetU32(header) != MLR_TXQUEUE_SECTOR_MAGIC || MLR_Frame_GetU32(&header[4]) != oldestSeq - 1)
+        {
+            break;
+        }
+        oldest = prev;
+        --oldestSeq;
+    }
+
+    m_writeSector = newest;
+    m_writeSeq = newestSeq;
+    m_storedCount = 0;
+
+    uint16_t sector = oldest;
+    for (;;)
+    {
+        uint32_t offset = MLR_TXQUEUE_SECTOR_HEADER_LEN;
+        while (offset + MLR_TXQUEUE_RECORD_HEADER_LEN <= m_sectorSize)
+        {
+            uint8_t record[MLR_TXQUEUE_RECORD_HEADER_LEN];
+            if (!m_pStorage->Read(sector * m_sectorSize + offset, record, sizeof(record)))
+            {
+                return MLR_Modem_Error::Fail;
+            }
+            if (record[0] == MLR_TXQUEUE_STATE_ERASED && record[1] == 0xFF)
+            {
+                break;
+            }
+            if (record[0] == MLR_TXQUEUE_STATE_VALID)
+            {
+                ++m_storedCount;
+            }
+            offset += MLR_TXQUEUE_RECORD_HEADER_LEN + static_cast<uint8_t>(~record[1]);
+        }
+
+        if (sector == newest)
+        {
+            m_writeOffset = offset;
+            break;
+        }
+        sector = (sector + 1) % m_sectorCount;
+    }
+
+    m_readSector = oldest;
+    m_readOffset = MLR_TXQUEUE_SECTOR_HEADER_LEN;
+    m_SkipToValid(&m_readSector, &m_readOffset);
+    return MLR_Modem_Error::Ok;
+}
+
+MLR_Modem_Error MLR_TxQueue::m_Store(const uint8_t *pData, uint8_t len)
+{
+    uint32_t recordLen = MLR_TXQUEUE_RECORD_HEADER_LEN + len;
+    if (m_writeOffset + recordLen > m_sectorSize)
+    {
+        uint16_t next = (m_writeSector + 1) % m_sectorCount;
+        if (m_storedCount > 0 && next == m_readSector)
+        {
+            return MLR_Modem_Error::BufferTooSmall;
+        }
+
+        // each sector is erased once per pass through the ring, right before it is reused
+        uint8_t header[MLR_TXQUEUE_SECTOR_HEADER_LEN];
+        MLR_Frame_PutU32(header, MLR_TXQUEUE_SECTOR_MAGIC);
+        MLR_Frame_PutU32(&header[4], m_writeSeq + 1);
+        ++m_eraseCount;
+        if (!m_pStorage->Erase(next) || !m_pStorage->Program(next * m_sectorSize, header, sizeof(header)))
+        {
+            return MLR_Modem_Error::Fail;
+        }
+
+        m_writeSector = next;
+        ++m_writeSeq;
+        m_writeOffset = MLR_TXQUEUE_SECTOR_HEADER_LEN;
+    }
+
+    uint32_t addr = m_writeSector * m_sectorSize + m_writeOffset;
+    uint8_t state = MLR_TXQUEUE_STATE_VALID;
+    uint8_t lenByte = ~len;
+    bool ok = m_pStorage->Program(addr + 1, &lenByte, 1) &&
+              m_pStorage->Program(addr + MLR_TXQUEUE_RECORD_HEADER_LEN, pData, len) &&
+              m_pStorage->Program(addr, &state, 1);
+
+    // the space is used even if programming failed
+    if (m_storedCount == 0)
+    {
+        m_readSector = m_writeSector;
+        m_readOffset = m_writeOffset;
+    }
+    m_writeOffset += recordLen;
+
+    if (!ok)
+    {
+        m_SkipToValid(&m_readSector, &m_readOffset);
+        return MLR_Modem_Error::Fail;
+    }
+
+    ++m_storedCount;
+    return MLR_Modem_Error::Ok;
+}
+
+bool MLR_TxQueue::m_LoadHead(uint8_t *pDst, uint8_t *pLen)
+{
+    uint32_t addr = m_readSector * m_sectorSize + m_readOffset;
+    uint8_t record[MLR_TXQUEUE_RECORD_HEADER_LEN];
+    if (!m_pStorage->Read(addr, record, sizeof(record)) ||
+        !m_pStorage->Read(addr + MLR_TXQUEUE_RECORD_HEADER_LEN, pDst, static_cast<uint8_t>(~record[1])))
+    {
+        return false;
+    }
+    *pLen = ~record[1];
+    return true;
+}
+
+void MLR_TxQueue::m_ConsumeHead()
+{
+    uint32_t addr = m_readSector * m_sectorSize + m_readOffset;
+    uint8_t record[MLR_TXQUEUE_RECORD_HEADER_LEN];
+    m_pStorage->Read(addr, record, sizeof(record));
+
+    uint8_t state = MLR_TXQUEUE_STATE_SENT;
+    m_pStorage->Program(addr, &state, 1);
+    --m_storedCount;
+
+    m_readOffset += MLR_TXQUEUE_RECORD_HEADER_LEN + static_cast<uint8_t>(~record[1]);
+    if (m_storedCount == 0)
+    {
+        m_readSector = m_writeSector;
+        m_readOffset = m_writeOffset;
+    }
+    else
+    {
+        m_SkipToValid(&m_readSector, &m_readOffset);
+    }
+}
+
+void MLR_TxQueue::m_SkipToValid(uint16_t *pSector, uint32_t *pOffset)
+{
+    while (!(*pSector == m_writeSector && *pOffset >= m_writeOffset))
+    {
+        uint8_t record[MLR_TXQUEUE_RECORD_HEADER_LEN] = {MLR_TXQUEUE_STATE_ERASED, 0xFF};
+        if (*pOffset + MLR_TXQUEUE_RECORD_HEADER_LEN <= m_sectorSize)
+        {
+            m_pStorage->Read(*pSector * m_sectorSize + *pOffset, record, sizeof(record));
+        }
+
+        if (record[0] == MLR_TXQUEUE_STATE_ERASED && record[1] == 0xFF)
+        {
+            // end of the written part of this sector
+            *pSector = (*pSector + 1) % m_sectorCount;
+            *pOffset = MLR_TXQUEUE_SECTOR_HEADER_LEN;
+        }
+        else if (record[0] == MLR_TXQUEUE_STATE_VALID)
+        {
+            return;
+        }
+        else
+        {
+            *pOffset += MLR_TXQUEUE_RECORD_HEADER_LEN + static_cast<uint8_t>(~record[1]);
+        }
+    }
+}
+
+#if defined(__linux__)
+bool MLR_TxFileStorage::Open(const char *pPath, uint16_t sectorCount, uint32_t sectorSize)
+{
+    Close();
+
+    m_fd = open(pPath, O_RDWR | O_CREAT, 0644);
+    if (m_fd < 0)
+    {
+        return false;
+    }
+
+    m_sectorCount = sectorCount;
+    m_sectorSize = sectorSize;
+
+    struct stat st;
+    if (fstat(m_fd, &st) != 0)
+    {
+        Close();
+        return false;
+    }
+
+    // a new (or resized) file starts erased
+    if (static_cast<uint64_t>(st.st_size) != static_cast<uint64_t>(sectorCount) * sectorSize)
+    {
+        if (ftruncate(m_fd, 0) != 0)
+        {
+            Close();
+            return false;
+        }
+        for (uint16_t sector = 0; sector < sectorCount; ++sector)
+        {
+            if (!Erase(sector))
+            {
+                Close();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void MLR_TxFileStorage::Close()
+{
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool MLR_TxFileStorage::Read(uint32_t addr, uint8_t *pDst, uint16_t len)
+{
+    return m_fd >= 0 && pread(m_fd, pDst, len, addr) == len;
+}
+
+bool MLR_TxFileStorage::Program(uint32_t addr, const uint8_t *pSrc, uint16_t len)
+{
+    uint8_t buf[256];
+    while (len > 0)
+    {
+        uint16_t chunk = (len < sizeof(buf)) ? len : sizeof(buf);
+        if (!Read(addr, buf, chunk))
+        {
+            return false;
+        }
+        for (uint16_t i = 0; i < chunk; ++i)
+        {
+            buf[i] &= pSrc[i]; // like flash, programming only clears bits
+        }
+        if (pwrite(m_fd, buf, chunk, addr) != chunk)
+        {
+            return false;
+        }
+        addr += chunk;
+        pSrc += chunk;
+        len -= chunk;
+    }
+    return true;
+}
+
+bool MLR_TxFileStorage::Erase(uint16_t sector)
+{
+    if (m_fd < 0 || sector >= m_sectorCount)
+    {
+        return false;
+    }
+
+    uint8_t buf[256];
+    memset(buf, 0xFF, sizeof(buf));
+    for (uint32_t offset = 0; offset < m_sectorSize; offset += sizeof(buf))
+    {
+        uint32_t chunk = (m_sectorSize - offset < sizeof(buf)) ? m_sectorSize - offset : sizeof(buf);
+        if (pwrite(m_fd, buf, chunk, static_cast<off_t>(sector) * m_sectorSize + offset) != static_cast<ssize_t>(chunk))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+#if defined(ESP32)
+bool MLR_TxPartitionStorage::Open(const char *pLabel)
+{
+    m_pPartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, pLabel);
+    return m_pPartition != nullptr;
+}
+
+bool MLR_TxPartitionStorage::Read(uint32_t addr, uint8_t *pDst, uint16_t len)
+{
+    return m_pPartition && esp_partition_read(m_pPartition, addr, pDst, len) == ESP_OK;
+}
+
+bool MLR_TxPartitionStorage::Program(uint32_t addr, const uint8_t *pSrc, uint16_t len)
+{
+    return m_pPartition && esp_partition_write(m_pPartition, addr, pSrc, len) == ESP_OK;
+}
+
+bool MLR_TxPartitionStorage::Erase(uint16_t sector)
+{
+    return m_pPartition && esp_partition_erase_range(m_pPartition, sector * MLR_TXQUEUE_ESP32_SECTOR_SIZE, MLR_TXQUEUE_ESP32_SECTOR_SIZE) == ESP_OK;
+}
+#endif
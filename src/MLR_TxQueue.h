@@ -0,0 +1,292 @@
+//
+// MLR_TxQueue.h
+//
+// (c) 2026 CircuitDesign,Inc.
+// Store-and-forward transmit queue. Frames are staged in RAM and sent as soon as the modem
+// accepts them; frames that could not be sent within the commit interval are written to a
+// persistent storage and survive a reset. The queue drains automatically in Work(), with
+// backoff after LBT failures and an optional airtime budget.
+//
+// The storage is organized as a ring of flash sectors that are written strictly sequentially
+// and erased once per pass; sent frames are marked by clearing bits of their state byte,
+// so no location is ever rewritten with a new value.
+
+#pragma once
+#include "MLR_Modem.h"
+#include "MLR_Airtime.h"
+#if defined(ESP32)
+#include <esp_partition.h>
+#endif
+
+#ifndef MLR_TXQUEUE_STAGING_SIZE
+/**
+ * @brief Size of the RAM staging buffer in bytes (each frame takes its length + 1 byte).
+ */
+#define MLR_TXQUEUE_STAGING_SIZE 512
+#endif
+
+/**
+ * @brief Default time a frame stays in RAM before it is committed to the storage in milliseconds.
+ */
+static constexpr uint32_t MLR_TXQUEUE_COMMIT_INTERVAL_MS = 5000;
+
+/**
+ * @brief Initial retry delay after a failed transmission in milliseconds. Doubles with every failure.
+ */
+static constexpr uint32_t MLR_TXQUEUE_RETRY_MIN_MS = 200;
+
+/**
+ * @brief Maximum retry delay after failed transmissions in milliseconds.
+ */
+static constexpr uint32_t MLR_TXQUEUE_RETRY_MAX_MS = 30000;
+
+/**
+ * \brief Interface of a persistent storage with flash semantics.
+ *
+ * Erasing a sector sets all its bytes to 0xFF. Programming may only clear bits (1 -> 0);
+ * the queue relies on being able to program the same byte more than once for this.
+ */
+class MLR_TxStorage
+{
+public:
+    /**
+     * \brief Gets the size of one erase sector in bytes (at least 512).
+     */
+    virtual uint32_t GetSectorSize() const = 0;
+
+    /**
+     * \brief Gets the number of sectors (at least 2).
+     */
+    virtual uint16_t GetSectorCount() const = 0;
+
+    /**
+     * \brief Reads data.
+     * \param addr Byte address (sector * GetSectorSize() + offset).
+     * \param pDst Buffer to store the data.
+     * \param len Number of bytes to read.
+     * \return true on success.
+     */
+    virtual bool Read(uint32_t addr, uint8_t *pDst, uint16_t len) = 0;
+
+    /**
+     * \brief Programs data (clears the bits that are 0 in pSrc).
+     * \param addr Byte address.
+     * \param pSrc Data to program.
+     * \param len Number of bytes to program.
+     * \return true on success.
+     */
+    virtual bool Program(uint32_t addr, const uint8_t *pSrc, uint16_t len) = 0;
+
+    /**
+     * \brief Erases a sector.
+     * \param sector The sector index.
+     * \return true on success.
+     */
+    virtual bool Erase(uint16_t sector) = 0;
+};
+
+#if defined(__linux__)
+/**
+ * \brief Storage backed by a file on the host, emulating flash behavior.
+ */
+class MLR_TxFileStorage : public MLR_TxStorage
+{
+public:
+    ~MLR_TxFileStorage() { Close(); }
+
+    /**
+     * \brief Opens or creates the storage file.
+     * \param pPath Path of the file.
+     * \param sectorCount Number of sectors.
+     * \param sectorSize Size of one sector in bytes.
+     * \return true on success.
+     */
+    bool Open(const char *pPath, uint16_t sectorCount = 16, uint32_t sectorSize = 4096);
+
+    /**
+     * \brief Closes the storage file.
+     */
+    void Close();
+
+    uint32_t GetSectorSize() const override { return m_sectorSize; }
+    uint16_t GetSectorCount() const override { return m_sectorCount; }
+    bool Read(uint32_t addr, uint8_t *pDst, uint16_t len) override;
+    bool Program(uint32_t addr, const uint8_t *pSrc, uint16_t len) override;
+    bool Erase(uint16_t sector) override;
+
+private:
+    int m_fd = -1;              //!< File descriptor
+    uint16_t m_sectorCount = 0; //!< Number of sectors
+    uint32_t m_sectorSize = 0;  //!< Sector size
+};
+#endif
+
+#if defined(ESP32)
+/**
+ * @brief Erase sector size of the ESP32 SPI flash.
+ */
+static constexpr uint32_t MLR_TXQUEUE_ESP32_SECTOR_SIZE = 4096;
+
+/**
+ * \brief Storage in a data partition of the ESP32 flash.
+ */
+class MLR_TxPartitionStorage : public MLR_TxStorage
+{
+public:
+    /**
+     * \brief Looks up the data partition.
+     * \param pLabel Label of the partition in the partition table.
+     * \return true if the partition was found.
+     * \note Flash encryption must be disabled for the partition, as the queue programs state bytes repeatedly.
+     */
+    bool Open(const char *pLabel);
+
+    uint32_t GetSectorSize() const override { return MLR_TXQUEUE_ESP32_SECTOR_SIZE; }
+    uint16_t GetSectorCount() const override { return m_pPartition ? m_pPartition->size / MLR_TXQUEUE_ESP32_SECTOR_SIZE : 0; }
+    bool Read(uint32_t addr, uint8_t *pDst, uint16_t len) override;
+    bool Program(uint32_t addr, const uint8_t *pSrc, uint16_t len) override;
+    bool Erase(uint16_t sector) override;
+
+private:
+    const esp_partition_t *m_pPartition = nullptr; //!< The data partition
+};
+#endif
+
+/**
+ * \brief Persistent store-and-forward transmit queue.
+ */
+class MLR_TxQueue
+{
+public:
+    /**
+     * \brief Attaches the queue to the driver and recovers unsent frames from the storage.
+     * \param modem The initialized modem driver.
+     * \param pStorage Persistent storage, or nullptr to keep frames in RAM only.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::InvalidArg if the storage geometry is unusable,
+     *         MLR_Modem_Error::Fail if the storage cannot be read.
+     */
+    MLR_Modem_Error begin(MLR_Modem &modem, MLR_TxStorage *pStorage = nullptr);
+
+    /**
+     * \brief Commits staged frames and detaches the queue.
+     */
+    void end();
+
+    /**
+     * \brief Queues a frame for transmission.
+     * \param pData Pointer to the payload.
+     * \param len Payload length (1-MLR_MAX_PAYLOAD_LEN).
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::BufferTooSmall if neither RAM nor storage can take the frame.
+     */
+    MLR_Modem_Error Enqueue(const uint8_t *pData, uint8_t len);
+
+    /**
+     * \brief Commits all staged frames to the storage.
+     * \return MLR_Modem_Error::Ok on success, MLR_Modem_Error::BufferTooSmall if the storage is full,
+     *         MLR_Modem_Error::Fail on storage errors or without storage.
+     */
+    MLR_Modem_Error Flush();
+
+    /**
+     * \brief Transmits the oldest frame when the modem and the airtime budget allow it, commits staged frames when due.
+     * This function must be called regularly, e.g. after MLR_Modem::Work(). It blocks while a frame is transmitted.
+     */
+    void Work();
+
+    /**
+     * \brief Sets how long frames stay in RAM before they are committed to the storage.
+     * \param ms Commit interval in milliseconds, 0 commits every frame immediately.
+     */
+    void SetCommitInterval(uint32_t ms) { m_commitIntervalMs = ms; }
+
+    /**
+     * \brief Limits the airtime used by the queue.
+     * \param msPerHour Airtime budget in milliseconds per hour, 0 removes the limit.
+     * \param sf Spreading factor configured in the modem.
+     * \param bwHz LoRa bandwidth of the modem in Hz.
+     * \param fskBitrate FSK bit rate of the modem in bit/s.
+     * \note The airtime of each frame is estimated with the LoRa or the FSK model, depending on
+     *       the mode of the modem (MLR_Modem::GetCachedMode()) when the frame is sent.
+     */
+    void SetAirtimeBudget(uint32_t msPerHour, MLR_ModemSpreadFactor sf, uint32_t bwHz,
+                          uint32_t fskBitrate = MLR_AIRTIME_FSK_BITRATE);
+
+    /**
+     * \brief Gets the number of frames waiting for transmission (RAM and storage).
+     */
+    uint16_t GetPendingCount() const { return m_stagedCount + m_storedCount; }
+
+    /**
+     * \brief Gets the number of frames waiting in the storage.
+     */
+    uint16_t GetStoredCount() const { return m_storedCount; }
+
+    /**
+     * \brief Gets the number of frames transmitted successfully.
+     */
+    uint32_t GetSentCount() const { return m_sentCount; }
+
+    /**
+     * \brief Gets the number of failed transmission attempts.
+     */
+    uint32_t GetRetryCount() const { return m_retryCount; }
+
+    /**
+     * \brief Gets the number of sector erases since begin().
+     */
+    uint32_t GetEraseCount() const { return m_eraseCount; }
+
+private:
+    //! Internal: Scans the storage for the read and write positions
+    MLR_Modem_Error m_Mount();
+
+    //! Internal: Appends a frame to the storage
+    MLR_Modem_Error m_Store(const uint8_t *pData, uint8_t len);
+
+    //! Internal: Reads the frame at the read position of the storage
+    bool m_LoadHead(uint8_t *pDst, uint8_t *pLen);
+
+    //! Internal: Marks the frame at the read position as sent and moves to the next frame
+    void m_ConsumeHead();
+
+    //! Internal: Moves a position forward to the next record that is not marked as sent
+    void m_SkipToValid(uint16_t *pSector, uint32_t *pOffset);
+
+    //! Internal: Removes the oldest frame from the staging buffer
+    void m_PopStaged();
+
+    //! Internal: Refills the airtime budget, returns false if it does not cover airtimeUs
+    bool m_CheckAirtime(uint32_t airtimeUs);
+
+    MLR_Modem *m_pModem = nullptr;        //!< Driver used for transmission
+    MLR_TxStorage *m_pStorage = nullptr;  //!< Persistent storage, or nullptr
+    uint16_t m_sectorCount = 0;           //!< Number of storage sectors
+    uint32_t m_sectorSize = 0;            //!< Size of a storage sector
+    uint32_t m_writeSeq = 0;              //!< Sequence number of the write sector
+    uint16_t m_writeSector = 0;           //!< Sector currently written
+    uint32_t m_writeOffset = 0;           //!< Next free byte in the write sector
+    uint16_t m_readSector = 0;            //!< Sector of the oldest stored frame
+    uint32_t m_readOffset = 0;            //!< Offset of the oldest stored frame
+    uint16_t m_storedCount = 0;           //!< Frames in the storage not yet sent
+    uint32_t m_eraseCount = 0;            //!< Sector erases
+
+    uint16_t m_stagedCount = 0;           //!< Frames in the staging buffer
+    uint16_t m_stagedLen = 0;             //!< Bytes used in the staging buffer
+    uint32_t m_stagedSince = 0;           //!< millis() timestamp of the oldest staged frame
+    uint32_t m_commitIntervalMs = MLR_TXQUEUE_COMMIT_INTERVAL_MS; //!< Time before staged frames are committed
+    uint8_t m_staged[MLR_TXQUEUE_STAGING_SIZE]; //!< Staged frames: len(1) data(len)
+
+    uint32_t m_retryAt = 0;               //!< millis() timestamp of the last failure
+    uint32_t m_retryDelay = 0;            //!< Current retry delay without jitter, 0 = no backoff
+    uint32_t m_retryJitter = 0;           //!< Random extra delay of the pending retry
+    uint32_t m_sentCount = 0;             //!< Frames sent
+    uint32_t m_retryCount = 0;            //!< Failed attempts
+
+    uint32_t m_budgetMsPerHour = 0;       //!< Airtime budget, 0 = unlimited
+    uint8_t m_budgetSf = 7;               //!< LoRa spreading factor for airtime estimates
+    uint32_t m_budgetBwHz = 0;            //!< LoRa bandwidth for airtime estimates
+    uint32_t m_budgetFskBitrate = 0;      //!< FSK bit rate for airtime estimates
+    int64_t m_budgetUs = 0;               //!< Airtime currently available in microseconds (negative after an oversized frame)
+    uint32_t m_budgetRefill = 0;          //!< millis() timestamp of the last budget refill
+    uint16_t m_budgetFrac = 0;            //!< Refill not yet credited, in 1/3600 us
+};